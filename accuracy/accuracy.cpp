@@ -12,6 +12,14 @@ using fpm::fixed_8_24;
 using fpm::fixed_16_16;
 using fpm::fixed_24_8;
 using fixed_20_12 = fpm::fixed<std::int32_t, std::int64_t, 12>;
+using fpm::fixed_8_8;
+#ifdef FPM_INT128
+using fpm::fixed_56_8;
+using fpm::fixed_48_16;
+using fpm::fixed_32_32;
+using fpm::fixed_16_48;
+using fpm::fixed_8_56;
+#endif
 
 using std::sin;
 using std::cos;
@@ -34,6 +42,68 @@ static Fix16 exp(Fix16 x) { return fix16_exp(x); }
 static Fix16 log(Fix16 x) { return fix16_log(x); }
 static Fix16 log2(Fix16 x) { return fix16_log2(x); }
 
+// Table-driven sin/cos for fixed-point types, the standard functions for the real result
+template <std::size_t Size, unsigned int Order, typename T>
+static T lut_sin(T x)
+{
+    if constexpr (fpm::is_fixed_v<T>) return fpm::lut::sin<Size, Order>(x); else return std::sin(x);
+}
+
+template <std::size_t Size, unsigned int Order, typename T>
+static T lut_cos(T x)
+{
+    if constexpr (fpm::is_fixed_v<T>) return fpm::lut::cos<Size, Order>(x); else return std::cos(x);
+}
+
+// The accuracy tiers for fixed-point types, the standard functions for the real result
+template <typename T>
+static T fast_exp2(T x)
+{
+    if constexpr (fpm::is_fixed_v<T>) return fpm::fast::exp2(x); else return std::exp2(x);
+}
+
+template <typename T>
+static T precise_exp2(T x)
+{
+    if constexpr (fpm::is_fixed_v<T>) return fpm::precise::exp2(x); else return std::exp2(x);
+}
+
+template <typename T>
+static T fast_log2(T x)
+{
+    if constexpr (fpm::is_fixed_v<T>) return fpm::fast::log2(x); else return std::log2(x);
+}
+
+template <typename T>
+static T precise_log2(T x)
+{
+    if constexpr (fpm::is_fixed_v<T>) return fpm::precise::log2(x); else return std::log2(x);
+}
+
+template <typename T>
+static T fast_sin(T x)
+{
+    if constexpr (fpm::is_fixed_v<T>) return fpm::fast::sin(x); else return std::sin(x);
+}
+
+template <typename T>
+static T precise_sin(T x)
+{
+    if constexpr (fpm::is_fixed_v<T>) return fpm::precise::sin(x); else return std::sin(x);
+}
+
+template <typename T>
+static T fast_atan(T x)
+{
+    if constexpr (fpm::is_fixed_v<T>) return fpm::fast::atan(x); else return std::atan(x);
+}
+
+template <typename T>
+static T precise_atan(T x)
+{
+    if constexpr (fpm::is_fixed_v<T>) return fpm::precise::atan(x); else return std::atan(x);
+}
+
 class csv_output
 {
 public:
@@ -59,6 +129,33 @@ private:
     std::ofstream m_stream;
 };
 
+// The layout for the types that the columns of csv_output leave out: the 16-bit and 64-bit aliases.
+// Without 128-bit integers the 64-bit aliases don't exist, and their columns are missing.
+class alias_output
+{
+public:
+    explicit alias_output(const std::string& filename)
+        : m_stream(filename)
+    {
+        m_stream.setf(std::ios::fixed);
+        m_stream.precision(18);
+        m_stream << "x,real,Q8.8,Q56.8,Q48.16,Q32.32,Q16.48,Q8.56\n";
+    }
+
+    void write_row(double x, double y_real, double y_q8_8, double y_q56_8, double y_q48_16, double y_q32_32, double y_q16_48, double y_q8_56)
+    {
+        m_stream << x << "," << y_real << "," << y_q8_8 << "," << y_q56_8 << "," << y_q48_16 << "," << y_q32_32 << "," << y_q16_48 << "," << y_q8_56 << "\n";
+    }
+
+    void write_row(double x, double y_real, double y_q8_8)
+    {
+        m_stream << x << "," << y_real << "," << y_q8_8 << ",-,-,-,-,-\n";
+    }
+
+private:
+    std::ofstream m_stream;
+};
+
 template <typename Callable, typename... Args>
 static void check_all(csv_output& output, double value, Callable&& callable, Args&& ...args)
 {
@@ -82,6 +179,22 @@ static void check_fpm(csv_output& output, double value, Callable&& callable, Arg
         static_cast<double>(callable(fixed_8_24(std::forward<Args>(args))...)));
 }
 
+template <typename Callable, typename... Args>
+static void check_aliases(alias_output& output, double value, Callable&& callable, Args&& ...args)
+{
+    output.write_row(value,
+        callable(std::forward<Args>(args)...),
+        static_cast<double>(callable(fixed_8_8(std::forward<Args>(args))...))
+#ifdef FPM_INT128
+        , static_cast<double>(callable(fixed_56_8(std::forward<Args>(args))...)),
+        static_cast<double>(callable(fixed_48_16(std::forward<Args>(args))...)),
+        static_cast<double>(callable(fixed_32_32(std::forward<Args>(args))...)),
+        static_cast<double>(callable(fixed_16_48(std::forward<Args>(args))...)),
+        static_cast<double>(callable(fixed_8_56(std::forward<Args>(args))...))
+#endif
+        );
+}
+
 int main()
 {
     csv_output out_sin("sin.csv");
@@ -104,6 +217,30 @@ int main()
         check_all(out_atan2, val, [](auto y, auto x) { return atan2(y, x); }, y, x);
     }
 
+    // Table-driven sin/cos, with the default table and a small table with cubic interpolation
+    csv_output out_lut_sin("lut_sin.csv");
+    csv_output out_lut_cos("lut_cos.csv");
+    csv_output out_lut_sin_cubic("lut_sin_cubic.csv");
+    csv_output out_lut_cos_cubic("lut_cos_cubic.csv");
+    for (int angle = -179; angle <= 180; ++angle)
+    {
+        const double val = angle * PI / 180.0;
+        check_fpm(out_lut_sin, val, [](auto x) { return lut_sin<256, 1>(x); }, val);
+        check_fpm(out_lut_cos, val, [](auto x) { return lut_cos<256, 1>(x); }, val);
+        check_fpm(out_lut_sin_cubic, val, [](auto x) { return lut_sin<64, 3>(x); }, val);
+        check_fpm(out_lut_cos_cubic, val, [](auto x) { return lut_cos<64, 3>(x); }, val);
+    }
+
+    // Accuracy tiers
+    csv_output out_fast_sin("fast_sin.csv");
+    csv_output out_precise_sin("precise_sin.csv");
+    for (int angle = -179; angle <= 180; ++angle)
+    {
+        const double val = angle * PI / 180.0;
+        check_fpm(out_fast_sin, val, [](auto x) { return fast_sin(x); }, val);
+        check_fpm(out_precise_sin, val, [](auto x) { return precise_sin(x); }, val);
+    }
+
     csv_output out_asin("asin.csv");
     csv_output out_acos("acos.csv");
     for (int value = -100; value <= 100; ++value)
@@ -114,10 +251,14 @@ int main()
     }
 
     csv_output out_atan("atan.csv");
+    csv_output out_fast_atan("fast_atan.csv");
+    csv_output out_precise_atan("precise_atan.csv");
     for (int value = -5000; value <= 5000; value += 5)
     {
         const double val = value / 1000.0;
         check_all(out_atan, val, [](auto x) { return atan(x); }, val);
+        check_fpm(out_fast_atan, val, [](auto x) { return fast_atan(x); }, val);
+        check_fpm(out_precise_atan, val, [](auto x) { return precise_atan(x); }, val);
     }
 
     csv_output out_sqrt("sqrt.csv");
@@ -128,31 +269,51 @@ int main()
     }
 
     csv_output out_cbrt("cbrt.csv");
+    alias_output out_cbrt_aliases("cbrt_aliases.csv");
     for (int i = -1000; i < 1000; ++i)
     {
         const auto val = i / 10.0;
         check_fpm(out_cbrt, val, [](auto x) { return cbrt(x); }, val);
+        check_aliases(out_cbrt_aliases, val, [](auto x) { return cbrt(x); }, val);
+    }
+
+    // Near zero, where the few bits of the results make the relative error large
+    csv_output out_cbrt_small("cbrt_small.csv");
+    alias_output out_cbrt_small_aliases("cbrt_small_aliases.csv");
+    for (int i = -1000; i <= 1000; ++i)
+    {
+        const auto val = i / 1000.0;
+        check_fpm(out_cbrt_small, val, [](auto x) { return cbrt(x); }, val);
+        check_aliases(out_cbrt_small_aliases, val, [](auto x) { return cbrt(x); }, val);
     }
 
     csv_output out_exp("exp.csv");
     csv_output out_exp2("exp2.csv");
+    csv_output out_fast_exp2("fast_exp2.csv");
+    csv_output out_precise_exp2("precise_exp2.csv");
     csv_output out_pow("pow.csv");
     for (int i = -40; i <= 40; i++)
     {
         const auto val = i / 10.0;
         check_all(out_exp, val, [](auto x) { return exp(x); }, val);
         check_fpm(out_exp2, val, [](auto x) { return exp2(x); }, val);
+        check_fpm(out_fast_exp2, val, [](auto x) { return fast_exp2(x); }, val);
+        check_fpm(out_precise_exp2, val, [](auto x) { return precise_exp2(x); }, val);
         check_fpm(out_pow, val, [](auto x) { return pow(decltype(x){3.36}, x); }, val);
     }
 
     csv_output out_log("log.csv");
     csv_output out_log2("log2.csv");
+    csv_output out_fast_log2("fast_log2.csv");
+    csv_output out_precise_log2("precise_log2.csv");
     csv_output out_log10("log10.csv");
     for (int i = 1; i < 1000; i++)
     {
         const auto val = i / 10.0;
         check_all(out_log, val, [](auto x) { return log(x); }, val);
         check_all(out_log2, val, [](auto x) { return log2(x); }, val);
+        check_fpm(out_fast_log2, val, [](auto x) { return fast_log2(x); }, val);
+        check_fpm(out_precise_log2, val, [](auto x) { return precise_log2(x); }, val);
         check_fpm(out_log10, val, [](auto x) { return log10(x); }, val);
     }
 }
@@ -22,6 +22,11 @@ err(x,real) = (real != 0) ? abs((x - real)/real) * 100 : (x != 0) ? "-" : 0;
 set output "accuracy-".SERIES.".png"
 set title 'Δ '.SERIES
 
-plot DATA_FILE using 1:(err($6,$2)) with linespoints, \
-     DATA_FILE using 1:(err($5,$2)) with linespoints, \
-     DATA_FILE using 1:(err($7,$2)) with linespoints
+if (ARG2 eq "aliases") {
+    # The layout of the 16-bit and 64-bit aliases
+    plot for [i=3:8] DATA_FILE using 1:(err(column(i),$2)) with linespoints
+} else {
+    plot DATA_FILE using 1:(err($6,$2)) with linespoints, \
+         DATA_FILE using 1:(err($5,$2)) with linespoints, \
+         DATA_FILE using 1:(err($7,$2)) with linespoints
+}
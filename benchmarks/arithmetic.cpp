@@ -1,5 +1,8 @@
 #include <benchmark/benchmark.h>
+#include <fpm/checked.hpp>
 #include <fpm/fixed.hpp>
+#include <fpm/math.hpp>
+#include <fpm/saturating.hpp>
 #include <cnl/fixed_point.h>
 
 #include <fixmath.h>
@@ -27,10 +30,61 @@ static void arithmetic(benchmark::State& state, TValue (*func)(TValue, TValue))
     }
 }
 
+// Converts a double or a raw value with 8 more fraction bits
+template <typename TValue>
+static void conversion(benchmark::State& state, TValue (*func)(double, std::int32_t))
+{
+    for (auto _ : state)
+    {
+        const std::int16_t x = s_x, y = s_y;
+        benchmark::DoNotOptimize(func(x + y / 4096.0, x * 256 + y));
+    }
+}
+
+// Multiplies a gain in fpm::fixed_8_24 by a value of another type
+template <typename TValue>
+static void mixed(benchmark::State& state, TValue (*func)(fpm::fixed_8_24, TValue))
+{
+    for (auto _ : state)
+    {
+        const std::int16_t x = s_x, y = s_y;
+        benchmark::DoNotOptimize(func(fpm::fixed_8_24::from_raw_value(x * 4096), TValue::from_raw_value(y * 256)));
+    }
+}
+
 #define FUNC(TYPE, OP) \
     [](TYPE x, TYPE y) -> TYPE { return x OP y; }
 
+#define SAT_FUNC(TYPE, NAME) \
+    [](TYPE x, TYPE y) -> TYPE { return fpm::NAME(x, y); }
+
+// Division by a number that's the same for every call, which the compiler only turns into
+// a multiplication for base types that fit in a register.
+#define DIV_CONSTANT(TYPE) \
+    [](TYPE x, TYPE) -> TYPE { return x / TYPE::pi(); }
+
+#define DIVISOR_CONSTANT(TYPE) \
+    [](TYPE x, TYPE) -> TYPE { constexpr fpm::divisor<TYPE> pi(TYPE::pi()); return x / pi; }
+
+#define FROM_DOUBLE(TYPE) \
+    [](double d, std::int32_t) -> TYPE { return TYPE(d); }
+
+#define FROM_FIXED(TYPE) \
+    [](double, std::int32_t raw) -> TYPE { return TYPE::template from_fixed_point<TYPE::fraction_bits + 8>(raw); }
+
+// Multiplication, division and conversions with a rounding mode, for each base type
+#define ROUNDING_FUNCS(TYPE, MODE) \
+    BENCHMARK_TEMPLATE1_CAPTURE(arithmetic, mul, TYPE<fpm::rounding::MODE>, FUNC(TYPE<fpm::rounding::MODE>, *)); \
+    BENCHMARK_TEMPLATE1_CAPTURE(arithmetic, div, TYPE<fpm::rounding::MODE>, FUNC(TYPE<fpm::rounding::MODE>, /)); \
+    BENCHMARK_TEMPLATE1_CAPTURE(conversion, from_double, TYPE<fpm::rounding::MODE>, FROM_DOUBLE(TYPE<fpm::rounding::MODE>)); \
+    BENCHMARK_TEMPLATE1_CAPTURE(conversion, from_fixed_point, TYPE<fpm::rounding::MODE>, FROM_FIXED(TYPE<fpm::rounding::MODE>))
+
 using CnlFixed16 = cnl::fixed_point<std::int32_t, -16>;
+using CheckedFixed16 = fpm::checked<fpm::fixed_16_16>;
+
+template <fpm::rounding R> using Fixed14_2 = fpm::fixed<std::int16_t, std::int32_t, 2, R>;
+template <fpm::rounding R> using Fixed16_16 = fpm::fixed<std::int32_t, std::int64_t, 16, R>;
+template <fpm::rounding R> using Fixed32_32 = fpm::fixed<std::int64_t, fpm::int128_t, 32, R>;
 
 BENCHMARK_TEMPLATE1_CAPTURE(arithmetic, add, float, FUNC(float, +));
 BENCHMARK_TEMPLATE1_CAPTURE(arithmetic, sub, float, FUNC(float, -));
@@ -52,6 +106,63 @@ BENCHMARK_TEMPLATE1_CAPTURE(arithmetic, sub, fpm::fixed_16_16, FUNC(fpm::fixed_1
 BENCHMARK_TEMPLATE1_CAPTURE(arithmetic, mul, fpm::fixed_16_16, FUNC(fpm::fixed_16_16, *));
 BENCHMARK_TEMPLATE1_CAPTURE(arithmetic, div, fpm::fixed_16_16, FUNC(fpm::fixed_16_16, /));
 
+BENCHMARK_TEMPLATE1_CAPTURE(arithmetic, add_sat, fpm::fixed_24_8, SAT_FUNC(fpm::fixed_24_8, add_sat));
+BENCHMARK_TEMPLATE1_CAPTURE(arithmetic, sub_sat, fpm::fixed_24_8, SAT_FUNC(fpm::fixed_24_8, sub_sat));
+BENCHMARK_TEMPLATE1_CAPTURE(arithmetic, mul_sat, fpm::fixed_24_8, SAT_FUNC(fpm::fixed_24_8, mul_sat));
+BENCHMARK_TEMPLATE1_CAPTURE(arithmetic, div_sat, fpm::fixed_24_8, SAT_FUNC(fpm::fixed_24_8, div_sat));
+
+BENCHMARK_TEMPLATE1_CAPTURE(arithmetic, add_sat, fpm::fixed_16_16, SAT_FUNC(fpm::fixed_16_16, add_sat));
+BENCHMARK_TEMPLATE1_CAPTURE(arithmetic, sub_sat, fpm::fixed_16_16, SAT_FUNC(fpm::fixed_16_16, sub_sat));
+BENCHMARK_TEMPLATE1_CAPTURE(arithmetic, mul_sat, fpm::fixed_16_16, SAT_FUNC(fpm::fixed_16_16, mul_sat));
+BENCHMARK_TEMPLATE1_CAPTURE(arithmetic, div_sat, fpm::fixed_16_16, SAT_FUNC(fpm::fixed_16_16, div_sat));
+
+BENCHMARK_TEMPLATE1_CAPTURE(arithmetic, inv, fpm::fixed_16_16, [](fpm::fixed_16_16 x, fpm::fixed_16_16) { return 1 / x; });
+BENCHMARK_TEMPLATE1_CAPTURE(arithmetic, reciprocal, fpm::fixed_16_16, [](fpm::fixed_16_16 x, fpm::fixed_16_16) { return fpm::reciprocal(x); });
+BENCHMARK_TEMPLATE1_CAPTURE(arithmetic, div_constant, fpm::fixed_16_16, DIV_CONSTANT(fpm::fixed_16_16));
+BENCHMARK_TEMPLATE1_CAPTURE(arithmetic, divisor_constant, fpm::fixed_16_16, DIVISOR_CONSTANT(fpm::fixed_16_16));
+
+BENCHMARK_TEMPLATE1_CAPTURE(arithmetic, mul, fpm::fixed_32_32, FUNC(fpm::fixed_32_32, *));
+BENCHMARK_TEMPLATE1_CAPTURE(arithmetic, div, fpm::fixed_32_32, FUNC(fpm::fixed_32_32, /));
+BENCHMARK_TEMPLATE1_CAPTURE(arithmetic, inv, fpm::fixed_32_32, [](fpm::fixed_32_32 x, fpm::fixed_32_32) { return 1 / x; });
+BENCHMARK_TEMPLATE1_CAPTURE(arithmetic, reciprocal, fpm::fixed_32_32, [](fpm::fixed_32_32 x, fpm::fixed_32_32) { return fpm::reciprocal(x); });
+BENCHMARK_TEMPLATE1_CAPTURE(arithmetic, div_constant, fpm::fixed_32_32, DIV_CONSTANT(fpm::fixed_32_32));
+BENCHMARK_TEMPLATE1_CAPTURE(arithmetic, divisor_constant, fpm::fixed_32_32, DIVISOR_CONSTANT(fpm::fixed_32_32));
+
+// The exact product rounded once, against a product rounded in fpm::fixed_8_24 and converted
+BENCHMARK_TEMPLATE1_CAPTURE(mixed, mul_wide, fpm::fixed_16_16,
+    [](fpm::fixed_8_24 x, fpm::fixed_16_16 y) { return fpm::mul_wide(x, y).narrow<fpm::fixed_16_16>(); });
+BENCHMARK_TEMPLATE1_CAPTURE(mixed, mul_cast, fpm::fixed_16_16,
+    [](fpm::fixed_8_24 x, fpm::fixed_16_16 y) { return fpm::fixed_16_16(x * fpm::fixed_8_24(y)); });
+
+ROUNDING_FUNCS(Fixed14_2, toward_zero);
+ROUNDING_FUNCS(Fixed14_2, half_away_from_zero);
+ROUNDING_FUNCS(Fixed14_2, half_up);
+ROUNDING_FUNCS(Fixed14_2, half_even);
+ROUNDING_FUNCS(Fixed14_2, floor);
+ROUNDING_FUNCS(Fixed14_2, ceil);
+ROUNDING_FUNCS(Fixed14_2, stochastic);
+
+ROUNDING_FUNCS(Fixed16_16, toward_zero);
+ROUNDING_FUNCS(Fixed16_16, half_away_from_zero);
+ROUNDING_FUNCS(Fixed16_16, half_up);
+ROUNDING_FUNCS(Fixed16_16, half_even);
+ROUNDING_FUNCS(Fixed16_16, floor);
+ROUNDING_FUNCS(Fixed16_16, ceil);
+ROUNDING_FUNCS(Fixed16_16, stochastic);
+
+ROUNDING_FUNCS(Fixed32_32, toward_zero);
+ROUNDING_FUNCS(Fixed32_32, half_away_from_zero);
+ROUNDING_FUNCS(Fixed32_32, half_up);
+ROUNDING_FUNCS(Fixed32_32, half_even);
+ROUNDING_FUNCS(Fixed32_32, floor);
+ROUNDING_FUNCS(Fixed32_32, ceil);
+ROUNDING_FUNCS(Fixed32_32, stochastic);
+
+BENCHMARK_TEMPLATE1_CAPTURE(arithmetic, add, CheckedFixed16, FUNC(CheckedFixed16, +));
+BENCHMARK_TEMPLATE1_CAPTURE(arithmetic, sub, CheckedFixed16, FUNC(CheckedFixed16, -));
+BENCHMARK_TEMPLATE1_CAPTURE(arithmetic, mul, CheckedFixed16, FUNC(CheckedFixed16, *));
+BENCHMARK_TEMPLATE1_CAPTURE(arithmetic, div, CheckedFixed16, FUNC(CheckedFixed16, /));
+
 BENCHMARK_TEMPLATE1_CAPTURE(arithmetic, add, Fix16, FUNC(Fix16, +));
 BENCHMARK_TEMPLATE1_CAPTURE(arithmetic, sub, Fix16, FUNC(Fix16, -));
 BENCHMARK_TEMPLATE1_CAPTURE(arithmetic, mul, Fix16, FUNC(Fix16, *));
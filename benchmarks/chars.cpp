@@ -0,0 +1,94 @@
+#include <benchmark/benchmark.h>
+#include <fpm/fixed.hpp>
+#include <fpm/ios.hpp>
+#include <array>
+#include <charconv>
+#include <iomanip>
+#include <sstream>
+
+#define BENCHMARK_TEMPLATE1_CAPTURE(func, test_case_name, a, ...)   \
+  BENCHMARK_PRIVATE_DECLARE(func) =                                 \
+      (::benchmark::internal::RegisterBenchmarkInternal(            \
+          new ::benchmark::internal::FunctionBenchmark(             \
+              #func "<" #a ">/" #test_case_name,					\
+              [](::benchmark::State& st) { func<a>(st, __VA_ARGS__); })))
+
+// Constant for our to_chars argument.
+// Stored as volatile to force the compiler to read them and
+// not optimize the entire expression into a constant.
+static volatile int16_t s_x = 31415;
+
+template <typename TValue>
+static void to_chars(benchmark::State& state, std::chars_format fmt, int precision)
+{
+    std::array<char, 128> buffer;
+    for (auto _ : state)
+    {
+        TValue x{ static_cast<TValue>(s_x / 256.0) };
+        benchmark::DoNotOptimize(std::to_chars(buffer.data(), buffer.data() + buffer.size(), x, fmt, precision));
+        benchmark::ClobberMemory();
+    }
+}
+
+// The previous implementation of `std::to_chars` for fixed-point types:
+// stream the value into a string stream and copy it out.
+template <typename TValue>
+static void stringstream(benchmark::State& state, std::chars_format fmt, int precision)
+{
+    std::array<char, 128> buffer;
+    for (auto _ : state)
+    {
+        TValue x{ static_cast<TValue>(s_x / 256.0) };
+        std::stringstream ss;
+        ss << std::setprecision(precision);
+        switch (fmt)
+        {
+        case std::chars_format::scientific: ss << std::scientific; break;
+        case std::chars_format::fixed: ss << std::fixed; break;
+        case std::chars_format::hex: ss << std::hexfloat; break;
+        default: break;
+        }
+        ss << x;
+        benchmark::DoNotOptimize(ss.read(buffer.data(), ss.tellp()));
+        benchmark::ClobberMemory();
+    }
+}
+
+BENCHMARK_TEMPLATE1_CAPTURE(to_chars, general, double, std::chars_format::general, 6);
+BENCHMARK_TEMPLATE1_CAPTURE(to_chars, fixed, double, std::chars_format::fixed, 6);
+BENCHMARK_TEMPLATE1_CAPTURE(to_chars, scientific, double, std::chars_format::scientific, 6);
+BENCHMARK_TEMPLATE1_CAPTURE(to_chars, hex, double, std::chars_format::hex, 6);
+
+BENCHMARK_TEMPLATE1_CAPTURE(to_chars, general, fpm::fixed_16_16, std::chars_format::general, 6);
+BENCHMARK_TEMPLATE1_CAPTURE(to_chars, fixed, fpm::fixed_16_16, std::chars_format::fixed, 6);
+BENCHMARK_TEMPLATE1_CAPTURE(to_chars, scientific, fpm::fixed_16_16, std::chars_format::scientific, 6);
+BENCHMARK_TEMPLATE1_CAPTURE(to_chars, hex, fpm::fixed_16_16, std::chars_format::hex, 6);
+
+BENCHMARK_TEMPLATE1_CAPTURE(stringstream, general, fpm::fixed_16_16, std::chars_format::general, 6);
+BENCHMARK_TEMPLATE1_CAPTURE(stringstream, fixed, fpm::fixed_16_16, std::chars_format::fixed, 6);
+BENCHMARK_TEMPLATE1_CAPTURE(stringstream, scientific, fpm::fixed_16_16, std::chars_format::scientific, 6);
+BENCHMARK_TEMPLATE1_CAPTURE(stringstream, hex, fpm::fixed_16_16, std::chars_format::hex, 6);
+
+// Text for our from_chars argument.
+// Stored as volatile to force the compiler to read it and
+// not optimize the entire expression into a constant.
+static volatile char s_text[] = "-122.71484375e-1";
+
+template <typename TValue>
+static void from_chars(benchmark::State& state, std::chars_format fmt, int length)
+{
+    std::array<char, sizeof(s_text)> buffer;
+    for (auto _ : state)
+    {
+        std::copy(std::begin(s_text), std::end(s_text), buffer.begin());
+        TValue x{};
+        benchmark::DoNotOptimize(std::from_chars(buffer.data(), buffer.data() + length, x, fmt));
+        benchmark::DoNotOptimize(x);
+    }
+}
+
+BENCHMARK_TEMPLATE1_CAPTURE(from_chars, fixed, double, std::chars_format::fixed, 13);
+BENCHMARK_TEMPLATE1_CAPTURE(from_chars, scientific, double, std::chars_format::scientific, 16);
+
+BENCHMARK_TEMPLATE1_CAPTURE(from_chars, fixed, fpm::fixed_16_16, std::chars_format::fixed, 13);
+BENCHMARK_TEMPLATE1_CAPTURE(from_chars, scientific, fpm::fixed_16_16, std::chars_format::scientific, 16);
@@ -0,0 +1,52 @@
+#include <benchmark/benchmark.h>
+#include <fpm/fixed.hpp>
+#include <fpm/ios.hpp>
+
+#if __cplusplus >= 202002L /* C++20 */
+#   include <version>
+#   ifdef __cpp_lib_format
+#       include <format>
+#       include <iterator>
+#       include <string>
+
+#define BENCHMARK_TEMPLATE1_CAPTURE(func, test_case_name, a, ...)   \
+  BENCHMARK_PRIVATE_DECLARE(func) =                                 \
+      (::benchmark::internal::RegisterBenchmarkInternal(            \
+          new ::benchmark::internal::FunctionBenchmark(             \
+              #func "<" #a ">/" #test_case_name,					\
+              [](::benchmark::State& st) { func<a>(st, __VA_ARGS__); })))
+
+// Constant for our format argument.
+// Stored as volatile to force the compiler to read them and
+// not optimize the entire expression into a constant.
+static volatile int16_t s_x = -31415;
+
+template <typename TValue>
+static void format(benchmark::State& state, std::string_view fmt)
+{
+    std::string buffer;
+    buffer.reserve(128);
+    for (auto _ : state)
+    {
+        TValue x{ static_cast<TValue>(s_x / 256.0) };
+        buffer.clear();
+        std::vformat_to(std::back_inserter(buffer), fmt, std::make_format_args(x));
+        benchmark::DoNotOptimize(buffer.data());
+        benchmark::ClobberMemory();
+    }
+}
+
+BENCHMARK_TEMPLATE1_CAPTURE(format, default, double, "{}");
+BENCHMARK_TEMPLATE1_CAPTURE(format, fixed, double, "{:.3f}");
+BENCHMARK_TEMPLATE1_CAPTURE(format, scientific, double, "{:+.4e}");
+BENCHMARK_TEMPLATE1_CAPTURE(format, aligned, double, "{:*^20.3f}");
+BENCHMARK_TEMPLATE1_CAPTURE(format, zero_padded, double, "{:020.3f}");
+
+BENCHMARK_TEMPLATE1_CAPTURE(format, default, fpm::fixed_16_16, "{}");
+BENCHMARK_TEMPLATE1_CAPTURE(format, fixed, fpm::fixed_16_16, "{:.3f}");
+BENCHMARK_TEMPLATE1_CAPTURE(format, scientific, fpm::fixed_16_16, "{:+.4e}");
+BENCHMARK_TEMPLATE1_CAPTURE(format, aligned, fpm::fixed_16_16, "{:*^20.3f}");
+BENCHMARK_TEMPLATE1_CAPTURE(format, zero_padded, fpm::fixed_16_16, "{:020.3f}");
+
+#   endif
+#endif
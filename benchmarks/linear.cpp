@@ -0,0 +1,145 @@
+#include <benchmark/benchmark.h>
+#include <fpm/fixed.hpp>
+#include <fpm/linear.hpp>
+#include <fpm/quat.hpp>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#define BENCHMARK_TEMPLATE1_CAPTURE(func, test_case_name, a, ...)   \
+  BENCHMARK_PRIVATE_DECLARE(func) =                                 \
+      (::benchmark::internal::RegisterBenchmarkInternal(            \
+          new ::benchmark::internal::FunctionBenchmark(             \
+              #func "<" #a ">/" #test_case_name,					\
+              [](::benchmark::State& st) { func<a>(st, __VA_ARGS__); })))
+
+// Number of vectors per operation
+static constexpr std::size_t LENGTH = 4096;
+
+// The components of LENGTH vectors with three elements
+template <typename TValue>
+static std::array<std::vector<TValue>, 3> make_vectors()
+{
+    std::array<std::vector<TValue>, 3> values;
+    for (std::size_t k = 0; k < 3; ++k)
+    {
+        values[k].resize(LENGTH);
+        for (std::size_t i = 0; i < LENGTH; ++i)
+        {
+            values[k][i] = static_cast<TValue>(static_cast<int>((i * 7919 + k * 104729 + 1) % 2001) - 1000) / 64;
+        }
+    }
+    return values;
+}
+
+enum class Op { dot, cross, length, normalize, transform, rotate };
+
+// A loop over single vectors. Floats evaluate the same formulas directly.
+template <typename TValue>
+static void single(benchmark::State& state, Op op)
+{
+    const auto x = make_vectors<TValue>();
+    auto out = x;
+    const TValue m[3][3] = { { TValue{0.5}, TValue{-1}, TValue{2} }, { TValue{0}, TValue{1}, TValue{0.25} }, { TValue{-3}, TValue{0}, TValue{1} } };
+    const TValue q[4] = { TValue{0.5}, TValue{0.5}, TValue{-0.5}, TValue{0.5} };
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < LENGTH; ++i)
+        {
+            const TValue a = x[0][i], b = x[1][i], c = x[2][i];
+            if constexpr (std::is_floating_point_v<TValue>)
+            {
+                switch (op)
+                {
+                case Op::dot: out[0][i] = a * c + b * a + c * b; break;
+                case Op::cross: out[0][i] = b * a - c * c; out[1][i] = c * c - a * a; out[2][i] = a * c - b * b; break;
+                case Op::length: out[0][i] = std::sqrt(a * a + b * b + c * c); break;
+                case Op::normalize:
+                {
+                    const TValue r = 1 / std::sqrt(a * a + b * b + c * c);
+                    out[0][i] = a * r; out[1][i] = b * r; out[2][i] = c * r;
+                    break;
+                }
+                case Op::transform:
+                    for (std::size_t k = 0; k < 3; ++k) out[k][i] = m[k][0] * a + m[k][1] * b + m[k][2] * c;
+                    break;
+                case Op::rotate:
+                {
+                    // v + w*t + cross(u, t) with t = cross(2u, v)
+                    const TValue tx = 2 * (q[2] * c - q[3] * b), ty = 2 * (q[3] * a - q[1] * c), tz = 2 * (q[1] * b - q[2] * a);
+                    out[0][i] = a + q[0] * tx + q[2] * tz - q[3] * ty;
+                    out[1][i] = b + q[0] * ty + q[3] * tx - q[1] * tz;
+                    out[2][i] = c + q[0] * tz + q[1] * ty - q[2] * tx;
+                    break;
+                }
+                }
+            }
+            else
+            {
+                const fpm::vec3<TValue> v{ a, b, c };
+                fpm::vec3<TValue> r{};
+                switch (op)
+                {
+                case Op::dot: r[0] = fpm::dot(v, fpm::vec3<TValue>{ c, a, b }); break;
+                case Op::cross: r = fpm::cross(v, fpm::vec3<TValue>{ c, a, b }); break;
+                case Op::length: r[0] = fpm::length(v); break;
+                case Op::normalize: r = fpm::normalize(v); break;
+                case Op::transform: r = fpm::mat3<TValue>{ m[0][0], m[0][1], m[0][2], m[1][0], m[1][1], m[1][2], m[2][0], m[2][1], m[2][2] } * v; break;
+                case Op::rotate: r = fpm::rotate(fpm::quat<TValue>{ q[0], q[1], q[2], q[3] }, v); break;
+                }
+                for (std::size_t k = 0; k < 3; ++k) out[k][i] = r[k];
+            }
+        }
+        benchmark::DoNotOptimize(out[0].data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * LENGTH);
+}
+
+// The structure-of-arrays functions in fpm::batch
+template <typename TValue>
+static void batch(benchmark::State& state, Op op)
+{
+    const auto x = make_vectors<TValue>();
+    auto out = x;
+    const fpm::mat3<TValue> m{ TValue{0.5}, TValue{-1}, TValue{2}, TValue{0}, TValue{1}, TValue{0.25}, TValue{-3}, TValue{0}, TValue{1} };
+    const fpm::quat<TValue> q{ TValue{0.5}, TValue{0.5}, TValue{-0.5}, TValue{0.5} };
+    for (auto _ : state)
+    {
+        switch (op)
+        {
+        case Op::dot: fpm::batch::dot<3, TValue>({ x[0], x[1], x[2] }, { x[2], x[0], x[1] }, out[0]); break;
+        case Op::cross: fpm::batch::cross<3, TValue>({ x[0], x[1], x[2] }, { x[2], x[0], x[1] }, { out[0], out[1], out[2] }); break;
+        case Op::length: fpm::batch::length<3, TValue>({ x[0], x[1], x[2] }, out[0]); break;
+        case Op::normalize: fpm::batch::normalize<3, TValue>({ x[0], x[1], x[2] }, { out[0], out[1], out[2] }); break;
+        case Op::transform: fpm::batch::transform(m, { x[0], x[1], x[2] }, { out[0], out[1], out[2] }); break;
+        case Op::rotate: fpm::batch::rotate(q, { x[0], x[1], x[2] }, { out[0], out[1], out[2] }); break;
+        }
+        benchmark::DoNotOptimize(out[0].data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * LENGTH);
+}
+
+BENCHMARK_TEMPLATE1_CAPTURE(single, dot, float, Op::dot);
+BENCHMARK_TEMPLATE1_CAPTURE(single, cross, float, Op::cross);
+BENCHMARK_TEMPLATE1_CAPTURE(single, length, float, Op::length);
+BENCHMARK_TEMPLATE1_CAPTURE(single, normalize, float, Op::normalize);
+BENCHMARK_TEMPLATE1_CAPTURE(single, transform, float, Op::transform);
+BENCHMARK_TEMPLATE1_CAPTURE(single, rotate, float, Op::rotate);
+
+BENCHMARK_TEMPLATE1_CAPTURE(single, dot, fpm::fixed_16_16, Op::dot);
+BENCHMARK_TEMPLATE1_CAPTURE(single, cross, fpm::fixed_16_16, Op::cross);
+BENCHMARK_TEMPLATE1_CAPTURE(single, length, fpm::fixed_16_16, Op::length);
+BENCHMARK_TEMPLATE1_CAPTURE(single, normalize, fpm::fixed_16_16, Op::normalize);
+BENCHMARK_TEMPLATE1_CAPTURE(single, transform, fpm::fixed_16_16, Op::transform);
+BENCHMARK_TEMPLATE1_CAPTURE(single, rotate, fpm::fixed_16_16, Op::rotate);
+
+BENCHMARK_TEMPLATE1_CAPTURE(batch, dot, fpm::fixed_16_16, Op::dot);
+BENCHMARK_TEMPLATE1_CAPTURE(batch, cross, fpm::fixed_16_16, Op::cross);
+BENCHMARK_TEMPLATE1_CAPTURE(batch, length, fpm::fixed_16_16, Op::length);
+BENCHMARK_TEMPLATE1_CAPTURE(batch, normalize, fpm::fixed_16_16, Op::normalize);
+BENCHMARK_TEMPLATE1_CAPTURE(batch, transform, fpm::fixed_16_16, Op::transform);
+BENCHMARK_TEMPLATE1_CAPTURE(batch, rotate, fpm::fixed_16_16, Op::rotate);
@@ -17,6 +17,12 @@ static Fix16 fix16_func(Fix16 f)
     return (*func)(f);
 }
 
+template <typename T>
+static T std_rsqrt(T x)
+{
+    return T{1} / std::sqrt(x);
+}
+
 // Constants for our power function arguments.
 // Stored as volatile to force the compiler to read them and
 // not optimize the entire expression into a constant.
@@ -43,6 +49,27 @@ static void power1(benchmark::State& state, TValue (*func)(const TValue&))
     }
 }
 
+// Negative arguments, as in exponential decay
+template <typename TValue>
+static void power1_negative(benchmark::State& state, TValue (*func)(TValue))
+{
+    for (auto _ : state)
+    {
+        TValue x{ static_cast<TValue>(s_x / -256.0) };
+        benchmark::DoNotOptimize(func(x));
+    }
+}
+
+template <typename TValue>
+static void power1_negative(benchmark::State& state, TValue (*func)(const TValue&))
+{
+    for (auto _ : state)
+    {
+        TValue x{ static_cast<TValue>(s_x / -256.0) };
+        benchmark::DoNotOptimize(func(x));
+    }
+}
+
 template <typename TValue>
 static void power2(benchmark::State& state, TValue (*func)(TValue, TValue))
 {
@@ -60,13 +87,31 @@ BENCHMARK_TEMPLATE1_CAPTURE(power1, sqrt, float, &std::sqrt);
 BENCHMARK_TEMPLATE1_CAPTURE(power1, sqrt, double, &std::sqrt);
 BENCHMARK_TEMPLATE1_CAPTURE(power1, sqrt, fpm::fixed_24_8, &fpm::sqrt);
 BENCHMARK_TEMPLATE1_CAPTURE(power1, sqrt, fpm::fixed_16_16, &fpm::sqrt);
+BENCHMARK_TEMPLATE1_CAPTURE(power1, sqrt, fpm::fixed_32_32, &fpm::sqrt);
 BENCHMARK_TEMPLATE1_CAPTURE(power1, sqrt, Fix16, fix16_func<&fix16_sqrt>);
 BENCHMARK_TEMPLATE1_CAPTURE(power1, sqrt, CnlFixed16, &cnl::sqrt);
 
+BENCHMARK_TEMPLATE1_CAPTURE(power1, sqrt_exact, fpm::fixed_24_8, &fpm::sqrt_exact);
+BENCHMARK_TEMPLATE1_CAPTURE(power1, sqrt_exact, fpm::fixed_16_16, &fpm::sqrt_exact);
+BENCHMARK_TEMPLATE1_CAPTURE(power1, sqrt_exact, fpm::fixed_32_32, &fpm::sqrt_exact);
+
+BENCHMARK_TEMPLATE1_CAPTURE(power1, rsqrt, float, &std_rsqrt<float>);
+BENCHMARK_TEMPLATE1_CAPTURE(power1, rsqrt, double, &std_rsqrt<double>);
+BENCHMARK_TEMPLATE1_CAPTURE(power1, rsqrt, fpm::fixed_24_8, &fpm::rsqrt);
+BENCHMARK_TEMPLATE1_CAPTURE(power1, rsqrt, fpm::fixed_16_16, &fpm::rsqrt);
+BENCHMARK_TEMPLATE1_CAPTURE(power1, rsqrt, fpm::fixed_32_32, &fpm::rsqrt);
+
 BENCHMARK_TEMPLATE1_CAPTURE(power1, cbrt, float, &std::cbrt);
 BENCHMARK_TEMPLATE1_CAPTURE(power1, cbrt, double, &std::cbrt);
 BENCHMARK_TEMPLATE1_CAPTURE(power1, cbrt, fpm::fixed_24_8, &fpm::cbrt);
+BENCHMARK_TEMPLATE1_CAPTURE(power1, cbrt, fpm::fixed_8_8, &fpm::cbrt);
 BENCHMARK_TEMPLATE1_CAPTURE(power1, cbrt, fpm::fixed_16_16, &fpm::cbrt);
+BENCHMARK_TEMPLATE1_CAPTURE(power1, cbrt, fpm::fixed_8_24, &fpm::cbrt);
+BENCHMARK_TEMPLATE1_CAPTURE(power1, cbrt, fpm::fixed_56_8, &fpm::cbrt);
+BENCHMARK_TEMPLATE1_CAPTURE(power1, cbrt, fpm::fixed_48_16, &fpm::cbrt);
+BENCHMARK_TEMPLATE1_CAPTURE(power1, cbrt, fpm::fixed_32_32, &fpm::cbrt);
+BENCHMARK_TEMPLATE1_CAPTURE(power1, cbrt, fpm::fixed_16_48, &fpm::cbrt);
+BENCHMARK_TEMPLATE1_CAPTURE(power1, cbrt, fpm::fixed_8_56, &fpm::cbrt);
 
 BENCHMARK_TEMPLATE1_CAPTURE(power1, log, float, &std::log);
 BENCHMARK_TEMPLATE1_CAPTURE(power1, log, double, &std::log);
@@ -91,12 +136,39 @@ BENCHMARK_TEMPLATE1_CAPTURE(power1, exp, fpm::fixed_16_16, &fpm::exp);
 BENCHMARK_TEMPLATE1_CAPTURE(power1, exp, Fix16, fix16_func<&fix16_exp>);
 BENCHMARK_TEMPLATE1_CAPTURE(power1, exp, CnlFixed16, &cnl::exp);
 
+BENCHMARK_TEMPLATE1_CAPTURE(power1_negative, exp, float, &std::exp);
+BENCHMARK_TEMPLATE1_CAPTURE(power1_negative, exp, double, &std::exp);
+BENCHMARK_TEMPLATE1_CAPTURE(power1_negative, exp, fpm::fixed_24_8, &fpm::exp);
+BENCHMARK_TEMPLATE1_CAPTURE(power1_negative, exp, fpm::fixed_16_16, &fpm::exp);
+BENCHMARK_TEMPLATE1_CAPTURE(power1_negative, exp, fpm::fixed_32_32, &fpm::exp);
+BENCHMARK_TEMPLATE1_CAPTURE(power1_negative, exp, Fix16, fix16_func<&fix16_exp>);
+
 BENCHMARK_TEMPLATE1_CAPTURE(power1, exp2, float, &std::exp2);
 BENCHMARK_TEMPLATE1_CAPTURE(power1, exp2, double, &std::exp2);
 BENCHMARK_TEMPLATE1_CAPTURE(power1, exp2, fpm::fixed_24_8, &fpm::exp2);
 BENCHMARK_TEMPLATE1_CAPTURE(power1, exp2, fpm::fixed_16_16, &fpm::exp2);
 
+// The accuracy tiers: 12 bits, and the resolution of the type
+BENCHMARK_TEMPLATE1_CAPTURE(power1, fast_exp2, fpm::fixed_24_8, &fpm::fast::exp2);
+BENCHMARK_TEMPLATE1_CAPTURE(power1, precise_exp2, fpm::fixed_24_8, &fpm::precise::exp2);
+BENCHMARK_TEMPLATE1_CAPTURE(power1, fast_log2, fpm::fixed_24_8, &fpm::fast::log2);
+BENCHMARK_TEMPLATE1_CAPTURE(power1, precise_log2, fpm::fixed_24_8, &fpm::precise::log2);
+BENCHMARK_TEMPLATE1_CAPTURE(power1, fast_exp2, fpm::fixed_16_16, &fpm::fast::exp2);
+BENCHMARK_TEMPLATE1_CAPTURE(power1, precise_exp2, fpm::fixed_16_16, &fpm::precise::exp2);
+BENCHMARK_TEMPLATE1_CAPTURE(power1, fast_log2, fpm::fixed_16_16, &fpm::fast::log2);
+BENCHMARK_TEMPLATE1_CAPTURE(power1, precise_log2, fpm::fixed_16_16, &fpm::precise::log2);
+BENCHMARK_TEMPLATE1_CAPTURE(power1, fast_exp2, fpm::fixed_32_32, &fpm::fast::exp2);
+BENCHMARK_TEMPLATE1_CAPTURE(power1, precise_exp2, fpm::fixed_32_32, &fpm::precise::exp2);
+BENCHMARK_TEMPLATE1_CAPTURE(power1, fast_log2, fpm::fixed_32_32, &fpm::fast::log2);
+BENCHMARK_TEMPLATE1_CAPTURE(power1, precise_log2, fpm::fixed_32_32, &fpm::precise::log2);
+
 BENCHMARK_TEMPLATE1_CAPTURE(power2, pow, float, &std::pow);
 BENCHMARK_TEMPLATE1_CAPTURE(power2, pow, double, &std::pow);
 BENCHMARK_TEMPLATE1_CAPTURE(power2, pow, fpm::fixed_24_8, &fpm::pow);
 BENCHMARK_TEMPLATE1_CAPTURE(power2, pow, fpm::fixed_16_16, &fpm::pow);
+
+BENCHMARK_TEMPLATE1_CAPTURE(power2, hypot, float, &std::hypot);
+BENCHMARK_TEMPLATE1_CAPTURE(power2, hypot, double, &std::hypot);
+BENCHMARK_TEMPLATE1_CAPTURE(power2, hypot, fpm::fixed_24_8, &fpm::hypot);
+BENCHMARK_TEMPLATE1_CAPTURE(power2, hypot, fpm::fixed_16_16, &fpm::hypot);
+BENCHMARK_TEMPLATE1_CAPTURE(power2, hypot, fpm::fixed_32_32, &fpm::hypot);
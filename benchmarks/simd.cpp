@@ -0,0 +1,253 @@
+#include <benchmark/benchmark.h>
+#include <fpm/fixed.hpp>
+#include <fpm/simd.hpp>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#define BENCHMARK_TEMPLATE1_CAPTURE(func, test_case_name, a, ...)   \
+  BENCHMARK_PRIVATE_DECLARE(func) =                                 \
+      (::benchmark::internal::RegisterBenchmarkInternal(            \
+          new ::benchmark::internal::FunctionBenchmark(             \
+              #func "<" #a ">/" #test_case_name,					\
+              [](::benchmark::State& st) { func<a>(st, __VA_ARGS__); })))
+
+// Number of elements per array operation
+static constexpr std::size_t LENGTH = 4096;
+
+template <typename TValue>
+static std::vector<TValue> make_values(int seed)
+{
+    std::vector<TValue> values(LENGTH);
+    for (std::size_t i = 0; i < LENGTH; ++i)
+    {
+        values[i] = static_cast<TValue>(static_cast<int>((i * 7919 + seed) % 2001) - 1000) / 64;
+    }
+    return values;
+}
+
+enum class Op { add, mul, div, fma, scale, dot };
+
+// An element-wise loop over the scalar operators
+template <typename TValue>
+static void scalar(benchmark::State& state, Op op)
+{
+    const auto x = make_values<TValue>(1), y = make_values<TValue>(2), z = make_values<TValue>(3);
+    auto d = y;
+    for (auto& v : d) v += TValue{100};
+    std::vector<TValue> out(LENGTH);
+    const TValue s = x[17];
+    for (auto _ : state)
+    {
+        const auto each = [&](auto f) {
+            for (std::size_t i = 0; i < LENGTH; ++i) out[i] = f(i);
+        };
+        switch (op)
+        {
+        case Op::add: each([&](std::size_t i) { return x[i] + y[i]; }); break;
+        case Op::mul: each([&](std::size_t i) { return x[i] * y[i]; }); break;
+        case Op::div: each([&](std::size_t i) { return x[i] / d[i]; }); break;
+        case Op::fma: each([&](std::size_t i) { return x[i] * y[i] + z[i]; }); break;
+        case Op::scale: each([&](std::size_t i) { return x[i] * s; }); break;
+        case Op::dot:
+        {
+            // Rounds every product
+            TValue sum{0};
+            for (std::size_t i = 0; i < LENGTH; ++i) sum += x[i] * y[i];
+            out[0] = sum;
+            break;
+        }
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * LENGTH);
+}
+
+template <typename TValue>
+static void bulk(benchmark::State& state, Op op)
+{
+    const auto x = make_values<TValue>(1), y = make_values<TValue>(2), z = make_values<TValue>(3);
+    auto d = y;
+    for (auto& v : d) v += TValue{100};
+    std::vector<TValue> out(LENGTH);
+    const TValue s = x[17];
+    for (auto _ : state)
+    {
+        switch (op)
+        {
+        case Op::add: fpm::simd::add<TValue>(x, y, out); break;
+        case Op::mul: fpm::simd::mul<TValue>(x, y, out); break;
+        case Op::div: fpm::simd::div<TValue>(x, d, out); break;
+        case Op::fma: fpm::simd::fma<TValue>(x, y, z, out); break;
+        case Op::scale: fpm::simd::scale<TValue>(x, s, out); break;
+        case Op::dot: out[0] = fpm::simd::dot<TValue>(x, y); break;
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * LENGTH);
+}
+
+BENCHMARK_TEMPLATE1_CAPTURE(scalar, add, float, Op::add);
+BENCHMARK_TEMPLATE1_CAPTURE(scalar, mul, float, Op::mul);
+BENCHMARK_TEMPLATE1_CAPTURE(scalar, div, float, Op::div);
+BENCHMARK_TEMPLATE1_CAPTURE(scalar, fma, float, Op::fma);
+BENCHMARK_TEMPLATE1_CAPTURE(scalar, scale, float, Op::scale);
+BENCHMARK_TEMPLATE1_CAPTURE(scalar, dot, float, Op::dot);
+
+BENCHMARK_TEMPLATE1_CAPTURE(scalar, add, fpm::fixed_16_16, Op::add);
+BENCHMARK_TEMPLATE1_CAPTURE(scalar, mul, fpm::fixed_16_16, Op::mul);
+BENCHMARK_TEMPLATE1_CAPTURE(scalar, div, fpm::fixed_16_16, Op::div);
+BENCHMARK_TEMPLATE1_CAPTURE(scalar, fma, fpm::fixed_16_16, Op::fma);
+BENCHMARK_TEMPLATE1_CAPTURE(scalar, scale, fpm::fixed_16_16, Op::scale);
+BENCHMARK_TEMPLATE1_CAPTURE(scalar, dot, fpm::fixed_16_16, Op::dot);
+
+BENCHMARK_TEMPLATE1_CAPTURE(bulk, add, fpm::fixed_16_16, Op::add);
+BENCHMARK_TEMPLATE1_CAPTURE(bulk, mul, fpm::fixed_16_16, Op::mul);
+BENCHMARK_TEMPLATE1_CAPTURE(bulk, div, fpm::fixed_16_16, Op::div);
+BENCHMARK_TEMPLATE1_CAPTURE(bulk, fma, fpm::fixed_16_16, Op::fma);
+BENCHMARK_TEMPLATE1_CAPTURE(bulk, scale, fpm::fixed_16_16, Op::scale);
+BENCHMARK_TEMPLATE1_CAPTURE(bulk, dot, fpm::fixed_16_16, Op::dot);
+
+using Stochastic16_16 = fpm::fixed<std::int32_t, std::int64_t, 16, fpm::rounding::stochastic>;
+BENCHMARK_TEMPLATE1_CAPTURE(scalar, mul, Stochastic16_16, Op::mul);
+BENCHMARK_TEMPLATE1_CAPTURE(scalar, fma, Stochastic16_16, Op::fma);
+BENCHMARK_TEMPLATE1_CAPTURE(bulk, mul, Stochastic16_16, Op::mul);
+BENCHMARK_TEMPLATE1_CAPTURE(bulk, fma, Stochastic16_16, Op::fma);
+
+enum class Func { sin, cos, exp, log, sqrt };
+
+// Arguments inside each function's domain
+template <typename TValue>
+static std::vector<TValue> make_arguments(Func func)
+{
+    auto values = make_values<TValue>(1);
+    for (auto& v : values)
+    {
+        switch (func)
+        {
+        case Func::exp: v = v / 2; break;
+        case Func::log:
+        case Func::sqrt: v = (v < TValue{0}) ? -v + TValue{0.5} : v + TValue{0.5}; break;
+        default: break;
+        }
+    }
+    return values;
+}
+
+// An element-wise loop over the scalar functions
+template <typename TValue>
+static void math_scalar(benchmark::State& state, Func func)
+{
+    using std::sin, std::cos, std::exp, std::log, std::sqrt;
+    const auto x = make_arguments<TValue>(func);
+    std::vector<TValue> out(LENGTH);
+    for (auto _ : state)
+    {
+        const auto each = [&](auto f) {
+            for (std::size_t i = 0; i < LENGTH; ++i) out[i] = f(x[i]);
+        };
+        switch (func)
+        {
+        case Func::sin: each([](TValue v) { return sin(v); }); break;
+        case Func::cos: each([](TValue v) { return cos(v); }); break;
+        case Func::exp: each([](TValue v) { return exp(v); }); break;
+        case Func::log: each([](TValue v) { return log(v); }); break;
+        case Func::sqrt: each([](TValue v) { return sqrt(v); }); break;
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * LENGTH);
+}
+
+template <typename TValue>
+static void math_bulk(benchmark::State& state, Func func)
+{
+    const auto x = make_arguments<TValue>(func);
+    std::vector<TValue> out(LENGTH);
+    for (auto _ : state)
+    {
+        switch (func)
+        {
+        case Func::sin: fpm::simd::sin<TValue>(x, out); break;
+        case Func::cos: fpm::simd::cos<TValue>(x, out); break;
+        case Func::exp: fpm::simd::exp<TValue>(x, out); break;
+        case Func::log: fpm::simd::log<TValue>(x, out); break;
+        case Func::sqrt: fpm::simd::sqrt<TValue>(x, out); break;
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * LENGTH);
+}
+
+BENCHMARK_TEMPLATE1_CAPTURE(math_scalar, sin, float, Func::sin);
+BENCHMARK_TEMPLATE1_CAPTURE(math_scalar, cos, float, Func::cos);
+BENCHMARK_TEMPLATE1_CAPTURE(math_scalar, exp, float, Func::exp);
+BENCHMARK_TEMPLATE1_CAPTURE(math_scalar, log, float, Func::log);
+BENCHMARK_TEMPLATE1_CAPTURE(math_scalar, sqrt, float, Func::sqrt);
+
+BENCHMARK_TEMPLATE1_CAPTURE(math_scalar, sin, fpm::fixed_16_16, Func::sin);
+BENCHMARK_TEMPLATE1_CAPTURE(math_scalar, cos, fpm::fixed_16_16, Func::cos);
+BENCHMARK_TEMPLATE1_CAPTURE(math_scalar, exp, fpm::fixed_16_16, Func::exp);
+BENCHMARK_TEMPLATE1_CAPTURE(math_scalar, log, fpm::fixed_16_16, Func::log);
+BENCHMARK_TEMPLATE1_CAPTURE(math_scalar, sqrt, fpm::fixed_16_16, Func::sqrt);
+
+BENCHMARK_TEMPLATE1_CAPTURE(math_bulk, sin, fpm::fixed_16_16, Func::sin);
+BENCHMARK_TEMPLATE1_CAPTURE(math_bulk, cos, fpm::fixed_16_16, Func::cos);
+BENCHMARK_TEMPLATE1_CAPTURE(math_bulk, exp, fpm::fixed_16_16, Func::exp);
+BENCHMARK_TEMPLATE1_CAPTURE(math_bulk, log, fpm::fixed_16_16, Func::log);
+BENCHMARK_TEMPLATE1_CAPTURE(math_bulk, sqrt, fpm::fixed_16_16, Func::sqrt);
+
+// Lengths of 2D or 3D vectors, with their components in separate arrays
+template <typename TValue>
+static void hypot_scalar(benchmark::State& state, int components)
+{
+    using std::hypot;
+    const auto x = make_values<TValue>(1), y = make_values<TValue>(2), z = make_values<TValue>(3);
+    std::vector<TValue> out(LENGTH);
+    for (auto _ : state)
+    {
+        if (components == 2)
+        {
+            for (std::size_t i = 0; i < LENGTH; ++i) out[i] = hypot(x[i], y[i]);
+        }
+        else
+        {
+            for (std::size_t i = 0; i < LENGTH; ++i) out[i] = hypot(x[i], y[i], z[i]);
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * LENGTH);
+}
+
+template <typename TValue>
+static void hypot_bulk(benchmark::State& state, int components)
+{
+    const auto x = make_values<TValue>(1), y = make_values<TValue>(2), z = make_values<TValue>(3);
+    std::vector<TValue> out(LENGTH);
+    for (auto _ : state)
+    {
+        if (components == 2)
+        {
+            fpm::simd::hypot<TValue>(x, y, out);
+        }
+        else
+        {
+            fpm::simd::hypot<TValue>(x, y, z, out);
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * LENGTH);
+}
+
+BENCHMARK_TEMPLATE1_CAPTURE(hypot_scalar, 2d, float, 2);
+BENCHMARK_TEMPLATE1_CAPTURE(hypot_scalar, 3d, float, 3);
+BENCHMARK_TEMPLATE1_CAPTURE(hypot_scalar, 2d, fpm::fixed_16_16, 2);
+BENCHMARK_TEMPLATE1_CAPTURE(hypot_scalar, 3d, fpm::fixed_16_16, 3);
+BENCHMARK_TEMPLATE1_CAPTURE(hypot_bulk, 2d, fpm::fixed_16_16, 2);
+BENCHMARK_TEMPLATE1_CAPTURE(hypot_bulk, 3d, fpm::fixed_16_16, 3);
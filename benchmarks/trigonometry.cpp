@@ -1,7 +1,9 @@
 #include <benchmark/benchmark.h>
+#include <fpm/angle.hpp>
 #include <fpm/fixed.hpp>
 #include <fpm/math.hpp>
 #include <fixmath.h>
+#include <utility>
 
 #define BENCHMARK_TEMPLATE1_CAPTURE(func, test_case_name, a, ...)   \
   BENCHMARK_PRIVATE_DECLARE(func) =                                 \
@@ -44,6 +46,41 @@ static TValue func2_proxy(TValue value)
     return func(value, value + 2);
 }
 
+// Both sin and cos of the same argument
+template <typename TValue>
+static void sin_cos(benchmark::State& state, std::pair<TValue, TValue> (*func)(TValue))
+{
+    for (auto _ : state)
+    {
+        TValue x{ static_cast<TValue>(s_x / 256.0) };
+        benchmark::DoNotOptimize(func(x));
+    }
+}
+
+template <typename TValue, TValue (*sin_func)(TValue), TValue (*cos_func)(TValue)>
+static std::pair<TValue, TValue> separate_proxy(TValue value)
+{
+    return { sin_func(value), cos_func(value) };
+}
+
+// Trigonometry on binary angles
+template <typename TValue>
+static void angle_trigonometry(benchmark::State& state, TValue (*func)(fpm::angle<32>))
+{
+    for (auto _ : state)
+    {
+        const auto a = fpm::angle<32>::from_raw_value(static_cast<std::uint32_t>(s_x) << 20);
+        benchmark::DoNotOptimize(func(a));
+    }
+}
+
+template <typename TValue>
+static TValue atan2_angle_proxy(TValue value)
+{
+    // Add a 'random' offset for the second argument
+    return fpm::atan2<fpm::angle<32>>(value, value + 2).template to_radians<TValue>();
+}
+
 BENCHMARK_TEMPLATE1_CAPTURE(trigonometry, sin, float, &std::sin);
 BENCHMARK_TEMPLATE1_CAPTURE(trigonometry, cos, float, &std::cos);
 BENCHMARK_TEMPLATE1_CAPTURE(trigonometry, tan, float, &std::tan);
@@ -76,6 +113,45 @@ BENCHMARK_TEMPLATE1_CAPTURE(trigonometry, acos, fpm::fixed_16_16, &fpm::acos);
 BENCHMARK_TEMPLATE1_CAPTURE(trigonometry, atan, fpm::fixed_16_16, &fpm::atan);
 BENCHMARK_TEMPLATE1_CAPTURE(trigonometry, atan2, fpm::fixed_16_16, &func2_proxy<fpm::fixed_16_16, &fpm::atan2>);
 
+// Two separate calls versus one sincos call
+BENCHMARK_TEMPLATE1_CAPTURE(sin_cos, separate, float, &separate_proxy<float, &std::sin, &std::cos>);
+BENCHMARK_TEMPLATE1_CAPTURE(sin_cos, separate, fpm::fixed_16_16, &separate_proxy<fpm::fixed_16_16, &fpm::sin, &fpm::cos>);
+BENCHMARK_TEMPLATE1_CAPTURE(sin_cos, sincos, fpm::fixed_16_16, &fpm::sincos);
+BENCHMARK_TEMPLATE1_CAPTURE(sin_cos, lut_separate, fpm::fixed_16_16, &separate_proxy<fpm::fixed_16_16, &fpm::lut::sin<256, 1>, &fpm::lut::cos<256, 1>>);
+BENCHMARK_TEMPLATE1_CAPTURE(sin_cos, lut_sincos, fpm::fixed_16_16, &fpm::lut::sincos<256, 1>);
+
+// Table-driven sin/cos: the default table, and a small table with cubic interpolation
+BENCHMARK_TEMPLATE1_CAPTURE(trigonometry, lut_sin, fpm::fixed_24_8, &fpm::lut::sin<256, 1>);
+BENCHMARK_TEMPLATE1_CAPTURE(trigonometry, lut_cos, fpm::fixed_24_8, &fpm::lut::cos<256, 1>);
+BENCHMARK_TEMPLATE1_CAPTURE(trigonometry, lut_sin, fpm::fixed_16_16, &fpm::lut::sin<256, 1>);
+BENCHMARK_TEMPLATE1_CAPTURE(trigonometry, lut_cos, fpm::fixed_16_16, &fpm::lut::cos<256, 1>);
+BENCHMARK_TEMPLATE1_CAPTURE(trigonometry, lut_sin_cubic, fpm::fixed_16_16, &fpm::lut::sin<64, 3>);
+BENCHMARK_TEMPLATE1_CAPTURE(trigonometry, lut_cos_cubic, fpm::fixed_16_16, &fpm::lut::cos<64, 3>);
+
+// The accuracy tiers: 12 bits, and the resolution of the type
+BENCHMARK_TEMPLATE1_CAPTURE(trigonometry, fast_sin, fpm::fixed_24_8, &fpm::fast::sin);
+BENCHMARK_TEMPLATE1_CAPTURE(trigonometry, precise_sin, fpm::fixed_24_8, &fpm::precise::sin);
+BENCHMARK_TEMPLATE1_CAPTURE(trigonometry, fast_cos, fpm::fixed_24_8, &fpm::fast::cos);
+BENCHMARK_TEMPLATE1_CAPTURE(trigonometry, precise_cos, fpm::fixed_24_8, &fpm::precise::cos);
+BENCHMARK_TEMPLATE1_CAPTURE(trigonometry, fast_atan, fpm::fixed_24_8, &fpm::fast::atan);
+BENCHMARK_TEMPLATE1_CAPTURE(trigonometry, precise_atan, fpm::fixed_24_8, &fpm::precise::atan);
+BENCHMARK_TEMPLATE1_CAPTURE(trigonometry, fast_sin, fpm::fixed_16_16, &fpm::fast::sin);
+BENCHMARK_TEMPLATE1_CAPTURE(trigonometry, precise_sin, fpm::fixed_16_16, &fpm::precise::sin);
+BENCHMARK_TEMPLATE1_CAPTURE(trigonometry, fast_cos, fpm::fixed_16_16, &fpm::fast::cos);
+BENCHMARK_TEMPLATE1_CAPTURE(trigonometry, precise_cos, fpm::fixed_16_16, &fpm::precise::cos);
+BENCHMARK_TEMPLATE1_CAPTURE(trigonometry, fast_atan, fpm::fixed_16_16, &fpm::fast::atan);
+BENCHMARK_TEMPLATE1_CAPTURE(trigonometry, precise_atan, fpm::fixed_16_16, &fpm::precise::atan);
+BENCHMARK_TEMPLATE1_CAPTURE(trigonometry, fast_sin, fpm::fixed_32_32, &fpm::fast::sin);
+BENCHMARK_TEMPLATE1_CAPTURE(trigonometry, precise_sin, fpm::fixed_32_32, &fpm::precise::sin);
+BENCHMARK_TEMPLATE1_CAPTURE(trigonometry, fast_cos, fpm::fixed_32_32, &fpm::fast::cos);
+BENCHMARK_TEMPLATE1_CAPTURE(trigonometry, precise_cos, fpm::fixed_32_32, &fpm::precise::cos);
+BENCHMARK_TEMPLATE1_CAPTURE(trigonometry, fast_atan, fpm::fixed_32_32, &fpm::fast::atan);
+BENCHMARK_TEMPLATE1_CAPTURE(trigonometry, precise_atan, fpm::fixed_32_32, &fpm::precise::atan);
+
+BENCHMARK_TEMPLATE1_CAPTURE(angle_trigonometry, sin, fpm::fixed_16_16, &fpm::sin<fpm::fixed_16_16>);
+BENCHMARK_TEMPLATE1_CAPTURE(angle_trigonometry, cos, fpm::fixed_16_16, &fpm::cos<fpm::fixed_16_16>);
+BENCHMARK_TEMPLATE1_CAPTURE(trigonometry, atan2_angle, fpm::fixed_16_16, &atan2_angle_proxy<fpm::fixed_16_16>);
+
 BENCHMARK_TEMPLATE1_CAPTURE(trigonometry, sin,  Fix16, fix16_func1<&Fix16::sin>);
 BENCHMARK_TEMPLATE1_CAPTURE(trigonometry, cos,  Fix16, fix16_func1<&Fix16::cos>);
 BENCHMARK_TEMPLATE1_CAPTURE(trigonometry, tan,  Fix16, fix16_func1<&Fix16::tan>);
@@ -0,0 +1,98 @@
+#ifndef FPM_ACCUMULATOR_HPP
+#define FPM_ACCUMULATOR_HPP
+
+#include "fixed.hpp"
+
+#include <type_traits>
+
+namespace fpm
+{
+
+//! Sum of fixed-point numbers and products at the full precision of the intermediate type.
+//! Products of two Fixed numbers have twice its fraction bits, and are added without rounding or narrowing
+//! them to the base type. The sum is rounded once, with the rounding mode of Fixed, when it's read.
+//! Like the operators of Fixed, the sum must fit in the intermediate type.
+//! \tparam Fixed the fixed-point type of the operands and the result
+template <typename Fixed> requires is_fixed_v<Fixed>
+struct accumulator
+{
+    using value_type = Fixed;
+    using intermediate_type = typename Fixed::intermediate_type;
+
+    //! The number of fraction bits of the sum
+    static constexpr unsigned int fraction_bits = Fixed::fraction_bits * 2;
+
+    constexpr inline accumulator() noexcept = default;
+
+    /// Starts the sum at a fixed-point number. This is lossless.
+    constexpr inline explicit accumulator(Fixed value) noexcept
+        : m_value(widen(value))
+    {}
+
+    /// Returns an accumulator with the given sum, which has fraction_bits fraction bits.
+    [[nodiscard]] static constexpr inline accumulator from_raw_value(intermediate_type value) noexcept
+    {
+        accumulator result;
+        result.m_value = value;
+        return result;
+    }
+
+    /// Returns the sum, which has fraction_bits fraction bits.
+    [[nodiscard]] constexpr inline intermediate_type raw_value() const noexcept
+    {
+        return m_value;
+    }
+
+    /// Returns the sum rounded to Fixed. Like the operators of Fixed, this wraps around if it doesn't fit.
+    [[nodiscard]] constexpr inline Fixed value() const noexcept
+    {
+        using B = typename Fixed::base_type;
+        return Fixed::from_raw_value(static_cast<B>(detail::shift_right<Fixed::rounding_mode>(m_value, Fixed::fraction_bits)));
+    }
+
+    [[nodiscard]] constexpr inline explicit operator Fixed() const noexcept
+    {
+        return value();
+    }
+
+    /// Adds x * y without rounding the product, unlike `*this += x * y`.
+    constexpr inline accumulator& fma(Fixed x, Fixed y) noexcept
+    {
+        m_value += static_cast<intermediate_type>(x.raw_value()) * y.raw_value();
+        return *this;
+    }
+
+    /// Subtracts x * y without rounding the product.
+    constexpr inline accumulator& fms(Fixed x, Fixed y) noexcept
+    {
+        m_value -= static_cast<intermediate_type>(x.raw_value()) * y.raw_value();
+        return *this;
+    }
+
+    constexpr inline accumulator& operator+=(Fixed y) noexcept { m_value += widen(y); return *this; }
+    constexpr inline accumulator& operator-=(Fixed y) noexcept { m_value -= widen(y); return *this; }
+    /// Adds or subtracts a product of mul_wide(), which has the format of the sum.
+    template <typename W, auto R>
+    constexpr inline accumulator& operator+=(fixed<intermediate_type, W, fraction_bits, R> y) noexcept { m_value += y.raw_value(); return *this; }
+    template <typename W, auto R>
+    constexpr inline accumulator& operator-=(fixed<intermediate_type, W, fraction_bits, R> y) noexcept { m_value -= y.raw_value(); return *this; }
+    constexpr inline accumulator& operator+=(const accumulator& y) noexcept { m_value += y.m_value; return *this; }
+    constexpr inline accumulator& operator-=(const accumulator& y) noexcept { m_value -= y.m_value; return *this; }
+
+    [[nodiscard]] friend constexpr inline accumulator operator+(accumulator x, const accumulator& y) noexcept { return x += y; }
+    [[nodiscard]] friend constexpr inline accumulator operator-(accumulator x, const accumulator& y) noexcept { return x -= y; }
+
+    [[nodiscard]] friend constexpr inline bool operator==(const accumulator& x, const accumulator& y) noexcept = default;
+
+private:
+    [[nodiscard]] static constexpr inline intermediate_type widen(Fixed x) noexcept
+    {
+        return static_cast<intermediate_type>(x.raw_value()) * Fixed::FRACTION_MULT;
+    }
+
+    intermediate_type m_value = 0;
+};
+
+}
+
+#endif
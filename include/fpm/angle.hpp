@@ -0,0 +1,303 @@
+#ifndef FPM_ANGLE_HPP
+#define FPM_ANGLE_HPP
+
+#include "fixed.hpp"
+#include "math.hpp"
+
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+
+namespace fpm
+{
+
+namespace detail
+{
+
+template <unsigned int Bits> struct angle_storage;
+template <> struct angle_storage<8> { using type = std::uint8_t; };
+template <> struct angle_storage<16> { using type = std::uint16_t; };
+template <> struct angle_storage<32> { using type = std::uint32_t; };
+template <> struct angle_storage<64> { using type = std::uint64_t; };
+
+}
+
+//! Binary angle: an unsigned integer where the integer wrap-around is one full turn.
+//! Adding and subtracting angles wraps around for free, and the quadrant is in the two highest bits,
+//! so trigonometric functions don't need any range reduction.
+//! \tparam Bits the number of bits in the angle: 8, 16, 32 or 64
+template <unsigned int Bits = 32>
+struct angle
+{
+    using value_type = typename detail::angle_storage<Bits>::type;
+    static constexpr unsigned int bits = Bits;
+
+    constexpr inline angle() noexcept = default;
+
+    /// Converts between binary angles with a different number of bits.
+    /// Narrowing conversions round to the nearest angle.
+    template <unsigned int B>
+    constexpr inline explicit angle(angle<B> a) noexcept
+        : m_value(convert<B>(a.raw_value()))
+    {}
+
+    /// Converts an angle in radians. Any angle is accepted and wrapped around to [-pi, pi).
+    template <typename B, typename I, unsigned int F, auto R>
+    [[nodiscard]] static constexpr angle from_radians(fixed<B, I, F, R> x) noexcept
+    {
+        return angle(angle<64>::from_raw_value(detail::binary_angle(x)));
+    }
+
+    /// Converts to radians in the range [-pi, pi], rounded with the rounding mode of the fixed-point type.
+    /// The largest angles round to pi. The fixed-point type must be able to contain pi, with at most 59 fraction bits.
+    template <typename Fixed> requires is_fixed_v<Fixed>
+    [[nodiscard]] constexpr Fixed to_radians() const noexcept
+    {
+        using B = typename Fixed::base_type;
+        constexpr unsigned int F = Fixed::fraction_bits;
+        static_assert(F <= 59, "to_radians supports at most 59 fraction bits");
+
+        // 2*pi with 61 fraction bits
+        constexpr std::uint64_t two_pi = 0xC90FDAA22168C235ull;
+
+        // The angle as a signed 64-bit fraction of a turn, times 2*pi, is the angle in radians with
+        // 61 fraction bits in the high half of the product. This is a 64x64-bit multiplication in
+        // 32-bit halves, so that no 128-bit integers are needed.
+        const std::uint64_t turns = std::uint64_t{m_value} << (64 - Bits);
+        const std::uint64_t t_low = turns & 0xFFFFFFFFu, t_high = turns >> 32;
+        constexpr std::uint64_t c_low = two_pi & 0xFFFFFFFFu, c_high = two_pi >> 32;
+        const std::uint64_t low_low = t_low * c_low;
+        const std::uint64_t middle = t_high * c_low + (low_low >> 32);
+        const std::uint64_t cross = t_low * c_high + (middle & 0xFFFFFFFFu);
+        std::uint64_t high = t_high * c_high + (middle >> 32) + (cross >> 32);
+        const std::uint64_t low = (cross << 32) | (low_low & 0xFFFFFFFFu);
+
+        // The turns are signed: a negative one is 2**64 too large
+        if (static_cast<std::int64_t>(turns) < 0) {
+            high -= two_pi;
+        }
+
+        // Any bits of the low half only decide rounding, so they are folded into the lowest bit
+        const auto value = static_cast<std::int64_t>(high | ((low != 0) ? 1 : 0));
+        return Fixed::from_raw_value(static_cast<B>(detail::shift_right<Fixed::rounding_mode>(value, 61 - F)));
+    }
+
+    [[nodiscard]] static constexpr angle from_raw_value(value_type value) noexcept
+    {
+        angle a;
+        a.m_value = value;
+        return a;
+    }
+
+    [[nodiscard]] constexpr value_type raw_value() const noexcept
+    {
+        return m_value;
+    }
+
+    [[nodiscard]] static constexpr angle quarter_turn() noexcept { return from_raw_value(value_type(1) << (Bits - 2)); }
+    [[nodiscard]] static constexpr angle half_turn() noexcept { return from_raw_value(value_type(1) << (Bits - 1)); }
+
+    //
+    // Arithmetic member operators. These all wrap around.
+    //
+
+    [[nodiscard]] constexpr angle operator-() const noexcept
+    {
+        return from_raw_value(static_cast<value_type>(0 - std::uint64_t{m_value}));
+    }
+
+    constexpr angle& operator+=(angle y) noexcept
+    {
+        m_value = static_cast<value_type>(std::uint64_t{m_value} + y.m_value);
+        return *this;
+    }
+
+    constexpr angle& operator-=(angle y) noexcept
+    {
+        m_value = static_cast<value_type>(std::uint64_t{m_value} - y.m_value);
+        return *this;
+    }
+
+    template <typename T> requires std::is_integral_v<T>
+    constexpr angle& operator*=(T y) noexcept
+    {
+        m_value = static_cast<value_type>(std::uint64_t{m_value} * static_cast<std::uint64_t>(y));
+        return *this;
+    }
+
+    [[nodiscard]] friend constexpr bool operator==(angle x, angle y) noexcept = default;
+
+private:
+    template <unsigned int B>
+    [[nodiscard]] static constexpr value_type convert(typename angle<B>::value_type value) noexcept
+    {
+        if constexpr (B >= Bits) {
+            // Round to nearest, wrapping a half step below a full turn around to zero
+            if constexpr (B == Bits) {
+                return value;
+            } else {
+                constexpr auto half = static_cast<typename angle<B>::value_type>(1) << (B - Bits - 1);
+                return static_cast<value_type>(static_cast<typename angle<B>::value_type>(value + half) >> (B - Bits));
+            }
+        } else {
+            return static_cast<value_type>(static_cast<value_type>(value) << (Bits - B));
+        }
+    }
+
+    value_type m_value;
+};
+
+//
+// Arithmetic operators
+//
+
+template <unsigned int Bits>
+[[nodiscard]] constexpr inline angle<Bits> operator+(angle<Bits> x, angle<Bits> y) noexcept
+{
+    return x += y;
+}
+
+template <unsigned int Bits>
+[[nodiscard]] constexpr inline angle<Bits> operator-(angle<Bits> x, angle<Bits> y) noexcept
+{
+    return x -= y;
+}
+
+template <unsigned int Bits, typename T> requires std::is_integral_v<T>
+[[nodiscard]] constexpr inline angle<Bits> operator*(angle<Bits> x, T y) noexcept
+{
+    return x *= y;
+}
+
+template <unsigned int Bits, typename T> requires std::is_integral_v<T>
+[[nodiscard]] constexpr inline angle<Bits> operator*(T x, angle<Bits> y) noexcept
+{
+    return y *= x;
+}
+
+//
+// Trigonometry
+//
+
+/// Calculates sin(a) in the requested fixed-point type like fpm::lut::sin, with the same table parameters.
+template <typename Fixed, std::size_t Size = 256, unsigned int Order = 1, unsigned int Bits> requires is_fixed_v<Fixed>
+[[nodiscard]] constexpr Fixed sin(angle<Bits> a) noexcept
+{
+    return detail::from_q30<Fixed>(detail::lut_sin<Size, Order>(angle<64>(a).raw_value()));
+}
+
+/// Calculates cos(a) in the requested fixed-point type like fpm::lut::cos, with the same table parameters.
+template <typename Fixed, std::size_t Size = 256, unsigned int Order = 1, unsigned int Bits> requires is_fixed_v<Fixed>
+[[nodiscard]] constexpr Fixed cos(angle<Bits> a) noexcept
+{
+    return detail::from_q30<Fixed>(detail::lut_sin<Size, Order>(angle<64>(a + angle<Bits>::quarter_turn()).raw_value()));
+}
+
+/// Calculates sin(a) and cos(a) in the requested fixed-point type like fpm::lut::sin and fpm::lut::cos, with the
+/// same table parameters.
+template <typename Fixed, std::size_t Size = 256, unsigned int Order = 1, unsigned int Bits> requires is_fixed_v<Fixed>
+[[nodiscard]] constexpr std::pair<Fixed, Fixed> sincos(angle<Bits> a) noexcept
+{
+    return { sin<Fixed, Size, Order>(a), cos<Fixed, Size, Order>(a) };
+}
+
+namespace detail
+{
+
+/// Calculates atan(x) for x in [0, 1] with a Taylor series of atan(x) - atan(c) around a nearby c, for use in
+/// constant expressions.
+[[nodiscard]] constexpr double atan_taylor(double x) noexcept
+{
+    // atan(x) = atan(c) + atan((x - c) / (1 + x*c)), with atan(1/2) precomputed so the series converges quickly
+    constexpr double atan_half = 0.463647609000806116214;
+    const double c = (x > 0.25) ? 0.5 : 0.0;
+    const double u = (x - c) / (1 + x * c);
+    double power = u, sum = u;
+    for (int n = 3; n < 64; n += 2) {
+        power *= -u * u;
+        sum += power / n;
+    }
+    return ((c != 0) ? atan_half : 0) + sum;
+}
+
+/// Table of atan(x) for x in [0, 1] in atan_table_size steps, with the derivatives for cubic interpolation.
+/// Both are in units of 2**-40 turns.
+inline constexpr std::size_t atan_table_size = 128;
+
+struct atan_table_entry
+{
+    std::int64_t value;
+    std::int64_t slope;
+};
+
+inline constexpr auto atan_table = [] {
+    constexpr double scale = 1099511627776.0 / 6.28318530717958647692;  // 2**40 / 2pi
+    std::array<atan_table_entry, atan_table_size + 1> table{};
+    for (std::size_t i = 0; i <= atan_table_size; ++i) {
+        const double x = static_cast<double>(i) / atan_table_size;
+        table[i].value = static_cast<std::int64_t>(atan_taylor(x) * scale + 0.5);
+        table[i].slope = static_cast<std::int64_t>(scale / (1 + x * x) / atan_table_size + 0.5);
+    }
+    return table;
+}();
+
+}
+
+/// Calculates atan2(y, x) as a binary angle, e.g. fpm::atan2<fpm::angle<32>>(y, x).
+///
+/// The vector is reduced to the first octant, where atan(min / max) is interpolated in a table. Unlike
+/// fpm::atan2, the ratio is calculated on the normalized magnitudes so it can't overflow for small x.
+/// The result is accurate to about 2**-34 turns, limited by the 32-bit ratio.
+template <typename Angle, typename B, typename I, unsigned int F, auto R> requires std::is_same_v<Angle, angle<Angle::bits>>
+[[nodiscard]] constexpr Angle atan2(fixed<B, I, F, R> y, fixed<B, I, F, R> x) noexcept
+{
+    assert(y.raw_value() != 0 || x.raw_value() != 0);
+    constexpr auto& table = detail::atan_table;
+    constexpr unsigned int index_bits = std::countr_zero(detail::atan_table_size);
+
+    const auto magnitude = [](B v) {
+        return (v < 0) ? 0 - static_cast<std::uint64_t>(v) : static_cast<std::uint64_t>(v);
+    };
+    const std::uint64_t ax = magnitude(x.raw_value()), ay = magnitude(y.raw_value());
+    const bool steep = ay > ax;
+    std::uint64_t max = steep ? ay : ax, min = steep ? ax : ay;
+
+    // min / max as a Q0.32 number. Normalizing max keeps 32 significant bits in the divisor.
+    const int shift = std::countl_zero(max);
+    max <<= shift;
+    min <<= shift;
+    std::uint64_t ratio = (max == 0) ? 0 : min / (max >> 32);
+    ratio = (ratio < (std::uint64_t{1} << 32)) ? ratio : (std::uint64_t{1} << 32) - 1;
+
+    // Cubic Hermite interpolation, with the weight as a Q0.(32 - index_bits) number
+    constexpr unsigned int weight_bits = 32 - index_bits;
+    const auto i = static_cast<std::size_t>(ratio >> weight_bits);
+    const auto w = static_cast<std::int64_t>(ratio & ((std::uint64_t{1} << weight_bits) - 1));
+    const std::int64_t y0 = table[i].value, y1 = table[i + 1].value;
+    const std::int64_t m0 = table[i].slope, m1 = table[i + 1].slope;
+    const std::int64_t c2 = 3 * (y1 - y0) - 2 * m0 - m1;
+    const std::int64_t c3 = m0 + m1 - 2 * (y1 - y0);
+    const std::int64_t octant = y0 + ((w * (m0 + ((w * (c2 + ((w * c3) >> weight_bits))) >> weight_bits))) >> weight_bits);
+
+    // Unfold the octant into the full circle
+    std::uint64_t z = static_cast<std::uint64_t>(octant) << 24;
+    if (steep) {
+        z = (std::uint64_t{1} << 62) - z;
+    }
+    if (x.raw_value() < 0) {
+        z = (std::uint64_t{1} << 63) - z;
+    }
+    if (y.raw_value() < 0) {
+        z = 0 - z;
+    }
+    return Angle(angle<64>::from_raw_value(z));
+}
+
+}
+
+#endif
@@ -0,0 +1,433 @@
+#ifndef FPM_CHECKED_HPP
+#define FPM_CHECKED_HPP
+
+#include "fixed.hpp"
+#include "overflow.hpp"
+
+#include <cassert>
+#include <compare>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace fpm
+{
+
+//! Sticky overflow flag, like the floating-point exception flags.
+//! Checked operations only ever set the flag, so it can be tested once at the end of a batch of calculations.
+class overflow_flag
+{
+public:
+    constexpr inline overflow_flag() noexcept = default;
+
+    /// Returns true if any overflow was raised since the flag was last cleared.
+    [[nodiscard]] constexpr inline bool test() const noexcept
+    {
+        return m_raised;
+    }
+
+    [[nodiscard]] constexpr inline explicit operator bool() const noexcept
+    {
+        return m_raised;
+    }
+
+    constexpr inline void clear() noexcept
+    {
+        m_raised = false;
+    }
+
+    /// Sets the flag if \a overflow is true. This is a single OR, without a branch.
+    constexpr inline void raise(bool overflow = true) noexcept
+    {
+        m_raised |= overflow;
+    }
+
+private:
+    bool m_raised = false;
+};
+
+/// Returns the overflow flag of the current thread, which is used by fpm::checked.
+[[nodiscard]] inline overflow_flag& thread_overflow_flag() noexcept
+{
+    thread_local overflow_flag flag;
+    return flag;
+}
+
+namespace detail
+{
+
+template <typename B, typename I>
+[[nodiscard]] constexpr inline bool add_overflow(B x, B y, B& result) noexcept
+{
+#ifdef FPM_OVERFLOW_BUILTINS
+    return __builtin_add_overflow(x, y, &result);
+#else
+    if constexpr (std::is_signed_v<B>) {
+        const I value = static_cast<I>(x) + static_cast<I>(y);
+        result = static_cast<B>(value);
+        return overflows<B>(value);
+    } else {
+        result = static_cast<B>(x + y);
+        return result < x;
+    }
+#endif
+}
+
+template <typename B, typename I>
+[[nodiscard]] constexpr inline bool sub_overflow(B x, B y, B& result) noexcept
+{
+#ifdef FPM_OVERFLOW_BUILTINS
+    return __builtin_sub_overflow(x, y, &result);
+#else
+    if constexpr (std::is_signed_v<B>) {
+        const I value = static_cast<I>(x) - static_cast<I>(y);
+        result = static_cast<B>(value);
+        return overflows<B>(value);
+    } else {
+        result = static_cast<B>(x - y);
+        return x < y;
+    }
+#endif
+}
+
+template <typename B, typename I, typename T>
+[[nodiscard]] constexpr inline bool mul_overflow(B x, T y, B& result) noexcept
+{
+#ifdef FPM_OVERFLOW_BUILTINS
+    return __builtin_mul_overflow(x, y, &result);
+#else
+    result = static_cast<B>(static_cast<std::uint64_t>(x) * static_cast<std::uint64_t>(y));
+    if constexpr (!std::is_signed_v<B>) {
+        if (std::cmp_less(y, 0)) {
+            return x != 0;
+        }
+    }
+    return overflows<B>(static_cast<I>(x) * clamp_multiplier<B, I>(y));
+#endif
+}
+
+} // namespace detail
+
+//
+// Checked conversions
+//
+
+/// Converts an integral number like the converting constructor, and raises \a flag if it doesn't fit.
+template <typename Fixed, typename T> requires (is_fixed_v<Fixed> && std::is_integral_v<T>)
+[[nodiscard]] constexpr inline Fixed checked_cast(T value, overflow_flag& flag) noexcept
+{
+    using B = typename Fixed::base_type;
+    flag.raise(std::cmp_less(value, detail::integral_min_v<Fixed>) | std::cmp_greater(value, detail::integral_max_v<Fixed>));
+    return Fixed::from_raw_value(static_cast<B>(static_cast<B>(value) * Fixed::FRACTION_MULT));
+}
+
+/// Converts a floating-point number like the converting constructor, and raises \a flag if it doesn't fit.
+/// Values that don't fit, including NaN, convert to zero instead of the undefined result of the constructor.
+template <typename Fixed, typename T> requires (is_fixed_v<Fixed> && std::is_floating_point_v<T>)
+[[nodiscard]] constexpr inline Fixed checked_cast(T value, overflow_flag& flag) noexcept
+{
+    using B = typename Fixed::base_type;
+    const T scaled = detail::round_scaled<Fixed::rounding_mode>(value * static_cast<T>(Fixed::FRACTION_MULT));
+    const bool fits = (scaled >= detail::float_min_v<B, T>) && (scaled < detail::float_end_v<B, T>);
+    flag.raise(!fits);
+    return Fixed::from_raw_value(fits ? static_cast<B>(scaled) : B{0});
+}
+
+/// Converts between fixed-point types like the converting constructor, and raises \a flag if the value doesn't fit.
+template <typename Fixed, typename B, typename I, unsigned int F, auto R> requires is_fixed_v<Fixed>
+[[nodiscard]] constexpr inline Fixed checked_cast(fixed<B, I, F, R> value, overflow_flag& flag) noexcept
+{
+    using TB = typename Fixed::base_type;
+    const auto result = detail::rescale_wide<Fixed>(value);
+    flag.raise(detail::overflows<TB>(result));
+    return Fixed::from_raw_value(static_cast<TB>(result));
+}
+
+//
+// Checked arithmetic on plain fixed-point numbers.
+// These raise \a flag if the result didn't fit. The results then wrap modulo 2^bits of the base type, where the
+// regular operators have no defined result.
+//
+
+template <typename B, typename I, unsigned int F, auto R>
+[[nodiscard]] constexpr inline fixed<B, I, F, R> add_checked(fixed<B, I, F, R> x, fixed<B, I, F, R> y, overflow_flag& flag) noexcept
+{
+    B result;
+    flag.raise(detail::add_overflow<B, I>(x.raw_value(), y.raw_value(), result));
+    return fixed<B, I, F, R>::from_raw_value(result);
+}
+
+template <typename B, typename I, unsigned int F, auto R>
+[[nodiscard]] constexpr inline fixed<B, I, F, R> sub_checked(fixed<B, I, F, R> x, fixed<B, I, F, R> y, overflow_flag& flag) noexcept
+{
+    B result;
+    flag.raise(detail::sub_overflow<B, I>(x.raw_value(), y.raw_value(), result));
+    return fixed<B, I, F, R>::from_raw_value(result);
+}
+
+/// Adds an integer like operator+, and raises \a flag if either the integer doesn't fit or the sum overflows.
+template <typename B, typename I, unsigned int F, auto R, typename T> requires std::is_integral_v<T>
+[[nodiscard]] constexpr inline fixed<B, I, F, R> add_checked(fixed<B, I, F, R> x, T y, overflow_flag& flag) noexcept
+{
+    return add_checked(x, checked_cast<fixed<B, I, F, R>>(y, flag), flag);
+}
+
+template <typename B, typename I, unsigned int F, auto R, typename T> requires std::is_integral_v<T>
+[[nodiscard]] constexpr inline fixed<B, I, F, R> add_checked(T x, fixed<B, I, F, R> y, overflow_flag& flag) noexcept
+{
+    return add_checked(checked_cast<fixed<B, I, F, R>>(x, flag), y, flag);
+}
+
+/// Subtracts an integer like operator-, and raises \a flag if either the integer doesn't fit or the difference overflows.
+template <typename B, typename I, unsigned int F, auto R, typename T> requires std::is_integral_v<T>
+[[nodiscard]] constexpr inline fixed<B, I, F, R> sub_checked(fixed<B, I, F, R> x, T y, overflow_flag& flag) noexcept
+{
+    return sub_checked(x, checked_cast<fixed<B, I, F, R>>(y, flag), flag);
+}
+
+template <typename B, typename I, unsigned int F, auto R, typename T> requires std::is_integral_v<T>
+[[nodiscard]] constexpr inline fixed<B, I, F, R> sub_checked(T x, fixed<B, I, F, R> y, overflow_flag& flag) noexcept
+{
+    return sub_checked(checked_cast<fixed<B, I, F, R>>(x, flag), y, flag);
+}
+
+/// Multiplies like operator*, and raises \a flag if the intermediate result is narrowed.
+template <typename B, typename I, unsigned int F, auto R>
+[[nodiscard]] constexpr inline fixed<B, I, F, R> mul_checked(fixed<B, I, F, R> x, fixed<B, I, F, R> y, overflow_flag& flag) noexcept
+{
+    using Fixed = fixed<B, I, F, R>;
+    const I value = detail::shift_right_with_headroom<Fixed::rounding_mode>(static_cast<I>(x.raw_value()) * y.raw_value(), F);
+    flag.raise(detail::overflows<B>(value));
+    return Fixed::from_raw_value(static_cast<B>(value));
+}
+
+template <typename B, typename I, unsigned int F, auto R, typename T> requires std::is_integral_v<T>
+[[nodiscard]] constexpr inline fixed<B, I, F, R> mul_checked(fixed<B, I, F, R> x, T y, overflow_flag& flag) noexcept
+{
+    B result;
+    flag.raise(detail::mul_overflow<B, I>(x.raw_value(), y, result));
+    return fixed<B, I, F, R>::from_raw_value(result);
+}
+
+/// Divides like operator/, and raises \a flag if the intermediate result is narrowed.
+template <typename B, typename I, unsigned int F, auto R>
+[[nodiscard]] constexpr inline fixed<B, I, F, R> div_checked(fixed<B, I, F, R> x, fixed<B, I, F, R> y, overflow_flag& flag) noexcept
+{
+    using Fixed = fixed<B, I, F, R>;
+    assert(y.raw_value() != 0);
+    const I value = detail::divide<Fixed::rounding_mode>(static_cast<I>(x.raw_value()) * Fixed::FRACTION_MULT, static_cast<I>(y.raw_value()));
+    flag.raise(detail::overflows<B>(value));
+    return Fixed::from_raw_value(static_cast<B>(value));
+}
+
+/// Divides by an integer. Only lowest() / -1 can overflow.
+template <typename B, typename I, unsigned int F, auto R, typename T> requires std::is_integral_v<T>
+[[nodiscard]] constexpr inline fixed<B, I, F, R> div_checked(fixed<B, I, F, R> x, T y, overflow_flag& flag) noexcept
+{
+    assert(y != 0);
+    const I value = static_cast<I>(x.raw_value()) / static_cast<I>(y);
+    flag.raise(detail::overflows<B>(value));
+    return fixed<B, I, F, R>::from_raw_value(static_cast<B>(value));
+}
+
+/// Shifts left by \a y bits, and raises \a flag if any significant bits are shifted out.
+template <typename B, typename I, unsigned int F, auto R, typename T> requires std::is_integral_v<T>
+[[nodiscard]] constexpr inline fixed<B, I, F, R> shl_checked(fixed<B, I, F, R> x, T y, overflow_flag& flag) noexcept
+{
+    assert(y >= 0 && std::cmp_less(y, sizeof(B) * 8));
+    const B value = x.raw_value();
+    flag.raise((value < (std::numeric_limits<B>::lowest() >> y)) | (value > (std::numeric_limits<B>::max() >> y)));
+    return fixed<B, I, F, R>::from_raw_value(static_cast<B>(value << y));
+}
+
+//! Fixed-point number with overflow-checked arithmetic.
+//! Wraps a fixed-point type so that all arithmetic operators raise fpm::thread_overflow_flag() when they overflow.
+//! The results are those of the checked functions, which wrap around on overflow.
+//! \tparam Fixed the fixed-point type that stores the value
+template <typename Fixed> requires is_fixed_v<Fixed>
+struct checked : detail::fixed_wrapper<Fixed>
+{
+    constexpr inline checked() noexcept = default;
+
+    /// Wraps a fixed-point number. This is lossless.
+    constexpr inline checked(Fixed value) noexcept
+        : detail::fixed_wrapper<Fixed>(value)
+    {}
+
+    /// Converts an integral or floating-point number like fpm::checked_cast.
+    template <typename T> requires std::is_arithmetic_v<T>
+    constexpr inline explicit checked(T value) noexcept
+        : detail::fixed_wrapper<Fixed>(apply([value](overflow_flag& flag) { return checked_cast<Fixed>(value, flag); }))
+    {}
+
+    /// Converts another fixed-point number like fpm::checked_cast.
+    template <typename B, typename I, unsigned int F, auto R> requires (!std::is_same_v<fixed<B, I, F, R>, Fixed>)
+    constexpr inline explicit checked(fixed<B, I, F, R> value) noexcept
+        : detail::fixed_wrapper<Fixed>(apply([value](overflow_flag& flag) { return checked_cast<Fixed>(value, flag); }))
+    {}
+
+    constexpr inline checked& operator+=(checked y) noexcept
+    {
+        m_value = apply([this, y](overflow_flag& flag) { return add_checked(m_value, y.m_value, flag); });
+        return *this;
+    }
+
+    constexpr inline checked& operator-=(checked y) noexcept
+    {
+        m_value = apply([this, y](overflow_flag& flag) { return sub_checked(m_value, y.m_value, flag); });
+        return *this;
+    }
+
+    constexpr inline checked& operator*=(checked y) noexcept
+    {
+        m_value = apply([this, y](overflow_flag& flag) { return mul_checked(m_value, y.m_value, flag); });
+        return *this;
+    }
+
+    constexpr inline checked& operator/=(checked y) noexcept
+    {
+        m_value = apply([this, y](overflow_flag& flag) { return div_checked(m_value, y.m_value, flag); });
+        return *this;
+    }
+
+    template <typename T> requires std::is_integral_v<T>
+    constexpr inline checked& operator+=(T y) noexcept
+    {
+        m_value = apply([this, y](overflow_flag& flag) { return add_checked(m_value, y, flag); });
+        return *this;
+    }
+
+    template <typename T> requires std::is_integral_v<T>
+    constexpr inline checked& operator-=(T y) noexcept
+    {
+        m_value = apply([this, y](overflow_flag& flag) { return sub_checked(m_value, y, flag); });
+        return *this;
+    }
+
+    template <typename T> requires std::is_integral_v<T>
+    constexpr inline checked& operator*=(T y) noexcept
+    {
+        m_value = apply([this, y](overflow_flag& flag) { return mul_checked(m_value, y, flag); });
+        return *this;
+    }
+
+    template <typename T> requires std::is_integral_v<T>
+    constexpr inline checked& operator/=(T y) noexcept
+    {
+        m_value = apply([this, y](overflow_flag& flag) { return div_checked(m_value, y, flag); });
+        return *this;
+    }
+
+    template <typename T> requires std::is_integral_v<T>
+    constexpr inline checked& operator<<=(T y) noexcept
+    {
+        m_value = apply([this, y](overflow_flag& flag) { return shl_checked(m_value, y, flag); });
+        return *this;
+    }
+
+    template <typename T> requires std::is_integral_v<T>
+    constexpr inline checked& operator>>=(T y) noexcept
+    {
+        m_value >>= y;
+        return *this;
+    }
+
+    [[nodiscard]] friend constexpr inline checked operator-(checked x) noexcept requires std::is_signed_v<typename Fixed::base_type>
+    {
+        return checked(Fixed(0)) -= x;
+    }
+
+    [[nodiscard]] friend constexpr inline checked operator+(checked x, checked y) noexcept { return x += y; }
+    [[nodiscard]] friend constexpr inline checked operator-(checked x, checked y) noexcept { return x -= y; }
+    [[nodiscard]] friend constexpr inline checked operator*(checked x, checked y) noexcept { return x *= y; }
+    [[nodiscard]] friend constexpr inline checked operator/(checked x, checked y) noexcept { return x /= y; }
+
+    template <typename T> requires std::is_integral_v<T>
+    [[nodiscard]] friend constexpr inline checked operator+(checked x, T y) noexcept { return x += y; }
+
+    template <typename T> requires std::is_integral_v<T>
+    [[nodiscard]] friend constexpr inline checked operator+(T x, checked y) noexcept
+    {
+        return apply([x, y](overflow_flag& flag) { return add_checked(x, y.m_value, flag); });
+    }
+
+    template <typename T> requires std::is_integral_v<T>
+    [[nodiscard]] friend constexpr inline checked operator-(checked x, T y) noexcept { return x -= y; }
+
+    template <typename T> requires std::is_integral_v<T>
+    [[nodiscard]] friend constexpr inline checked operator-(T x, checked y) noexcept
+    {
+        return apply([x, y](overflow_flag& flag) { return sub_checked(x, y.m_value, flag); });
+    }
+
+    template <typename T> requires std::is_integral_v<T>
+    [[nodiscard]] friend constexpr inline checked operator*(checked x, T y) noexcept { return x *= y; }
+
+    template <typename T> requires std::is_integral_v<T>
+    [[nodiscard]] friend constexpr inline checked operator*(T x, checked y) noexcept { return y *= x; }
+
+    template <typename T> requires std::is_integral_v<T>
+    [[nodiscard]] friend constexpr inline checked operator/(checked x, T y) noexcept { return x /= y; }
+
+    template <typename T> requires std::is_integral_v<T>
+    [[nodiscard]] friend constexpr inline checked operator<<(checked x, T y) noexcept { return x <<= y; }
+
+    template <typename T> requires std::is_integral_v<T>
+    [[nodiscard]] friend constexpr inline checked operator>>(checked x, T y) noexcept { return x >>= y; }
+
+    [[nodiscard]] friend constexpr inline bool operator==(checked x, checked y) noexcept
+    {
+        return x.m_value == y.m_value;
+    }
+
+    [[nodiscard]] friend constexpr inline auto operator<=>(checked x, checked y) noexcept
+    {
+        return x.m_value <=> y.m_value;
+    }
+
+private:
+    /// Calls a checked operation with the thread's overflow flag.
+    /// Thread-local storage isn't available in constant expressions, so those use a local flag instead.
+    template <typename Func>
+    [[nodiscard]] static constexpr inline Fixed apply(Func func) noexcept
+    {
+        if (std::is_constant_evaluated()) {
+            overflow_flag flag;
+            return func(flag);
+        }
+        return func(thread_overflow_flag());
+    }
+
+    using detail::fixed_wrapper<Fixed>::m_value;
+};
+
+} // namespace fpm
+
+// Specializations for customization points
+namespace std
+{
+
+template <typename Fixed>
+struct hash<fpm::checked<Fixed>>
+{
+    [[nodiscard]] std::size_t operator()(fpm::checked<Fixed> arg) const noexcept
+    {
+        return std::hash<Fixed>{}(arg.value());
+    }
+};
+
+template <typename Fixed>
+struct numeric_limits<fpm::checked<Fixed>> : numeric_limits<Fixed>
+{
+    static constexpr fpm::checked<Fixed> lowest() noexcept { return numeric_limits<Fixed>::lowest(); }
+    static constexpr fpm::checked<Fixed> min() noexcept { return numeric_limits<Fixed>::min(); }
+    static constexpr fpm::checked<Fixed> max() noexcept { return numeric_limits<Fixed>::max(); }
+    static constexpr fpm::checked<Fixed> epsilon() noexcept { return numeric_limits<Fixed>::epsilon(); }
+    static constexpr fpm::checked<Fixed> round_error() noexcept { return numeric_limits<Fixed>::round_error(); }
+    static constexpr fpm::checked<Fixed> denorm_min() noexcept { return numeric_limits<Fixed>::denorm_min(); }
+};
+
+}
+
+#endif
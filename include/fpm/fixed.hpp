@@ -3,6 +3,7 @@
 
 #include <cassert>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <limits>
@@ -10,17 +11,31 @@
 
 #include "fwd.hpp"
 #include "int128.hpp"
+#include "rounding.hpp"
 
 
 namespace fpm
 {
 
+// Type testing
+template<typename T>
+struct is_fixed : std::false_type {};
+
+template<typename BaseType, typename IntermediateType, unsigned int FractionBits, auto EnableRounding>
+struct is_fixed<fixed<BaseType, IntermediateType, FractionBits, EnableRounding>> : std::true_type {};
+
+#if  __cplusplus >= 201703L /* C++17 */
+template<typename T>
+constexpr inline bool is_fixed_v = is_fixed<T>::value;
+#endif
+
 //! Fixed-point number type
 //! \tparam BaseType         the base integer type used to store the fixed-point number. This can be a signed or unsigned type.
 //! \tparam IntermediateType the integer type used to store intermediate results during calculations.
 //! \tparam FractionBits     the number of bits of the BaseType used to store the fraction
-//! \tparam EnableRounding   enable rounding of LSB for multiplication, division, and type conversion
-template <typename BaseType, typename IntermediateType, unsigned int FractionBits, bool EnableRounding>
+//! \tparam EnableRounding   enable rounding of LSB for multiplication, division, and type conversion.
+//!                          Either a bool, or an fpm::rounding mode.
+template <typename BaseType, typename IntermediateType, unsigned int FractionBits, auto EnableRounding>
 struct fixed
 {
     static_assert(std::is_integral<BaseType>::value, "BaseType must be an integral type");
@@ -35,6 +50,7 @@ struct fixed
     static constexpr decltype(FractionBits) fraction_bits = FractionBits;
     static constexpr decltype(FractionBits) integral_bits = (sizeof(BaseType) * 8) - FractionBits;
     static constexpr decltype(EnableRounding) enable_rounding = EnableRounding;
+    static constexpr rounding rounding_mode = detail::rounding_mode_of(EnableRounding);
 
     /// Although this value fits in the BaseType in terms of bits, if there's only one integral bit, this value
     /// is incorrect (flips from positive to negative), so we must extend the size to IntermediateType.
@@ -58,16 +74,12 @@ public:
     /// Like static_cast, this truncates bits that don't fit.
     template <typename T> requires std::is_floating_point_v<T>
     constexpr inline explicit fixed(T val) noexcept
-        : m_value(
-            static_cast<BaseType>((EnableRounding) ?
-            (val >= 0.0) ? (val * FRACTION_MULT + T{0.5}) : (val * FRACTION_MULT - T{0.5}) :
-            (val * FRACTION_MULT))
-        )
+        : m_value(static_cast<BaseType>(detail::round_scaled<rounding_mode>(val * FRACTION_MULT)))
     {}
 
     /// Constructs from another fixed-point type with possibly different underlying representation.
     /// Like static_cast, this truncates bits that don't fit.
-    template <typename B, typename I, unsigned int F, bool R>
+    template <typename B, typename I, unsigned int F, auto R>
     constexpr inline explicit fixed(fixed<B,I,F,R> val) noexcept
         : m_value(from_fixed_point<F>(val.raw_value()).raw_value())
     {}
@@ -93,7 +105,7 @@ public:
     }
 
     /// Change number of Fraction Bits.
-    template <typename I, unsigned int F, bool R>
+    template <typename I, unsigned int F, auto R>
     [[nodiscard]] constexpr inline explicit operator fixed<BaseType, I, F, R>() const noexcept
     {
         static_assert(F != FractionBits);
@@ -108,7 +120,7 @@ public:
     }
 
     /// Change Base Type.
-    template <typename B, typename I, bool R>
+    template <typename B, typename I, auto R>
     [[nodiscard]] constexpr inline explicit operator fixed<B, I, FractionBits, R>() const noexcept
     {
         static_assert(sizeof(B) != sizeof(BaseType));
@@ -116,7 +128,7 @@ public:
     }
 
     /// Change Base Type and Fraction Bits.
-    template <typename B, typename I, unsigned int F, bool R>
+    template <typename B, typename I, unsigned int F, auto R>
     [[nodiscard]] constexpr inline explicit operator fixed<B, I, F, R>() const noexcept
     {
         static_assert(F != FractionBits);
@@ -133,6 +145,18 @@ public:
         }
     }
 
+    /// Converts to another fixed-point type with a single rounding step, with the rounding mode of Target.
+    /// Unlike static_cast, which may shift and truncate first, this rounds the exact value once.
+    /// Like static_cast, this truncates bits that don't fit.
+    template <typename Target> requires is_fixed_v<Target>
+    [[nodiscard]] constexpr inline Target narrow() const noexcept
+    {
+        // Shift in the wider of the two base types, so that no fraction bits are lost
+        using B = typename Target::base_type;
+        using T = std::conditional_t<(sizeof(B) > sizeof(BaseType)), B, BaseType>;
+        return Target::template from_fixed_point<FractionBits>(static_cast<T>(m_value));
+    }
+
     /// Returns the raw underlying value of this type.
     /// Do not use this unless you know what you're doing.
     [[nodiscard]] constexpr inline BaseType raw_value() const noexcept
@@ -146,14 +170,8 @@ public:
     template <unsigned int NumFractionBits, typename T> requires (NumFractionBits > FractionBits)
     [[nodiscard]] static constexpr inline fixed from_fixed_point(T value) noexcept
     {
-        // To correctly round the last bit in the result, we need one more bit of information.
-        // We do this by multiplying by two before dividing and adding the LSB to the real result.
-        return (EnableRounding) ? fixed(static_cast<BaseType>(
-             value / (T(1) << (NumFractionBits - FractionBits)) +
-            (value / (T(1) << (NumFractionBits - FractionBits - 1)) % 2)),
-            raw_construct_tag{}) :
-            fixed(static_cast<BaseType>(value / (T(1) << (NumFractionBits - FractionBits))),
-             raw_construct_tag{});
+        return fixed(static_cast<BaseType>(detail::shift_right<rounding_mode>(value, NumFractionBits - FractionBits)),
+            raw_construct_tag{});
     }
 
     template <unsigned int NumFractionBits, typename T> requires (NumFractionBits <= FractionBits)
@@ -209,16 +227,9 @@ public:
 
     constexpr inline fixed& operator*=(const fixed& y) noexcept
     {
-        if (EnableRounding){
-            // Normal fixed-point multiplication is: x * y / 2**FractionBits.
-            // To correctly round the last bit in the result, we need one more bit of information.
-            // We do this by multiplying by two before dividing and adding the LSB to the real result.
-            auto value = (static_cast<IntermediateType>(m_value) * y.m_value) / (FRACTION_MULT / 2);
-            m_value = static_cast<BaseType>((value / 2) + (value % 2));
-        } else {
-            auto value = (static_cast<IntermediateType>(m_value) * y.m_value) / FRACTION_MULT;
-            m_value = static_cast<BaseType>(value);
-        }
+        // Normal fixed-point multiplication is: x * y / 2**FractionBits, which is a shift of the product.
+        const auto product = static_cast<IntermediateType>(m_value) * y.m_value;
+        m_value = static_cast<BaseType>(detail::shift_right_with_headroom<rounding_mode>(product, FractionBits));
         return *this;
     }
 
@@ -232,16 +243,30 @@ public:
     constexpr inline fixed& operator/=(const fixed& y) noexcept
     {
         assert(y.m_value != 0);
-        if (EnableRounding){
-            // Normal fixed-point division is: x * 2**FractionBits / y.
-            // To correctly round the last bit in the result, we need one more bit of information.
-            // We do this by multiplying by two before dividing and adding the LSB to the real result.
-            auto value = (static_cast<IntermediateType>(m_value) * FRACTION_MULT * 2) / y.m_value;
-            m_value = static_cast<BaseType>((value / 2) + (value % 2));
-        } else {
-            auto value = (static_cast<IntermediateType>(m_value) * FRACTION_MULT) / y.m_value;
-            m_value = static_cast<BaseType>(value);
+#ifdef FPM_INT128
+        if constexpr (sizeof(BaseType) == 8 && sizeof(IntermediateType) == 16)
+        {
+            // A 128-bit division is a slow library call, but the dividend is a 64-bit number shifted
+            // by FractionBits, so a 128/64-bit division gives the quotient whenever it fits in 64 bits.
+            if (!std::is_constant_evaluated())
+            {
+                const bool negative = std::numeric_limits<BaseType>::is_signed && ((m_value < 0) != (y.m_value < 0));
+                const std::uint64_t dividend = magnitude(m_value), divisor = magnitude(y.m_value);
+                const std::uint64_t high = dividend >> (64 - FractionBits);
+                if (high < divisor)
+                {
+                    std::uint64_t remainder;
+                    std::uint64_t value = detail::narrowing_divide(high, (dividend << (FractionBits - 1)) << 1, divisor, remainder);
+                    value += detail::round_remainder<rounding_mode>(negative, (value & 1) != 0, remainder, divisor) ? 1 : 0;
+                    m_value = static_cast<BaseType>(negative ? 0 - value : value);
+                    return *this;
+                }
+            }
         }
+#endif
+        // Normal fixed-point division is: x * 2**FractionBits / y.
+        const auto dividend = static_cast<IntermediateType>(m_value) * FRACTION_MULT;
+        m_value = static_cast<BaseType>(detail::divide<rounding_mode>(dividend, static_cast<IntermediateType>(y.m_value)));
         return *this;
     }
 
@@ -280,6 +305,13 @@ public:
     }
 
 private:
+    // Returns the absolute value of a 64-bit raw value, which always fits in an unsigned 64-bit integer
+    [[nodiscard]] static constexpr inline std::uint64_t magnitude(BaseType value) noexcept
+    {
+        const auto bits = static_cast<std::uint64_t>(value);
+        return (std::numeric_limits<BaseType>::is_signed && value < 0) ? 0 - bits : bits;
+    }
+
     BaseType m_value;
 };
 
@@ -301,98 +333,79 @@ using fixed_8_56  = fixed<std::int64_t, ::fpm::int128_t, 56>;
 
 // =================================================================================================
 
-template<typename B, typename I, unsigned int F, bool R> requires std::is_signed_v<B>
+template<typename B, typename I, unsigned int F, auto R> requires std::is_signed_v<B>
 [[nodiscard]] constexpr inline fixed<B, I, F, R> operator-(const fixed<B, I, F, R>& x) noexcept
 {
     return fixed<B, I, F, R>::from_raw_value(-x.raw_value());
 }
 
-template <typename B, typename I, unsigned int F, bool R>
+template <typename B, typename I, unsigned int F, auto R>
 [[nodiscard]] constexpr inline fixed<B, I, F, R> operator+(const fixed<B, I, F, R>& x, const fixed<B, I, F, R>& y) noexcept
 {
     return fixed<B, I, F, R>::from_raw_value(x.raw_value() + y.raw_value());
 }
 
-template <typename B, typename I, unsigned int F, bool R, typename T> requires std::is_integral_v<T>
+template <typename B, typename I, unsigned int F, auto R, typename T> requires std::is_integral_v<T>
 [[nodiscard]] constexpr inline fixed<B, I, F, R> operator+(const fixed<B, I, F, R>& x, T y) noexcept
 {
     return x + fixed<B, I, F, R>(y);
 }
 
-template <typename B, typename I, unsigned int F, bool R, typename T> requires std::is_integral_v<T>
+template <typename B, typename I, unsigned int F, auto R, typename T> requires std::is_integral_v<T>
 [[nodiscard]] constexpr inline fixed<B, I, F, R> operator+(T x, const fixed<B, I, F, R>& y) noexcept
 {
     return fixed<B, I, F, R>(x) + y;
 }
 
-template <typename B, typename I, unsigned int F, bool R>
+template <typename B, typename I, unsigned int F, auto R>
 [[nodiscard]] constexpr inline fixed<B, I, F, R> operator-(const fixed<B, I, F, R>& x, const fixed<B, I, F, R>& y) noexcept
 {
     return fixed<B, I, F, R>::from_raw_value(x.raw_value() - y.raw_value());
 }
 
-template <typename B, typename I, unsigned int F, bool R, typename T> requires std::is_integral_v<T>
+template <typename B, typename I, unsigned int F, auto R, typename T> requires std::is_integral_v<T>
 [[nodiscard]] constexpr inline fixed<B, I, F, R> operator-(const fixed<B, I, F, R>& x, T y) noexcept
 {
     return x - fixed<B, I, F, R>(y);
 }
 
-template <typename B, typename I, unsigned int F, bool R, typename T> requires std::is_integral_v<T>
+template <typename B, typename I, unsigned int F, auto R, typename T> requires std::is_integral_v<T>
 [[nodiscard]] constexpr inline fixed<B, I, F, R> operator-(T x, const fixed<B, I, F, R>& y) noexcept
 {
     return fixed<B, I, F, R>(x) - y;
 }
 
-template <typename B, typename I, unsigned int F, bool R>
+template <typename B, typename I, unsigned int F, auto R>
 [[nodiscard]] constexpr inline fixed<B, I, F, R> operator*(const fixed<B, I, F, R>& x, const fixed<B, I, F, R>& y) noexcept
 {
-    if (R){
-        // Normal fixed-point multiplication is: x * y / 2**FractionBits.
-        // To correctly round the last bit in the result, we need one more bit of information.
-        // We do this by multiplying by two before dividing and adding the LSB to the real result.
-        const auto value = (static_cast<I>(x.raw_value()) * y.raw_value()) / (fixed<B, I, F, R>::FRACTION_MULT / 2);
-        return fixed<B, I, F, R>::from_raw_value(static_cast<B>((value / 2) + (value % 2)));
-    } else {
-        const auto value = (static_cast<I>(x.raw_value()) * y.raw_value()) / fixed<B, I, F, R>::FRACTION_MULT;
-        return fixed<B, I, F, R>::from_raw_value(static_cast<B>(value));
-    }
+    return fixed<B, I, F, R>(x) *= y;
 }
 
-template <typename B, typename I, unsigned int F, bool R, typename T> requires std::is_integral_v<T>
+template <typename B, typename I, unsigned int F, auto R, typename T> requires std::is_integral_v<T>
 [[nodiscard]] constexpr inline fixed<B, I, F, R> operator*(const fixed<B, I, F, R>& x, T y) noexcept
 {
     return fixed<B, I, F, R>::from_raw_value(x.raw_value() * y);
 }
 
-template <typename B, typename I, unsigned int F, bool R, typename T> requires std::is_integral_v<T>
+template <typename B, typename I, unsigned int F, auto R, typename T> requires std::is_integral_v<T>
 [[nodiscard]] constexpr inline fixed<B, I, F, R> operator*(T x, const fixed<B, I, F, R>& y) noexcept
 {
     return fixed<B, I, F, R>::from_raw_value(x * y.raw_value());
 }
 
-template <typename B, typename I, unsigned int F, bool R>
+template <typename B, typename I, unsigned int F, auto R>
 [[nodiscard]] constexpr inline fixed<B, I, F, R> operator/(const fixed<B, I, F, R>& x, const fixed<B, I, F, R>& y) noexcept
 {
-    assert(y.raw_value() != 0);
-    if (R){
-        // Normal fixed-point division is: x * 2**FractionBits / y.
-        // To correctly round the last bit in the result, we need one more bit of information.
-        // We do this by multiplying by two before dividing and adding the LSB to the real result.
-        const auto value = (static_cast<I>(x.raw_value()) * fixed<B, I, F, R>::FRACTION_MULT * 2) / y.raw_value();
-        return fixed<B, I, F, R>::from_raw_value(static_cast<B>((value / 2) + (value % 2)));
-    } else {
-        const auto value = (static_cast<I>(x.raw_value()) * fixed<B, I, F, R>::FRACTION_MULT) / y.raw_value();
-        return fixed<B, I, F, R>::from_raw_value(static_cast<B>(value));
-    }
+    return fixed<B, I, F, R>(x) /= y;
 }
 
-template <typename B, typename I, unsigned int F, typename T, bool R> requires std::is_integral_v<T>
+template <typename B, typename I, unsigned int F, typename T, auto R> requires std::is_integral_v<T>
 [[nodiscard]] constexpr inline fixed<B, I, F, R> operator/(const fixed<B, I, F, R>& x, T y) noexcept
 {
     return fixed<B, I, F, R>::from_raw_value(x.raw_value() / y);
 }
 
-template <typename B, typename I, unsigned int F, typename T, bool R> requires std::is_integral_v<T>
+template <typename B, typename I, unsigned int F, typename T, auto R> requires std::is_integral_v<T>
 [[nodiscard]] constexpr inline fixed<B, I, F, R> operator/(T x, const fixed<B, I, F, R>& y) noexcept
 {
     return fixed<B, I, F, R>(x) / y;
@@ -402,19 +415,19 @@ template <typename B, typename I, unsigned int F, typename T, bool R> requires s
 // Modulo
 //
 
-template <typename B, typename I, unsigned int F, bool R>
+template <typename B, typename I, unsigned int F, auto R>
 [[nodiscard]] constexpr inline fixed<B, I, F, R> operator%(const fixed<B, I, F, R>& x, const fixed<B, I, F, R>& y) noexcept
 {
     return fixed<B, I, F, R>(x) %= y;
 }
 
-template <typename B, typename I, unsigned int F, typename T, bool R> requires std::is_integral_v<T>
+template <typename B, typename I, unsigned int F, typename T, auto R> requires std::is_integral_v<T>
 [[nodiscard]] constexpr inline fixed<B, I, F, R> operator%(const fixed<B, I, F, R>& x, T y) noexcept
 {
     return fixed<B, I, F, R>(x) %= y;
 }
 
-template <typename B, typename I, unsigned int F, typename T, bool R> requires std::is_integral_v<T>
+template <typename B, typename I, unsigned int F, typename T, auto R> requires std::is_integral_v<T>
 [[nodiscard]] constexpr inline fixed<B, I, F, R> operator%(T x, const fixed<B, I, F, R>& y) noexcept
 {
     return fixed<B, I, F, R>(x) %= y;
@@ -424,13 +437,13 @@ template <typename B, typename I, unsigned int F, typename T, bool R> requires s
 // Bit-shift
 //
 
-template <typename B, typename I, unsigned int F, typename T, bool R> requires std::is_integral_v<T>
+template <typename B, typename I, unsigned int F, typename T, auto R> requires std::is_integral_v<T>
 [[nodiscard]] constexpr inline fixed<B, I, F, R> operator>>(const fixed<B, I, F, R>& x, T y) noexcept
 {
     return fixed<B, I, F, R>(x) >>= y;
 }
 
-template <typename B, typename I, unsigned int F, typename T, bool R> requires std::is_integral_v<T>
+template <typename B, typename I, unsigned int F, typename T, auto R> requires std::is_integral_v<T>
 [[nodiscard]] constexpr inline fixed<B, I, F, R> operator<<(const fixed<B, I, F, R>& x, T y) noexcept
 {
     return fixed<B, I, F, R>(x) <<= y;
@@ -440,19 +453,19 @@ template <typename B, typename I, unsigned int F, typename T, bool R> requires s
 // Comparison operators
 //
 
-template <typename B, typename I, unsigned int F, bool R>
+template <typename B, typename I, unsigned int F, auto R>
 [[nodiscard]] constexpr inline bool operator==(const fixed<B, I, F, R>& x, const fixed<B, I, F, R>& y) noexcept
 {
     return x.raw_value() == y.raw_value();
 }
 
-template <typename B, typename I, unsigned int F, typename T, bool R> requires std::is_integral_v<T>
+template <typename B, typename I, unsigned int F, typename T, auto R> requires std::is_integral_v<T>
 [[nodiscard]] constexpr inline bool operator==(const fixed<B, I, F, R>& x, const T y) noexcept
 {
     return x == fixed<B, I, F, R>{y};
 }
 
-template <typename B, typename I, unsigned int F, typename T, bool R> requires std::is_integral_v<T>
+template <typename B, typename I, unsigned int F, typename T, auto R> requires std::is_integral_v<T>
 [[nodiscard]] constexpr inline bool operator==(const T x, const fixed<B, I, F, R>& y) noexcept
 {
     return fixed<B, I, F, R>{x} == y;
@@ -460,7 +473,7 @@ template <typename B, typename I, unsigned int F, typename T, bool R> requires s
 
 #if __cplusplus >= 202002L /* C++20 */
 
-template <typename B, typename I, unsigned int F, bool R>
+template <typename B, typename I, unsigned int F, auto R>
 [[nodiscard]] constexpr inline auto operator<=>(const fixed<B, I, F, R>& x, const fixed<B, I, F, R>& y) noexcept
 {
     return x.raw_value() <=> y.raw_value();
@@ -468,31 +481,31 @@ template <typename B, typename I, unsigned int F, bool R>
 
 #else
 
-template <typename B, typename I, unsigned int F, bool R>
+template <typename B, typename I, unsigned int F, auto R>
 [[nodiscard]] constexpr inline bool operator!=(const fixed<B, I, F, R>& x, const fixed<B, I, F, R>& y) noexcept
 {
     return x.raw_value() != y.raw_value();
 }
 
-template <typename B, typename I, unsigned int F, bool R>
+template <typename B, typename I, unsigned int F, auto R>
 [[nodiscard]] constexpr inline bool operator<(const fixed<B, I, F, R>& x, const fixed<B, I, F, R>& y) noexcept
 {
     return x.raw_value() < y.raw_value();
 }
 
-template <typename B, typename I, unsigned int F, bool R>
+template <typename B, typename I, unsigned int F, auto R>
 [[nodiscard]] constexpr inline bool operator>(const fixed<B, I, F, R>& x, const fixed<B, I, F, R>& y) noexcept
 {
     return x.raw_value() > y.raw_value();
 }
 
-template <typename B, typename I, unsigned int F, bool R>
+template <typename B, typename I, unsigned int F, auto R>
 [[nodiscard]] constexpr inline bool operator<=(const fixed<B, I, F, R>& x, const fixed<B, I, F, R>& y) noexcept
 {
     return x.raw_value() <= y.raw_value();
 }
 
-template <typename B, typename I, unsigned int F, bool R>
+template <typename B, typename I, unsigned int F, auto R>
 [[nodiscard]] constexpr inline bool operator>=(const fixed<B, I, F, R>& x, const fixed<B, I, F, R>& y) noexcept
 {
     return x.raw_value() >= y.raw_value();
@@ -500,6 +513,41 @@ template <typename B, typename I, unsigned int F, bool R>
 
 #endif
 
+namespace detail
+{
+//! The integer type with Size bytes and the given signedness, if there is one
+template <std::size_t Size, bool Signed> struct sized_integer {};
+template <> struct sized_integer<2, true> { using type = std::int16_t; };
+template <> struct sized_integer<2, false> { using type = std::uint16_t; };
+template <> struct sized_integer<4, true> { using type = std::int32_t; };
+template <> struct sized_integer<4, false> { using type = std::uint32_t; };
+template <> struct sized_integer<8, true> { using type = std::int64_t; };
+template <> struct sized_integer<8, false> { using type = std::uint64_t; };
+#ifdef FPM_INT128
+template <> struct sized_integer<16, true> { using type = ::fpm::int128_t; };
+template <> struct sized_integer<16, false> { using type = ::fpm::uint128_t; };
+#endif
+
+//! The integer type with twice the bits of T
+template <typename T>
+using widened_t = typename sized_integer<sizeof(T) * 2, std::numeric_limits<T>::is_signed>::type;
+
+} // namespace detail
+
+//! Returns the exact product of two fixed-point numbers, which can have different formats.
+//! The product has the fraction bits of both, and is stored in the wider of their intermediate types,
+//! which always holds it. Use narrow() to round it to the format that's needed, once.
+//! The rounding mode of the product is that of x.
+//! This requires an integer type twice as wide as the intermediate type, so not 64-bit base types.
+template <typename B1, typename I1, unsigned int F1, auto R1, typename B2, typename I2, unsigned int F2, auto R2>
+    requires (std::numeric_limits<B1>::is_signed == std::numeric_limits<B2>::is_signed)
+[[nodiscard]] constexpr inline auto mul_wide(const fixed<B1, I1, F1, R1>& x, const fixed<B2, I2, F2, R2>& y) noexcept
+{
+    using B = std::conditional_t<(sizeof(I1) >= sizeof(I2)), I1, I2>;
+    using Product = fixed<B, detail::widened_t<B>, F1 + F2, R1>;
+    return Product::from_raw_value(static_cast<B>(x.raw_value()) * static_cast<B>(y.raw_value()));
+}
+
 namespace detail
 {
 /// Number of base-10 digits required to fully represent a number of bits.
@@ -525,7 +573,7 @@ namespace detail
 namespace std
 {
 
-template <typename B, typename I, unsigned int F, bool R>
+template <typename B, typename I, unsigned int F, auto R>
 struct hash<fpm::fixed<B,I,F,R>>
 {
     using argument_type = fpm::fixed<B, I, F, R>;
@@ -536,7 +584,7 @@ struct hash<fpm::fixed<B,I,F,R>>
     }
 };
 
-template <typename B, typename I, unsigned int F, bool R>
+template <typename B, typename I, unsigned int F, auto R>
 struct numeric_limits<fpm::fixed<B,I,F,R>>
 {
     static constexpr bool is_specialized = true;
@@ -548,7 +596,7 @@ struct numeric_limits<fpm::fixed<B,I,F,R>>
     static constexpr bool has_signaling_NaN = false;
     // static constexpr std::float_denorm_style has_denorm = std::denorm_absent;
     static constexpr bool has_denorm_loss = false;
-    static constexpr std::float_round_style round_style = std::round_to_nearest;
+    static constexpr std::float_round_style round_style = fpm::detail::round_style_of(fpm::fixed<B,I,F,R>::rounding_mode);
     static constexpr bool is_iec559 = false;
     static constexpr bool is_bounded = true;
     static constexpr bool is_modulo = std::numeric_limits<B>::is_modulo;
@@ -588,8 +636,10 @@ struct numeric_limits<fpm::fixed<B,I,F,R>>
         return fpm::fixed<B,I,F,R>::from_raw_value(1);
     }
 
+    // Half an ulp when rounding to nearest, a whole ulp for the directed and stochastic modes
     static constexpr fpm::fixed<B,I,F,R> round_error() noexcept {
-        return fpm::fixed<B,I,F,R>(1) / 2;
+        return fpm::detail::rounds_to_nearest(fpm::fixed<B,I,F,R>::rounding_mode)
+            ? fpm::fixed<B,I,F,R>(1) / 2 : fpm::fixed<B,I,F,R>(1);
     }
 
     static constexpr fpm::fixed<B,I,F,R> denorm_min() noexcept {
@@ -597,20 +647,5 @@ struct numeric_limits<fpm::fixed<B,I,F,R>>
     }
 };
 
-}
-
-// Type testing
-namespace fpm
-{
-template<typename T>
-struct is_fixed : std::false_type {};
-
-template<typename BaseType, typename IntermediateType, unsigned int FractionBits, bool EnableRounding>
-struct is_fixed<fixed<BaseType, IntermediateType, FractionBits, EnableRounding>> : std::true_type {};
-
-#if  __cplusplus >= 201703L /* C++17 */
-template<typename T>
-constexpr inline bool is_fixed_v = is_fixed<T>::value;
-#endif
 }
 #endif
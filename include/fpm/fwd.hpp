@@ -5,7 +5,7 @@ namespace fpm {
 
 // -------------------------------------------------------------------------------------------------
 
-template <typename BaseType, typename IntermediateType, unsigned int FractionBits, bool EnableRounding = true>
+template <typename BaseType, typename IntermediateType, unsigned int FractionBits, auto EnableRounding = true>
 struct fixed;
 
 // -------------------------------------------------------------------------------------------------
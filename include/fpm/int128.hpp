@@ -3,6 +3,10 @@
 #include <cstdint>
 #include <limits>
 
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
 
 // -------------------------------------------------------------------------------------------------
 
@@ -32,6 +36,27 @@ static_assert(sizeof(int128_t) == 16);
 static_assert(sizeof(uint128_t) == 16);
 static_assert(std::numeric_limits<int128_t>::is_signed);
 static_assert(!std::numeric_limits<uint128_t>::is_signed);
+
+namespace detail {
+
+// Divides the 128-bit number (high, low) by divisor. The quotient must fit in 64 bits (high < divisor).
+// This is a single instruction on x86-64, where the generic 128-bit division is a library call.
+[[nodiscard]] inline std::uint64_t narrowing_divide(std::uint64_t high, std::uint64_t low, std::uint64_t divisor, std::uint64_t& remainder) noexcept
+{
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    std::uint64_t quotient;
+    __asm__("divq %[divisor]" : "=a"(quotient), "=d"(remainder) : [divisor] "rm"(divisor), "a"(low), "d"(high));
+    return quotient;
+#elif defined(_MSC_VER) && defined(_M_X64)
+    return _udiv128(high, low, divisor, &remainder);
+#else
+    const uint128_t dividend = (static_cast<uint128_t>(high) << 64) | low;
+    remainder = static_cast<std::uint64_t>(dividend % divisor);
+    return static_cast<std::uint64_t>(dividend / divisor);
+#endif
+}
+
+} // namespace detail
 #endif
 
 } // namespace fpm ---------------------------------------------------------------------------------
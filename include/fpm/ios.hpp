@@ -5,8 +5,10 @@
 #include "math.hpp"
 #include <array>
 #include <algorithm>
+#include <bit>
 #include <cctype>
 #include <climits>
+#include <cstddef>
 #include <limits>
 #include <ios>
 #include <vector>
@@ -14,44 +16,103 @@
 namespace fpm
 {
 
-template <typename CharT, typename B, typename I, unsigned int F, bool R>
-std::basic_ostream<CharT>& operator<<(std::basic_ostream<CharT>& os, fixed<B, I, F, R> x) noexcept
+namespace detail
 {
-    const auto uppercase = ((os.flags() & std::ios_base::uppercase) != 0);
-    const auto showpoint = ((os.flags() & std::ios_base::showpoint) != 0);
-    const auto adjustfield = (os.flags() & std::ios_base::adjustfield);
-    const auto width = os.width();
-    const auto& ctype = std::use_facet<std::ctype<CharT>>(os.getloc());
-    const auto& numpunct = std::use_facet<std::numpunct<CharT>>(os.getloc());
 
-    auto floatfield = (os.flags() & std::ios_base::floatfield);
-    auto precision = os.precision();
-    auto show_trailing_zeros = true;
-    auto use_significant_digits = false;
+/// Notation used to convert a fixed-point number to text.
+enum class float_format
+{
+    general,    ///< Fixed or scientific notation, whichever is more compact (%g)
+    fixed,      ///< Fixed notation (%f)
+    scientific, ///< Decimal scientific notation (%e)
+    hex,        ///< Hexadecimal scientific notation (%a)
+};
 
-    // Invalid precision? Reset to the default
-    if (precision < 0)
+/// Locale-independent options to convert a fixed-point number to text.
+struct format_spec
+{
+    float_format format = float_format::general;
+    int precision = 6;
+    bool uppercase = false;
+    bool showpoint = false;
+    bool showpos = false;
+};
+
+/// Locale-independent text representation of a fixed-point number.
+///
+/// The decimal point is always written as '.' and no thousands grouping is applied.
+/// Large precisions can require more zeros than fit in the buffer, so trailing zeros are
+/// not written but tracked as a range that must be inserted at `trailing_zeros_start`.
+template <typename B, unsigned int F>
+struct formatted_number
+{
+    static constexpr std::ptrdiff_t npos = -1;
+
+    // Prefixes and separators (i.e. "+"/"-", "0x", decimal point and "e+/-"), the integral
+    // digits (plus one for a carry), the fractional digits, which can't exceed the number of
+    // fraction bits plus the integral digits that were shifted into it for scientific notation,
+    // the leading zeros of small numbers in general notation and at most three exponent digits.
+    static constexpr std::size_t capacity =
+        6 + (std::numeric_limits<B>::digits10 + 2) + F + 4 + 3;
+
+    std::array<char, capacity> buffer{};
+    std::ptrdiff_t size = 0;                    ///< Number of characters in the buffer
+    std::ptrdiff_t internal_pad = 0;            ///< Start of internal padding (after the sign and "0x")
+    std::ptrdiff_t digits_start = 0;            ///< Start of the integral digits
+    std::ptrdiff_t point = npos;                ///< Location of the decimal point, if any
+    std::ptrdiff_t trailing_zeros_start = npos; ///< Location of the trailing zeros, if any
+    std::ptrdiff_t trailing_zeros_count = 0;    ///< Number of trailing zeros to insert
+
+    /// Total number of characters in the representation, including the trailing zeros.
+    [[nodiscard]] constexpr std::ptrdiff_t length() const noexcept
     {
-        precision = 6;
+        return size + trailing_zeros_count;
     }
 
-    // Output buffer. Needs to be big enough for the formatted number without padding.
-    // Optional prefixes (i.e. "+"/"-", decimal separator, exponent "e+/-" and/or "0x").
-    constexpr auto worst_case_constant_size = 6;
-    // Maximum number of digits from the base type (covers integral + fractional digits)
-    constexpr auto worst_case_digit_count = std::numeric_limits<B>::digits10 + 2;
-    // Exponent suffixes (i.e. maximum digits based on log of the base type size).
-    // Needs a log10, but that isn't constexpr, so we're over-allocating on the stack. Can't hurt.
-    constexpr auto worst_case_suffix_size = std::numeric_limits<B>::digits;
-    // Double the digit count: in the worst case the thousands grouping add a character per digit.
-    using buffer_t = std::array<CharT, worst_case_constant_size + worst_case_digit_count * 2 + worst_case_suffix_size>;
-    buffer_t buffer;
+    /// Writes the characters in [begin, end) to `out`, including trailing zeros in that range.
+    template <typename OutputIt>
+    constexpr OutputIt copy(std::ptrdiff_t begin, std::ptrdiff_t end, OutputIt out) const
+    {
+        assert(begin >= 0 && begin <= end && end <= size);
+        if (trailing_zeros_start >= begin && trailing_zeros_start <= end) {
+            out = std::copy(buffer.begin() + begin, buffer.begin() + trailing_zeros_start, out);
+            out = std::fill_n(out, trailing_zeros_count, '0');
+            return std::copy(buffer.begin() + trailing_zeros_start, buffer.begin() + end, out);
+        }
+        return std::copy(buffer.begin() + begin, buffer.begin() + end, out);
+    }
+
+    /// Writes the entire representation to `out`.
+    template <typename OutputIt>
+    constexpr OutputIt copy(OutputIt out) const
+    {
+        return copy(0, size, out);
+    }
+};
+
+/// Converts a fixed-point number to text without using streams, locales or allocations.
+///
+/// The output matches that of `std::printf` with the equivalent flags, except that hexadecimal
+/// notation always prints all significant nibbles and has a "0x" prefix, like `std::hexfloat`.
+template <typename B, typename I, unsigned int F, auto R>
+[[nodiscard]] constexpr formatted_number<B, F> format_fixed(fixed<B, I, F, R> x, format_spec spec) noexcept
+{
+    formatted_number<B, F> result;
+    auto& buffer = result.buffer;
+    constexpr auto npos = formatted_number<B, F>::npos;
+
+    auto format = spec.format;
+    auto show_trailing_zeros = true;
+    auto use_significant_digits = false;
+
+    // Invalid precision? Reset to the default
+    std::ptrdiff_t precision = (spec.precision < 0) ? 6 : spec.precision;
 
     // Output cursor
-    auto end = buffer.begin();
+    std::ptrdiff_t end = 0;
 
     // Keep track of the start of "internal" padding
-    typename buffer_t::iterator internal_pad = buffer.end();
+    std::ptrdiff_t internal_pad = npos;
 
     // Representation of a number.
     // The value of the number is: raw / divisor * (10|2) ^ exponent
@@ -87,24 +148,24 @@ std::basic_ostream<CharT>& operator<<(std::basic_ostream<CharT>& os, fixed<B, I,
     // First write the sign
     if (value.raw < 0)
     {
-        *end++ = ctype.widen('-');
+        buffer[end++] = '-';
         value.raw = -value.raw;
         internal_pad = end;
     }
-    else if (os.flags() & std::ios_base::showpos)
+    else if (spec.showpos)
     {
-        *end++ = ctype.widen('+');
+        buffer[end++] = '+';
         internal_pad = end;
     }
     assert(value.raw >= 0);
 
-    switch (floatfield)
+    switch (format)
     {
-    case std::ios_base::fixed | std::ios_base::scientific:
+    case float_format::hex:
         // Hexadecimal mode: figure out the hexadecimal exponent and write "0x"
         if (value.raw > 0)
         {
-            auto bit  = detail::find_highest_bit(value.raw);
+            const int bit = std::bit_width(static_cast<unsigned long long>(value.raw)) - 1;
             value.exponent = bit - F;    // exponent is applied to base 2
             value.divisor = I{1} << bit; // divisor is at the highest bit, ensuring it starts with "1."
             precision = (bit + 3) / 4;   // precision is number of nibbles, so we show all of them
@@ -112,37 +173,37 @@ std::basic_ostream<CharT>& operator<<(std::basic_ostream<CharT>& os, fixed<B, I,
         base = 16;
         show_trailing_zeros = false; // Always strip trailing zeros in hexfloat mode
 
-        *end++ = ctype.widen('0');
-        *end++ = ctype.widen(uppercase ? 'X' : 'x');
+        buffer[end++] = '0';
+        buffer[end++] = spec.uppercase ? 'X' : 'x';
         break;
 
-    case std::ios_base::scientific:
+    case float_format::scientific:
         // Scientific mode, normalize value to scientific notation
         value = as_scientific(value);
         break;
 
-    case std::ios_base::fixed:
+    case float_format::fixed:
         // Fixed mode. Nothing to do.
         break;
 
-    default:
+    case float_format::general:
     {
         // "auto" mode: figure out the exponent
         const number_t sci_value = as_scientific(value);
 
         // Now `precision` indicates the number of *significant digits* (not fractional digits).
         use_significant_digits = true;
-        precision = std::max<std::streamsize>(precision, 1);
+        precision = std::max<std::ptrdiff_t>(precision, 1);
 
         if (sci_value.exponent >= precision || sci_value.exponent < -4) {
             // Display as scientific format
-            floatfield = std::ios_base::scientific;
+            format = float_format::scientific;
             value = sci_value;
         } else {
             // Display as fixed format.
             // "showpoint" indicates whether or not we show trailing zeros
-            floatfield = std::ios_base::fixed;
-            show_trailing_zeros = showpoint;
+            format = float_format::fixed;
+            show_trailing_zeros = spec.showpoint;
         }
         break;
     }
@@ -150,7 +211,7 @@ std::basic_ostream<CharT>& operator<<(std::basic_ostream<CharT>& os, fixed<B, I,
 
     // If we didn't write a sign, any internal padding starts here
     // (after a potential "0x" for hexfloats).
-    if (internal_pad == buffer.end()) {
+    if (internal_pad == npos) {
         internal_pad = end;
     }
 
@@ -159,7 +220,7 @@ std::basic_ostream<CharT>& operator<<(std::basic_ostream<CharT>& os, fixed<B, I,
     value.raw %= value.divisor;
 
     // Here we start printing the number itself
-    const char* const digits = uppercase ? "0123456789ABCDEF" : "0123456789abcdef";
+    const char* const digits = spec.uppercase ? "0123456789ABCDEF" : "0123456789abcdef";
     const auto digits_start = end;
 
     // Are we already printing significant digits? (yes if we're not counting significant digits)
@@ -168,7 +229,7 @@ std::basic_ostream<CharT>& operator<<(std::basic_ostream<CharT>& os, fixed<B, I,
     // Print the integral part
     int last_digit = 0;
     if (integral == 0) {
-        *end++ = ctype.widen('0');
+        buffer[end++] = '0';
         if (value.raw == 0) {
             // If the fraction is zero too, all zeros including the integral count
             // as significant digits.
@@ -176,11 +237,11 @@ std::basic_ostream<CharT>& operator<<(std::basic_ostream<CharT>& os, fixed<B, I,
         }
     } else {
         while (integral > 0) {
-            last_digit = integral % base;
-            *end++ = ctype.widen(digits[last_digit]);
+            last_digit = static_cast<int>(integral % base);
+            buffer[end++] = digits[last_digit];
             integral /= base;
         }
-        std::reverse(digits_start, end);
+        std::reverse(buffer.begin() + digits_start, buffer.begin() + end);
         significant_digits = true;
     }
 
@@ -197,20 +258,20 @@ std::basic_ostream<CharT>& operator<<(std::basic_ostream<CharT>& os, fixed<B, I,
     assert(precision >= 0);
 
     // Location of decimal point
-    typename buffer_t::iterator point = buffer.end();
+    std::ptrdiff_t point = npos;
 
     // Start (and length) of the trailing zeros to insert while printing
     // By tracking this to print them later instead of actually printing them now,
     // we can support large precisions with a small printing buffer.
-    typename buffer_t::iterator trailing_zeros_start = buffer.end();
-    std::streamsize trailing_zeros_count = 0;
+    std::ptrdiff_t trailing_zeros_start = npos;
+    std::ptrdiff_t trailing_zeros_count = 0;
 
     if (precision > 0)
     {
         // Print the fractional part
-        *(point = end++) = numpunct.decimal_point();
+        buffer[point = end++] = '.';
 
-        for (int i = 0; i < precision; ++i)
+        for (std::ptrdiff_t i = 0; i < precision; ++i)
         {
             if (value.raw == 0)
             {
@@ -229,9 +290,9 @@ std::basic_ostream<CharT>& operator<<(std::basic_ostream<CharT>& os, fixed<B, I,
             }
             assert(value.divisor > 0);
             assert(value.raw >= 0);
-            last_digit = (value.raw / value.divisor) % base;
+            last_digit = static_cast<int>((value.raw / value.divisor) % base);
             value.raw %= value.divisor;
-            *end++ = ctype.widen(digits[last_digit]);
+            buffer[end++] = digits[last_digit];
 
             if (!significant_digits) {
                 // We're still finding the first significant digit
@@ -245,32 +306,33 @@ std::basic_ostream<CharT>& operator<<(std::basic_ostream<CharT>& os, fixed<B, I,
             }
         }
     }
-    else if (showpoint)
+    else if (spec.showpoint)
     {
         // No fractional part to print, but we still want the point
-        *(point = end++) = numpunct.decimal_point();
+        buffer[point = end++] = '.';
     }
 
     // Insert `ch` into the output at `position`, updating all references accordingly
-    const auto insert_character = [&](typename buffer_t::iterator position, const CharT ch) {
-        assert(position >= buffer.begin() && position < end);
-        std::move_backward(position, end, end + 1);
-        if (point != buffer.end() && position < point) {
+    const auto insert_character = [&](std::ptrdiff_t position, const char ch) {
+        assert(position >= 0 && position < end);
+        std::move_backward(buffer.begin() + position, buffer.begin() + end, buffer.begin() + end + 1);
+        if (point != npos && position < point) {
             ++point;
         }
-        if (trailing_zeros_start != buffer.end() && position < trailing_zeros_start) {
+        if (trailing_zeros_start != npos && position < trailing_zeros_start) {
             ++trailing_zeros_start;
         }
         ++end;
-        *position = ch;
+        buffer[position] = ch;
     };
 
-    // Round the number: round to nearest
+    // Round the number: round to nearest.
+    // Compare against twice the remainder, since the divisor can be 1 in hexfloat mode.
     bool increment = false;
-    if (value.raw > value.divisor / 2) {
+    if (value.raw * 2 > value.divisor) {
         // Round up
         increment = true;
-    } else if (value.raw == value.divisor / 2) {
+    } else if (value.raw * 2 == value.divisor) {
         // It's a tie (i.e. "xyzw.5"): round to even
         increment = ((last_digit % 2) == 1);
     }
@@ -284,26 +346,26 @@ std::basic_ostream<CharT>& operator<<(std::basic_ostream<CharT>& os, fixed<B, I,
                 // Skip over the decimal point
                 --p;
             }
-            if ((*p)++ != ctype.widen('9')) {
+            if (buffer[p]++ != '9') {
                 break;
             }
-            *p-- = ctype.widen('0');
+            buffer[p--] = '0';
         }
 
         if (p < digits_start) {
             // We've incremented all the way to the start (all 9's), we need to insert the
             // carried-over 1 from incrementing the last 9.
             assert(p == digits_start - 1);
-            insert_character(++p, ctype.widen('1'));
+            insert_character(++p, '1');
 
-            if (floatfield == std::ios::scientific)
+            if (format == float_format::scientific)
             {
                 // We just made the integral part equal to 10, so we shift the decimal point
                 // back one place (if any) and tweak the exponent, so that we keep the integer part
                 // less than 10.
-                if (point != buffer.end()) {
+                if (point != npos) {
                     assert(p + 2 == point);
-                    std::swap(*(point - 1), *point);
+                    std::swap(buffer[point - 1], buffer[point]);
                     --point;
                 }
                 ++value.exponent;
@@ -314,85 +376,153 @@ std::basic_ostream<CharT>& operator<<(std::basic_ostream<CharT>& os, fixed<B, I,
             }
         }
 
-        if (use_significant_digits && *p == ctype.widen('1') && point != buffer.end()) {
+        if (use_significant_digits && buffer[p] == '1' && point != npos) {
             // We've converted a leading zero to a 1 so we need to strip the last digit
             // (behind the decimal point) to maintain the same significant digit count.
             --end;
         }
     }
 
-    if (point != buffer.end())
+    if (point != npos)
     {
         if (!show_trailing_zeros)
         {
             // Remove trailing zeros
-            while (*(end - 1) == ctype.widen('0')) {
+            while (buffer[end - 1] == '0') {
                 --end;
             }
 
             // Also clear the "trailing zeros to append during printing" range
-            trailing_zeros_start = buffer.end();
+            trailing_zeros_start = npos;
             trailing_zeros_count = 0;
         }
 
-        if (end - 1 == point && trailing_zeros_count == 0 && !showpoint) {
+        if (end - 1 == point && trailing_zeros_count == 0 && !spec.showpoint) {
             // Remove the decimal point, too
             --end;
-        }
-    }
-
-    // Apply thousands grouping
-    const auto& grouping = numpunct.grouping();
-    if (!grouping.empty())
-    {
-        // Step backwards from the end or decimal point, inserting the
-        // thousands separator at every group interval.
-        const CharT thousands_sep = ctype.widen(numpunct.thousands_sep());
-        std::size_t group = 0;
-        auto p = point != buffer.end() ? point : end;
-        auto size = static_cast<int>(grouping[group]);
-        while (size > 0 && size < CHAR_MAX && p - digits_start > size) {
-            p -= size;
-            insert_character(p, thousands_sep);
-            if (group < grouping.size() - 1) {
-                size = static_cast<int>(grouping[++group]);
-            }
+            point = npos;
         }
     }
 
     // Print the exponent if required
-    assert(floatfield != 0);
-    if (floatfield & std::ios_base::scientific)
+    if (format == float_format::scientific || format == float_format::hex)
     {
         // Hexadecimal (%a/%A) or decimal (%e/%E) scientific notation
-        if (floatfield & std::ios_base::fixed) {
-            *end++ = ctype.widen(uppercase ? 'P' : 'p');
+        if (format == float_format::hex) {
+            buffer[end++] = spec.uppercase ? 'P' : 'p';
         } else {
-            *end++ = ctype.widen(uppercase ? 'E' : 'e');
+            buffer[end++] = spec.uppercase ? 'E' : 'e';
         }
 
         if (value.exponent < 0) {
-            *end++ = ctype.widen('-');
+            buffer[end++] = '-';
             value.exponent = -value.exponent;
         } else {
-            *end++ = ctype.widen('+');
+            buffer[end++] = '+';
         }
 
-        if (floatfield == std::ios_base::scientific) {
+        if (format == float_format::scientific) {
             // In decimal scientific notation (%e/%E), the exponent is at least two digits
             if (value.exponent < 10) {
-                *end++ = ctype.widen('0');
+                buffer[end++] = '0';
             }
         }
 
         const auto exponent_start = end;
         if (value.exponent == 0) {
-            *end++ = ctype.widen('0');
+            buffer[end++] = '0';
         } else while (value.exponent > 0) {
-            *end++ = ctype.widen(digits[value.exponent % 10]);
+            buffer[end++] = digits[value.exponent % 10];
             value.exponent /= 10;
         }
-        std::reverse(exponent_start, end);
+        std::reverse(buffer.begin() + exponent_start, buffer.begin() + end);
+    }
+
+    result.size = end;
+    result.internal_pad = internal_pad;
+    result.digits_start = digits_start;
+    result.point = point;
+    result.trailing_zeros_start = trailing_zeros_start;
+    result.trailing_zeros_count = trailing_zeros_count;
+    return result;
+}
+
+} // namespace detail
+
+template <typename CharT, typename B, typename I, unsigned int F, auto R>
+std::basic_ostream<CharT>& operator<<(std::basic_ostream<CharT>& os, fixed<B, I, F, R> x) noexcept
+{
+    const auto adjustfield = (os.flags() & std::ios_base::adjustfield);
+    const auto width = os.width();
+    const auto& ctype = std::use_facet<std::ctype<CharT>>(os.getloc());
+    const auto& numpunct = std::use_facet<std::numpunct<CharT>>(os.getloc());
+
+    detail::format_spec spec;
+    spec.uppercase = ((os.flags() & std::ios_base::uppercase) != 0);
+    spec.showpoint = ((os.flags() & std::ios_base::showpoint) != 0);
+    spec.showpos = ((os.flags() & std::ios_base::showpos) != 0);
+    spec.precision = static_cast<int>(std::min<std::streamsize>(os.precision(), std::numeric_limits<int>::max()));
+    switch (os.flags() & std::ios_base::floatfield)
+    {
+    case std::ios_base::fixed | std::ios_base::scientific: spec.format = detail::float_format::hex; break;
+    case std::ios_base::scientific: spec.format = detail::float_format::scientific; break;
+    case std::ios_base::fixed: spec.format = detail::float_format::fixed; break;
+    default: spec.format = detail::float_format::general; break;
+    }
+
+    // Generate the locale-independent representation
+    const auto number = detail::format_fixed(x, spec);
+    constexpr auto npos = detail::formatted_number<B, F>::npos;
+
+    // Output buffer. Needs to be big enough for the formatted number without padding.
+    // Double the digit count: in the worst case the thousands grouping add a character per digit.
+    using buffer_t = std::array<CharT, detail::formatted_number<B, F>::capacity * 2>;
+    buffer_t buffer;
+
+    // Widen the representation and apply the locale's decimal point
+    auto end = std::transform(number.buffer.begin(), number.buffer.begin() + number.size, buffer.begin(),
+        [&](const char ch) { return (ch == '.') ? numpunct.decimal_point() : ctype.widen(ch); });
+
+    const auto internal_pad = buffer.begin() + number.internal_pad;
+    const auto digits_start = buffer.begin() + number.digits_start;
+    auto point = (number.point != npos) ? buffer.begin() + number.point : buffer.end();
+    auto trailing_zeros_start = (number.trailing_zeros_start != npos) ? buffer.begin() + number.trailing_zeros_start : buffer.end();
+    const std::streamsize trailing_zeros_count = number.trailing_zeros_count;
+
+    // Insert `ch` into the output at `position`, updating all references accordingly
+    const auto insert_character = [&](typename buffer_t::iterator position, const CharT ch) {
+        assert(position >= buffer.begin() && position < end);
+        std::move_backward(position, end, end + 1);
+        if (point != buffer.end() && position < point) {
+            ++point;
+        }
+        if (trailing_zeros_start != buffer.end() && position < trailing_zeros_start) {
+            ++trailing_zeros_start;
+        }
+        ++end;
+        *position = ch;
+    };
+
+    // Apply thousands grouping
+    const auto& grouping = numpunct.grouping();
+    if (!grouping.empty())
+    {
+        // Step backwards from the end of the integral digits, inserting the
+        // thousands separator at every group interval.
+        const CharT thousands_sep = ctype.widen(numpunct.thousands_sep());
+        std::size_t group = 0;
+        auto p = digits_start;
+        while (p != end && number.buffer[p - buffer.begin()] >= '0' && number.buffer[p - buffer.begin()] <= '9') {
+            ++p;
+        }
+        auto size = static_cast<int>(grouping[group]);
+        while (size > 0 && size < CHAR_MAX && p - digits_start > size) {
+            p -= size;
+            insert_character(p, thousands_sep);
+            if (group < grouping.size() - 1) {
+                size = static_cast<int>(grouping[++group]);
+            }
+        }
     }
 
     // Write character `ch` `count` times to the stream
@@ -467,7 +597,7 @@ std::basic_ostream<CharT>& operator<<(std::basic_ostream<CharT>& os, fixed<B, I,
 /// Infinity results in either maximum value, or minimum for negative infinity.
 ///
 /// Extreme exponents result either in maximum value (extreme positive exponent) or zero (extreme negative exponent).
-template <typename CharT, class Traits, typename B, typename I, unsigned int F, bool R>
+template <typename CharT, class Traits, typename B, typename I, unsigned int F, auto R>
 std::basic_istream<CharT, Traits>& operator>>(std::basic_istream<CharT, Traits>& is, fixed<B, I, F, R>& x)
 {
     typename std::basic_istream<CharT, Traits>::sentry sentry(is);
@@ -758,67 +888,250 @@ std::basic_istream<CharT, Traits>& operator>>(std::basic_istream<CharT, Traits>&
 
 #if __cplusplus >= 201703L /* C++17 */
 #   include <charconv>
-#   include <sstream>
+namespace fpm
+{
+namespace detail
+{
+
+/// Converts the magnitude of a decimal number to the raw value of a fixed-point type.
+///
+/// The number is given as `count` digits, where `digit_at(i)` returns the value of the i-th digit,
+/// and the position of the decimal point in that sequence. The point may lie outside the sequence,
+/// which is then padded with zeros. The conversion is exact before the final rounding step, which
+/// rounds with \a Mode, given whether the number is negative.
+/// Returns false if the magnitude exceeds `max_raw`.
+template <typename I, unsigned int F, rounding Mode, typename DigitAt>
+[[nodiscard]] constexpr bool decimal_to_raw(DigitAt digit_at, std::ptrdiff_t count, std::ptrdiff_t point, bool negative, I max_raw, I& raw) noexcept
+{
+    // Parse the integer part. Both the accumulator and a single step past the maximum fit in I.
+    const I max_integral = max_raw >> F;
+    I integral = 0;
+    for (std::ptrdiff_t i = 0; i < point; ++i) {
+        integral = integral * 10 + ((i < count) ? digit_at(i) : 0);
+        if (integral > max_integral) {
+            return false;
+        }
+    }
+
+    // Parse the fractional part from the last digit to the first, computing floor(fraction * 2^(F+1)).
+    // Since floor((d + floor(x)) / 10) == floor((d + x) / 10), this is exact for any number of digits.
+    // The extra bit is used to round the result, together with whether any of the divisions was inexact.
+    using fraction_t = std::conditional_t<(F + 5 <= 64), std::uint64_t, I>;
+    fraction_t fraction = 0;
+    bool sticky = false;
+    for (std::ptrdiff_t i = count - 1; i >= point && i >= 0; --i) {
+        const fraction_t scaled = (static_cast<fraction_t>(digit_at(i)) << (F + 1)) + fraction;
+        fraction = scaled / 10;
+        sticky = sticky || (scaled % 10) != 0;
+    }
+    // Leading zeros between the decimal point and the first digit
+    for (std::ptrdiff_t i = point; i < 0 && fraction != 0; ++i) {
+        sticky = sticky || (fraction % 10) != 0;
+        fraction /= 10;
+    }
+    const bool half = (fraction & 1) != 0;
+    fraction >>= 1;
+    if (round_away<Mode>(negative, (fraction & 1) != 0, half && sticky, half && !sticky, half || sticky)) {
+        ++fraction;
+    }
+
+    raw = (integral << F) + static_cast<I>(fraction);
+    return raw <= max_raw;
+}
+
+/// Converts the magnitude of a binary number, mantissa * 2^exponent, to the raw value of a fixed-point type.
+/// Rounds with \a Mode, given whether the number is negative.
+/// Returns false if the magnitude exceeds `max_raw`.
+template <typename I, unsigned int F, rounding Mode>
+[[nodiscard]] constexpr bool binary_to_raw(I mantissa, long long exponent, bool negative, I max_raw, I& raw) noexcept
+{
+    constexpr long long width = sizeof(I) * 8 - 1;
+    const long long shift = exponent + F;
+    if (mantissa == 0) {
+        raw = 0;
+        return true;
+    }
+    if (shift >= 0) {
+        if (shift >= width || mantissa > (max_raw >> shift)) {
+            return false;
+        }
+        raw = mantissa << shift;
+        return true;
+    }
+    raw = (-shift >= width) ? I{0} : (mantissa >> -shift);
+    // The first bit that was shifted out, and whether any of the bits below it are set
+    const bool half = -shift - 1 < width && ((mantissa >> (-shift - 1)) & 1) != 0;
+    const bool sticky = (-shift - 1 < width) ? (mantissa & ((I{1} << (-shift - 1)) - 1)) != 0 : mantissa != 0;
+    if (round_away<Mode>(negative, (raw & 1) != 0, half && sticky, half && !sticky, half || sticky)) {
+        ++raw;
+    }
+    return raw <= max_raw;
+}
+
+} // namespace detail
+} // namespace fpm
+
 namespace std
 {
-    template <typename B, typename I, unsigned int F, bool R>
+    /// Parses a fixed-point number from [first, last) without using streams, locales or allocations.
+    ///
+    /// Follows the rules of `std::from_chars` for floating-point types, except that
+    /// - values outside the range of the fixed-point type (including "inf" and "infinity") result in
+    ///   `std::errc::result_out_of_range`, while "nan" results in `std::errc::invalid_argument`.
+    /// - an exponent is considered invalid for `std::chars_format::fixed`, instead of ending the number.
+    /// - the value is rounded according to the type's rounding setting, instead of to nearest.
+    template <typename B, typename I, unsigned int F, auto R>
     constexpr std::from_chars_result from_chars(
         const char* first,
         const char* last,
         fpm::fixed<B,I,F,R>& value,
-        std::chars_format fmt = std::chars_format::general //TODO Respect this value or at least validate the input
+        std::chars_format fmt = std::chars_format::general
     )
     {
-        // This is just a hack to support hexfloat.
-        if(fmt == std::chars_format::hex)
-        {
-            std::vector<char> buffer{};
-            buffer.reserve(last - first + 2);
-
-            if(*first == '-')
-                buffer.emplace_back('-');
-            buffer.emplace_back('0');
-            buffer.emplace_back('x');
-            for(const char* it = first + (*first == '-' ? 1 : 0); it != last; ++it)
-                buffer.emplace_back(*it);
-
-            auto result = from_chars(buffer.data(), buffer.data() + buffer.size(), value, chars_format::general);
-
-            // Retarget `result` to `first`+`last`
-            if(result.ptr == buffer.data() + buffer.size())
-                result.ptr = last;
-            if(result.ptr == buffer.data())
-                result.ptr = first;
-            if(result.ptr == buffer.data() + 1) // Points to the 'x' char, this is just a hotfix to make it work
-                result.ptr = first;
-            result.ptr = first + (result.ptr - buffer.data() - 2);
-
-            return result;
-        }
+        constexpr auto invalid = [](const char* ptr) {
+            return std::from_chars_result{
+                .ptr = ptr,
+                .ec = std::errc::invalid_argument
+            };
+        };
 
-        std::stringstream ss;
-        ss.write(first, last - first);
+        const bool hex = (fmt == std::chars_format::hex);
+        const bool exponent_allowed = hex || (fmt & std::chars_format::scientific) == std::chars_format::scientific;
+        const bool exponent_required = !hex && exponent_allowed && (fmt & std::chars_format::fixed) != std::chars_format::fixed;
 
-        ss >> value;
+        const char* it = first;
 
-        const auto writtenChars = ss.tellp();
-        const auto readChars = ss.tellg();
-        if(readChars == 0)
+        // Sign. Only a negative sign is allowed.
+        bool negate = false;
+        if (it != last && *it == '-') {
+            negate = true;
+            ++it;
+        }
+
+        // Infinity is out of range and not-a-number can't be represented
+        const auto matches = [&](const char* str) {
+            const char* p = it;
+            for (; *str != '\0'; ++str, ++p) {
+                if (p == last || (*p | 0x20) != *str) {
+                    return false;
+                }
+            }
+            return true;
+        };
+        if (matches("inf")) {
             return std::from_chars_result{
-                .ptr = first,
-                .ec = std::errc::invalid_argument
+                .ptr = it + (matches("infinity") ? 8 : 3),
+                .ec = std::errc::result_out_of_range
             };
-        if(writtenChars == readChars)
+        }
+        if (matches("nan")) {
+            return invalid(first);
+        }
+
+        const auto digit_value = [hex](const char ch) -> int {
+            if (ch >= '0' && ch <= '9') {
+                return ch - '0';
+            }
+            if (hex && ch >= 'a' && ch <= 'f') {
+                return ch - 'a' + 10;
+            }
+            if (hex && ch >= 'A' && ch <= 'F') {
+                return ch - 'A' + 10;
+            }
+            return -1;
+        };
+
+        // Significand: digits with an optional decimal point
+        const char* const digits_first = it;
+        const char* point = nullptr;
+        bool is_zero = true;
+        for (; it != last; ++it) {
+            if (*it == '.' && point == nullptr) {
+                point = it;
+                continue;
+            }
+            const auto digit = digit_value(*it);
+            if (digit < 0) {
+                break;
+            }
+            is_zero = is_zero && (digit == 0);
+        }
+        const std::ptrdiff_t count = (it - digits_first) - (point != nullptr ? 1 : 0);
+        if (count == 0) {
+            // We need at least one digit
+            return invalid(first);
+        }
+        const std::ptrdiff_t integral_count = (point != nullptr) ? point - digits_first : count;
+        const auto digit_at = [&](std::ptrdiff_t i) {
+            return digit_value(digits_first[(point != nullptr && i >= integral_count) ? i + 1 : i]);
+        };
+
+        // Exponent
+        long long exponent = 0;
+        const char exponent_char = hex ? 'p' : 'e';
+        if (it != last && (*it | 0x20) == exponent_char) {
+            if (!exponent_allowed) {
+                return invalid(first);
+            }
+            const char* p = it + 1;
+            bool exponent_negate = false;
+            if (p != last && (*p == '-' || *p == '+')) {
+                exponent_negate = (*p == '-');
+                ++p;
+            }
+            if (p != last && *p >= '0' && *p <= '9') {
+                // Clamp absurd exponents; they over- or underflow any fixed-point type anyway
+                constexpr long long max_exponent = 1000000;
+                for (; p != last && *p >= '0' && *p <= '9'; ++p) {
+                    exponent = std::min(exponent * 10 + (*p - '0'), max_exponent);
+                }
+                exponent = exponent_negate ? -exponent : exponent;
+                it = p;
+            } else if (exponent_required) {
+                return invalid(first);
+            }
+        } else if (exponent_required) {
+            return invalid(first);
+        }
+
+        // Construct the value
+        const I max_raw = negate ? -static_cast<I>(std::numeric_limits<B>::min()) : static_cast<I>(std::numeric_limits<B>::max());
+        I raw = 0;
+        bool in_range = true;
+        if (is_zero) {
+            // Zero, regardless of the exponent
+        } else if (hex) {
+            // Accumulate the significant hexadecimal digits in the mantissa. Any digits that don't fit
+            // only contribute to the exponent; they are far beyond the bits needed for rounding.
+            constexpr I mantissa_limit = I{1} << (sizeof(I) * 8 - 6);
+            I mantissa = 0;
+            long long exponent2 = exponent - 4 * (count - integral_count);
+            for (std::ptrdiff_t i = 0; i < count; ++i) {
+                if (mantissa < mantissa_limit) {
+                    mantissa = mantissa * 16 + digit_at(i);
+                } else {
+                    exponent2 += 4;
+                }
+            }
+            in_range = fpm::detail::binary_to_raw<I, F, fpm::fixed<B,I,F,R>::rounding_mode>(mantissa, exponent2, negate, max_raw, raw);
+        } else {
+            in_range = fpm::detail::decimal_to_raw<I, F, fpm::fixed<B,I,F,R>::rounding_mode>(digit_at, count, integral_count + exponent, negate, max_raw, raw);
+        }
+
+        if (!in_range) {
             return std::from_chars_result{
-                .ptr = last,
-                .ec = {}
+                .ptr = it,
+                .ec = std::errc::result_out_of_range
             };
+        }
+
+        value = fpm::fixed<B,I,F,R>::from_raw_value(static_cast<B>(negate ? -raw : raw));
         return std::from_chars_result{
-            .ptr = first + readChars,
+            .ptr = it,
             .ec = {}
         };
     }
-    template <typename B, typename I, unsigned int F, bool R>
+    template <typename B, typename I, unsigned int F, auto R>
     constexpr std::to_chars_result to_chars(
         char* first,
         char* last,
@@ -827,52 +1140,39 @@ namespace std
         const int precision
     )
     {
-        std::stringstream ss;
-        ss << std::setprecision(precision);
+        fpm::detail::format_spec spec;
+        spec.precision = precision;
         switch(fmt)
         {
             case chars_format::scientific:
-                ss << std::scientific;
+                spec.format = fpm::detail::float_format::scientific;
                 break;
             case chars_format::fixed:
-                ss << std::fixed;
+                spec.format = fpm::detail::float_format::fixed;
                 break;
             case chars_format::hex:
-                ss << std::hexfloat;
+                spec.format = fpm::detail::float_format::hex;
                 break;
             default:
             case chars_format::general:
+                spec.format = fpm::detail::float_format::general;
                 break;
         }
-        try
-        {
-            ss << value;
-        }
-        catch(...)
-        {
-            return std::to_chars_result{
-                .ptr = last,
-                .ec = std::errc::io_error
-            };
-        }
 
-        const auto writtenChars = ss.tellp();
-        const auto readChars = ss.tellg();
-        if(writtenChars > last - first)
+        // Formatted directly on the stack; no stream, locale or allocation involved
+        const auto number = fpm::detail::format_fixed(value, spec);
+        if(number.length() > last - first)
             return std::to_chars_result{
                 .ptr = last,
                 .ec = std::errc::value_too_large
             };
 
-        // Copy to output
-        ss.read(first, writtenChars);
-
         return std::to_chars_result{
-            .ptr = first + writtenChars,
+            .ptr = number.copy(first),
             .ec = {}
         };
     }
-    template <typename B, typename I, unsigned int F, bool R>
+    template <typename B, typename I, unsigned int F, auto R>
     constexpr inline std::to_chars_result to_chars(
         char* first,
         char* last,
@@ -882,7 +1182,7 @@ namespace std
     {
         return to_chars(first, last, value, fmt, 6);
     }
-    template <typename B, typename I, unsigned int F, bool R>
+    template <typename B, typename I, unsigned int F, auto R>
     constexpr inline std::to_chars_result to_chars(
         char* first,
         char* last,
@@ -900,10 +1200,7 @@ namespace std
 #   include <version>
 #   ifdef __cpp_lib_format
 #       include <format>
-#       include <sstream>
-#       include <string_view>
-#       include <iomanip>
-template<typename CharT, typename B, typename I, unsigned int F, bool R>
+template<typename CharT, typename B, typename I, unsigned int F, auto R>
 struct std::formatter<fpm::fixed<B, I, F, R>, CharT>
 {
     static_assert(
@@ -918,11 +1215,12 @@ struct std::formatter<fpm::fixed<B, I, F, R>, CharT>
     char paddingChar = ' ';
     enum class Alignment : char
     {
+        Default = '\0', ///< no alignment given: align right, allowing zero-padding
         Left = '<', ///< align left = padding on right
         Right = '>', ///< align right = padding on left
         Center = '^', ///< align center = padding on both sides, more on left
     };
-    Alignment alignmentChar = Alignment::Right;
+    Alignment alignmentChar = Alignment::Default;
 
     enum class SignControl : char
     {
@@ -937,7 +1235,7 @@ struct std::formatter<fpm::fixed<B, I, F, R>, CharT>
     /// Special behaviour for 'g' and 'G' types.
     bool hashOption = false;
     /// Zero-padding between sign and numbers.
-    /// No effect for non-default alignment
+    /// No effect if an alignment is given
     bool zeroOption = false;
 
     std::size_t width = 0;
@@ -1111,130 +1409,97 @@ struct std::formatter<fpm::fixed<B, I, F, R>, CharT>
     template<typename FormatContext = std::format_context>
     typename FormatContext::iterator format(const fpm::fixed<B, I, F, R>& value, FormatContext& ctx) const
     {
-        std::basic_ostringstream<CharT> out;
-        if(signControl != SignControl::NegativeOnly && value >= fpm::fixed<B, I, F, R>{0})
-        {
-            if(signControl == SignControl::PositiveSign)
-                out << '+';
-            else if(signControl == SignControl::PositiveSpace)
-                out << ' ';
-            else
-                throw std::format_error("Invalid sign behaviour");
-        }
+        fpm::detail::format_spec spec;
+        spec.showpos = (signControl != SignControl::NegativeOnly);
+        spec.showpoint = hashOption;
         if(precision != static_cast<std::size_t>(-1))
-            out << std::setprecision(precision);
-        if(type != FormatType::Default)
+            spec.precision = static_cast<int>(std::min<std::size_t>(precision, std::numeric_limits<int>::max()));
+
+        // Format type itself
+        switch(type)
         {
-            // Format type itself
-            switch(type)
-            {
-                default:
-                case FormatType::Default:
-                    break;
-                case FormatType::Hex:
-                case FormatType::Hex_Upper:
-                    out << std::hexfloat;
-                    break;
-                case FormatType::Scientific:
-                case FormatType::Scientific_Upper:
-                    out << std::scientific;
-                    break;
-                case FormatType::Fixed:
-                case FormatType::Fixed_Upper:
-                    out << std::fixed;
-                    break;
-                case FormatType::General:
-                case FormatType::General_Upper:
-                    break;
-            }
-            // Upper-case versions
-            switch(type)
-            {
-                default:
-                    break;
-                case FormatType::Hex_Upper:
-                case FormatType::Scientific_Upper:
-                case FormatType::Fixed_Upper:
-                case FormatType::General_Upper:
-                    out << std::uppercase;
-                    break;
-            }
+            default:
+            case FormatType::Default:
+            case FormatType::General:
+            case FormatType::General_Upper:
+                spec.format = fpm::detail::float_format::general;
+                break;
+            case FormatType::Hex:
+            case FormatType::Hex_Upper:
+                spec.format = fpm::detail::float_format::hex;
+                break;
+            case FormatType::Scientific:
+            case FormatType::Scientific_Upper:
+                spec.format = fpm::detail::float_format::scientific;
+                break;
+            case FormatType::Fixed:
+            case FormatType::Fixed_Upper:
+                spec.format = fpm::detail::float_format::fixed;
+                break;
         }
-        out << value;
-
-        // Padding
-        if(out.tellp() < width)
+        // Upper-case versions
+        spec.uppercase =
+            type == FormatType::Hex_Upper
+            || type == FormatType::Scientific_Upper
+            || type == FormatType::Fixed_Upper
+            || type == FormatType::General_Upper;
+
+        // The digits are generated on the stack and written straight to the output
+        const auto number = fpm::detail::format_fixed(value, spec);
+        auto out = ctx.out();
+
+        // Output part of the number, replacing a positive sign with a space if requested
+        const auto put = [&](std::ptrdiff_t begin, std::ptrdiff_t end)
         {
-            if(alignmentChar == Alignment::Left)
+            if(begin == 0 && end > 0 && signControl == SignControl::PositiveSpace && number.buffer[0] == '+')
             {
-                while(out.tellp() < width)
-                    out << paddingChar;
+                *out++ = static_cast<CharT>(' ');
+                ++begin;
             }
-            else if(alignmentChar == Alignment::Right)
-            {
-                if(zeroOption)
-                {
-                    const auto str = out.str();
-                    out.clear();
-                    out.seekp(0, std::ios::beg);
-
-                    const bool hasSign = !str.empty() && (str[0] == '+' || str[0] == '-');
-                    if(hasSign)
-                        out << str[0];
-
-                    // Zero-padding between sign character and the true value
-                    while(out.tellp() < width - str.size() + (hasSign ? 1 : 0))
-                        out << '0';
-
-                    // Value without sign
-                    if(hasSign)
-                        out << std::basic_string_view<CharT>(str.data()).substr(1);
-                    else
-                        out << str;
-                }
-                else
-                {
-                    const auto str = out.str();
-                    out.clear();
-                    out.seekp(0, std::ios::beg);
-
-                    while(out.tellp() < width - str.size())
-                        out << paddingChar;
-                    out << str;
-                }
-            }
-            else if(alignmentChar == Alignment::Center)
-            {
-                const auto str = out.str();
-                out.clear();
-                out.seekp(0, std::ios::beg);
-
-                if(str.length() < width)
-                {
-                    const auto padding = width - str.length();
-                    const auto halfPadding = padding / 2;
-
-                    for(std::size_t i = 0; i < halfPadding; ++i) // Padding before the value
-                        out << paddingChar;
+            out = number.copy(begin, end, out);
+        };
+        const auto pad = [&](std::size_t count, CharT ch)
+        {
+            out = std::fill_n(out, count, ch);
+        };
 
-                    out << str;
+        const auto length = static_cast<std::size_t>(number.length());
+        const auto padding = (width > length) ? width - length : 0;
+        const auto fill = static_cast<CharT>(paddingChar);
 
-                    for(std::size_t i = 0; i < halfPadding; ++i) // Padding after the value
-                        out << paddingChar;
-                    if(halfPadding + halfPadding < padding) // This is the longer one (for odd numbers)
-                        out << paddingChar;
-                }
-            }
-            else
-                throw std::runtime_error("Unknown alignment character");
+        if(padding == 0)
+        {
+            put(0, number.size);
         }
-
-        // Copy to output
+        else switch(alignmentChar)
         {
-            const auto str = out.str();
-            std::copy(str.begin(), str.end(), ctx.out());
-            return ctx.out();
+            case Alignment::Left:
+                put(0, number.size);
+                pad(padding, fill);
+                break;
+            case Alignment::Center:
+                // The odd padding character goes after the value
+                pad(padding / 2, fill);
+                put(0, number.size);
+                pad(padding - padding / 2, fill);
+                break;
+            case Alignment::Default:
+                if(zeroOption)
+                {
+                    // Zero-padding between sign character (and "0x") and the true value
+                    put(0, number.internal_pad);
+                    pad(padding, static_cast<CharT>('0'));
+                    put(number.internal_pad, number.size);
+                    break;
+                }
+                [[fallthrough]];
+            case Alignment::Right:
+            default:
+                pad(padding, fill);
+                put(0, number.size);
+                break;
         }
+        return out;
     }
 };
 #   endif
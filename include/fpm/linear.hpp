@@ -0,0 +1,468 @@
+#ifndef FPM_LINEAR_HPP
+#define FPM_LINEAR_HPP
+
+#include "accumulator.hpp"
+#include "fixed.hpp"
+#include "math.hpp"
+#include "simd.hpp"
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace fpm
+{
+
+//! Vector of N fixed-point numbers. It's an aggregate, so `vec3<fixed_16_16>{ x, y, z }` initializes it, and `{}`
+//! is the zero vector. Element-wise operations round like the operators of Fixed; dot products, lengths and
+//! products with matrices keep every product at full precision and round each result once.
+//! \tparam N     the number of elements
+//! \tparam Fixed the fixed-point type of the elements
+template <std::size_t N, typename Fixed> requires is_fixed_v<Fixed>
+struct vec
+{
+    using value_type = Fixed;
+    static constexpr std::size_t dimension = N;
+
+    std::array<Fixed, N> elements;
+
+    [[nodiscard]] constexpr inline Fixed& operator[](std::size_t i) noexcept { return elements[i]; }
+    [[nodiscard]] constexpr inline Fixed operator[](std::size_t i) const noexcept { return elements[i]; }
+
+    [[nodiscard]] constexpr inline Fixed x() const noexcept requires (N >= 1) { return elements[0]; }
+    [[nodiscard]] constexpr inline Fixed y() const noexcept requires (N >= 2) { return elements[1]; }
+    [[nodiscard]] constexpr inline Fixed z() const noexcept requires (N >= 3) { return elements[2]; }
+    [[nodiscard]] constexpr inline Fixed w() const noexcept requires (N >= 4) { return elements[3]; }
+
+    //
+    // Arithmetic member operators, element by element
+    //
+
+    [[nodiscard]] constexpr inline vec operator-() const noexcept
+    {
+        vec result;
+        for (std::size_t i = 0; i < N; ++i) {
+            result.elements[i] = -elements[i];
+        }
+        return result;
+    }
+
+    constexpr inline vec& operator+=(const vec& y) noexcept
+    {
+        for (std::size_t i = 0; i < N; ++i) {
+            elements[i] += y.elements[i];
+        }
+        return *this;
+    }
+
+    constexpr inline vec& operator-=(const vec& y) noexcept
+    {
+        for (std::size_t i = 0; i < N; ++i) {
+            elements[i] -= y.elements[i];
+        }
+        return *this;
+    }
+
+    constexpr inline vec& operator*=(Fixed y) noexcept
+    {
+        for (auto& element : elements) {
+            element *= y;
+        }
+        return *this;
+    }
+
+    constexpr inline vec& operator/=(Fixed y) noexcept
+    {
+        for (auto& element : elements) {
+            element /= y;
+        }
+        return *this;
+    }
+
+    [[nodiscard]] friend constexpr inline bool operator==(const vec& x, const vec& y) noexcept = default;
+};
+
+template <typename Fixed, typename... Rest>
+vec(Fixed, Rest...) -> vec<1 + sizeof...(Rest), Fixed>;
+
+template <typename Fixed> using vec2 = vec<2, Fixed>;
+template <typename Fixed> using vec3 = vec<3, Fixed>;
+template <typename Fixed> using vec4 = vec<4, Fixed>;
+
+//
+// Vector operators
+//
+
+template <std::size_t N, typename Fixed>
+[[nodiscard]] constexpr inline vec<N, Fixed> operator+(vec<N, Fixed> x, const vec<N, Fixed>& y) noexcept
+{
+    return x += y;
+}
+
+template <std::size_t N, typename Fixed>
+[[nodiscard]] constexpr inline vec<N, Fixed> operator-(vec<N, Fixed> x, const vec<N, Fixed>& y) noexcept
+{
+    return x -= y;
+}
+
+template <std::size_t N, typename Fixed>
+[[nodiscard]] constexpr inline vec<N, Fixed> operator*(vec<N, Fixed> x, std::type_identity_t<Fixed> y) noexcept
+{
+    return x *= y;
+}
+
+template <std::size_t N, typename Fixed>
+[[nodiscard]] constexpr inline vec<N, Fixed> operator*(std::type_identity_t<Fixed> x, vec<N, Fixed> y) noexcept
+{
+    return y *= x;
+}
+
+template <std::size_t N, typename Fixed>
+[[nodiscard]] constexpr inline vec<N, Fixed> operator/(vec<N, Fixed> x, std::type_identity_t<Fixed> y) noexcept
+{
+    return x /= y;
+}
+
+//
+// Vector functions
+//
+
+/// Calculates the dot product. The products are added without rounding, and the sum is rounded once.
+template <std::size_t N, typename Fixed>
+[[nodiscard]] constexpr Fixed dot(const vec<N, Fixed>& x, const vec<N, Fixed>& y) noexcept
+{
+    accumulator<Fixed> sum;
+    for (std::size_t i = 0; i < N; ++i) {
+        sum.fma(x[i], y[i]);
+    }
+    return sum.value();
+}
+
+/// Calculates the cross product, with each element rounded once
+template <typename Fixed>
+[[nodiscard]] constexpr vec3<Fixed> cross(const vec3<Fixed>& x, const vec3<Fixed>& y) noexcept
+{
+    return { accumulator<Fixed>().fma(x[1], y[2]).fms(x[2], y[1]).value(),
+             accumulator<Fixed>().fma(x[2], y[0]).fms(x[0], y[2]).value(),
+             accumulator<Fixed>().fma(x[0], y[1]).fms(x[1], y[0]).value() };
+}
+
+/// Calculates the z element of the cross product of two vectors in the plane, x[0] * y[1] - x[1] * y[0], rounded once
+template <typename Fixed>
+[[nodiscard]] constexpr Fixed cross(const vec2<Fixed>& x, const vec2<Fixed>& y) noexcept
+{
+    return accumulator<Fixed>().fma(x[0], y[1]).fms(x[1], y[0]).value();
+}
+
+/// Calculates the length like hypot(): the squares keep twice the fraction bits in an integer type with at least
+/// 64 bits, so only the result has to fit the type. It's rounded to nearest.
+template <std::size_t N, typename Fixed>
+[[nodiscard]] constexpr Fixed length(const vec<N, Fixed>& x) noexcept
+{
+    using T = detail::root_type<typename Fixed::intermediate_type>;
+    T sum = 0;
+    for (std::size_t i = 0; i < N; ++i) {
+        sum += detail::raw_square<T>(x[i]);
+    }
+    return detail::sqrt_of_squares<Fixed>(sum);
+}
+
+/// Returns x / length(x), which must not be the zero vector. The elements are multiplied by 1/length like rsqrt(),
+/// without a division or rounding the length first, and each is rounded once with the rounding mode of the type.
+/// The type must be able to contain 1.
+template <std::size_t N, typename Fixed>
+[[nodiscard]] constexpr vec<N, Fixed> normalize(const vec<N, Fixed>& x) noexcept
+{
+    using B = typename Fixed::base_type;
+    using W = detail::scaled_type<typename Fixed::intermediate_type>;
+    using T = detail::root_type<typename Fixed::intermediate_type>;
+    constexpr int h = sizeof(T) * 4;
+
+    // Each square fits T, but their sum may not, even though the result always fits the type. The bits that
+    // overflow T are counted in a carry, and then the sum is scaled down by 4**k to fit, which doesn't change
+    // the result beyond the low bits of a sum that large.
+    T sum = 0, carry = 0;
+    for (std::size_t i = 0; i < N; ++i) {
+        const T square = detail::raw_square<T>(x[i]);
+        sum += square;
+        carry += (sum < square) ? 1 : 0;
+    }
+    int k = 0;
+    if (carry != 0) {
+        k = (detail::highest_bit(carry) + 2) / 2;
+        sum = (sum >> (2 * k)) | (carry << (2 * h - 2 * k));
+    }
+    assert(sum != 0);
+
+    // x[i] / sqrt(sum * 4**k) in raw values, where the sum is normalized to m / 4**n and e = n - k. The products
+    // with 1/sqrt(m), which is below 2**(h-1), have a bit of headroom, and are rounded without a branch.
+    const int n = (2 * h - 1 - detail::highest_bit(sum)) / 2;
+    const T y = detail::rsqrt_normalized<detail::rsqrt_steps<T>>(sum << (2 * n));
+    const int e = n - k;
+    const auto shift = static_cast<unsigned int>(2 * h - 2 - e - static_cast<int>(Fixed::fraction_bits));
+    vec<N, Fixed> result;
+    for (std::size_t i = 0; i < N; ++i) {
+        const W product = static_cast<W>(x[i].raw_value()) * static_cast<W>(y);
+        result[i] = Fixed::from_raw_value(static_cast<B>(detail::shift_right_with_headroom<Fixed::rounding_mode>(product, shift)));
+    }
+    return result;
+}
+
+//! Matrix of R rows and C columns of fixed-point numbers, stored as an aggregate of row vectors, so that
+//! `mat2<fixed_16_16>{ a, b, c, d }` lists the elements row by row.
+//! \tparam R     the number of rows
+//! \tparam C     the number of columns
+//! \tparam Fixed the fixed-point type of the elements
+template <std::size_t R, std::size_t C, typename Fixed> requires is_fixed_v<Fixed>
+struct mat
+{
+    using value_type = Fixed;
+    using row_type = vec<C, Fixed>;
+    static constexpr std::size_t row_count = R;
+    static constexpr std::size_t column_count = C;
+
+    std::array<row_type, R> rows;
+
+    /// Returns the identity matrix
+    [[nodiscard]] static constexpr mat identity() noexcept requires (R == C)
+    {
+        mat result{};
+        for (std::size_t i = 0; i < R; ++i) {
+            result.rows[i][i] = Fixed(1);
+        }
+        return result;
+    }
+
+    [[nodiscard]] constexpr inline row_type& operator[](std::size_t row) noexcept { return rows[row]; }
+    [[nodiscard]] constexpr inline const row_type& operator[](std::size_t row) const noexcept { return rows[row]; }
+
+    //
+    // Arithmetic member operators, element by element
+    //
+
+    [[nodiscard]] constexpr inline mat operator-() const noexcept
+    {
+        mat result;
+        for (std::size_t i = 0; i < R; ++i) {
+            result.rows[i] = -rows[i];
+        }
+        return result;
+    }
+
+    constexpr inline mat& operator+=(const mat& y) noexcept
+    {
+        for (std::size_t i = 0; i < R; ++i) {
+            rows[i] += y.rows[i];
+        }
+        return *this;
+    }
+
+    constexpr inline mat& operator-=(const mat& y) noexcept
+    {
+        for (std::size_t i = 0; i < R; ++i) {
+            rows[i] -= y.rows[i];
+        }
+        return *this;
+    }
+
+    constexpr inline mat& operator*=(Fixed y) noexcept
+    {
+        for (auto& row : rows) {
+            row *= y;
+        }
+        return *this;
+    }
+
+    [[nodiscard]] friend constexpr inline bool operator==(const mat& x, const mat& y) noexcept = default;
+};
+
+template <typename Fixed> using mat2 = mat<2, 2, Fixed>;
+template <typename Fixed> using mat3 = mat<3, 3, Fixed>;
+template <typename Fixed> using mat4 = mat<4, 4, Fixed>;
+
+//
+// Matrix operators
+//
+
+template <std::size_t R, std::size_t C, typename Fixed>
+[[nodiscard]] constexpr inline mat<R, C, Fixed> operator+(mat<R, C, Fixed> x, const mat<R, C, Fixed>& y) noexcept
+{
+    return x += y;
+}
+
+template <std::size_t R, std::size_t C, typename Fixed>
+[[nodiscard]] constexpr inline mat<R, C, Fixed> operator-(mat<R, C, Fixed> x, const mat<R, C, Fixed>& y) noexcept
+{
+    return x -= y;
+}
+
+template <std::size_t R, std::size_t C, typename Fixed>
+[[nodiscard]] constexpr inline mat<R, C, Fixed> operator*(mat<R, C, Fixed> x, std::type_identity_t<Fixed> y) noexcept
+{
+    return x *= y;
+}
+
+template <std::size_t R, std::size_t C, typename Fixed>
+[[nodiscard]] constexpr inline mat<R, C, Fixed> operator*(std::type_identity_t<Fixed> x, mat<R, C, Fixed> y) noexcept
+{
+    return y *= x;
+}
+
+/// Multiplies a matrix with a column vector. Each element of the result is a dot product, rounded once.
+template <std::size_t R, std::size_t C, typename Fixed>
+[[nodiscard]] constexpr vec<R, Fixed> operator*(const mat<R, C, Fixed>& x, const vec<C, Fixed>& y) noexcept
+{
+    vec<R, Fixed> result;
+    for (std::size_t i = 0; i < R; ++i) {
+        result[i] = dot(x[i], y);
+    }
+    return result;
+}
+
+/// Multiplies two matrices. Each element of the result is a dot product, rounded once.
+template <std::size_t R, std::size_t K, std::size_t C, typename Fixed>
+[[nodiscard]] constexpr mat<R, C, Fixed> operator*(const mat<R, K, Fixed>& x, const mat<K, C, Fixed>& y) noexcept
+{
+    mat<R, C, Fixed> result;
+    for (std::size_t i = 0; i < R; ++i) {
+        for (std::size_t j = 0; j < C; ++j) {
+            accumulator<Fixed> sum;
+            for (std::size_t k = 0; k < K; ++k) {
+                sum.fma(x[i][k], y[k][j]);
+            }
+            result[i][j] = sum.value();
+        }
+    }
+    return result;
+}
+
+/// Returns the transposed matrix
+template <std::size_t R, std::size_t C, typename Fixed>
+[[nodiscard]] constexpr mat<C, R, Fixed> transpose(const mat<R, C, Fixed>& x) noexcept
+{
+    mat<C, R, Fixed> result;
+    for (std::size_t i = 0; i < R; ++i) {
+        for (std::size_t j = 0; j < C; ++j) {
+            result[j][i] = x[i][j];
+        }
+    }
+    return result;
+}
+
+//! Operations on arrays of vectors stored as a structure of arrays: one span per element, so that element i of
+//! every span belongs to the i-th vector. The results are identical to the functions on single vectors.
+//! The template arguments must be given, e.g. `fpm::batch::length<3, fpm::fixed_16_16>({ x, y, z }, out)`.
+namespace batch
+{
+
+//! The input spans of N-element vectors stored as a structure of arrays
+template <std::size_t N, typename Fixed>
+using const_soa = std::array<std::span<const Fixed>, N>;
+
+//! The output spans of N-element vectors stored as a structure of arrays
+template <std::size_t N, typename Fixed>
+using soa = std::array<std::span<Fixed>, N>;
+
+namespace detail
+{
+
+/// Returns the i-th vector. It's initialized at once, which compilers keep in registers better than a loop.
+template <std::size_t N, typename Fixed>
+[[nodiscard]] constexpr inline vec<N, Fixed> load(const const_soa<N, Fixed>& x, std::size_t i) noexcept
+{
+    return [&]<std::size_t... K>(std::index_sequence<K...>) {
+        return vec<N, Fixed>{ x[K][i]... };
+    }(std::make_index_sequence<N>{});
+}
+
+/// Stores v as the i-th vector
+template <std::size_t N, typename Fixed>
+constexpr inline void store(const soa<N, Fixed>& out, std::size_t i, const vec<N, Fixed>& v) noexcept
+{
+    for (std::size_t k = 0; k < N; ++k) {
+        out[k][i] = v[k];
+    }
+}
+
+/// Returns whether every span has the given size
+template <typename Spans>
+[[nodiscard]] constexpr inline bool sized(const Spans& spans, std::size_t size) noexcept
+{
+    for (const auto& span : spans) {
+        if (span.size() != size) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+//! Computes out[i] = dot(x_i, y_i)
+template <std::size_t N, typename Fixed> requires is_fixed_v<Fixed>
+inline void dot(const const_soa<N, Fixed>& x, const const_soa<N, Fixed>& y, std::span<Fixed> out) noexcept
+{
+    assert(detail::sized(x, out.size()) && detail::sized(y, out.size()));
+    for (std::size_t i = 0; i < out.size(); ++i) {
+        accumulator<Fixed> sum;
+        for (std::size_t k = 0; k < N; ++k) {
+            sum.fma(x[k][i], y[k][i]);
+        }
+        out[i] = sum.value();
+    }
+}
+
+//! Computes out_i = cross(x_i, y_i) for 3D vectors
+template <std::size_t N, typename Fixed> requires (is_fixed_v<Fixed> && N == 3)
+inline void cross(const const_soa<N, Fixed>& x, const const_soa<N, Fixed>& y, const soa<N, Fixed>& out) noexcept
+{
+    assert(detail::sized(x, out[0].size()) && detail::sized(y, out[0].size()) && detail::sized(out, out[0].size()));
+    for (std::size_t i = 0; i < out[0].size(); ++i) {
+        detail::store(out, i, fpm::cross(detail::load(x, i), detail::load(y, i)));
+    }
+}
+
+//! Computes out[i] = length(x_i). For two and three elements, this is fpm::simd::hypot with its vector kernels.
+template <std::size_t N, typename Fixed> requires is_fixed_v<Fixed>
+inline void length(const const_soa<N, Fixed>& x, std::span<Fixed> out) noexcept
+{
+    assert(detail::sized(x, out.size()));
+    if constexpr (N == 2) {
+        simd::hypot<Fixed>(x[0], x[1], out);
+    } else if constexpr (N == 3) {
+        simd::hypot<Fixed>(x[0], x[1], x[2], out);
+    } else {
+        for (std::size_t i = 0; i < out.size(); ++i) {
+            out[i] = fpm::length(detail::load(x, i));
+        }
+    }
+}
+
+//! Computes out_i = normalize(x_i). None of the vectors may be the zero vector.
+template <std::size_t N, typename Fixed> requires is_fixed_v<Fixed>
+inline void normalize(const const_soa<N, Fixed>& x, const soa<N, Fixed>& out) noexcept
+{
+    assert(detail::sized(x, out[0].size()) && detail::sized(out, out[0].size()));
+    for (std::size_t i = 0; i < out[0].size(); ++i) {
+        detail::store(out, i, fpm::normalize(detail::load(x, i)));
+    }
+}
+
+//! Computes out_i = m * x_i
+template <std::size_t R, std::size_t C, typename Fixed> requires is_fixed_v<Fixed>
+inline void transform(const mat<R, C, Fixed>& m, const const_soa<C, Fixed>& x, const soa<R, Fixed>& out) noexcept
+{
+    assert(detail::sized(x, out[0].size()) && detail::sized(out, out[0].size()));
+    for (std::size_t i = 0; i < out[0].size(); ++i) {
+        detail::store(out, i, m * detail::load(x, i));
+    }
+}
+
+}
+
+}
+
+#endif
@@ -3,9 +3,13 @@
 
 #include "fixed.hpp"
 
+#include <array>
 #include <bit>
 #include <cassert>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
 
 
 namespace fpm
@@ -15,7 +19,7 @@ namespace detail
 {
 
 /// Returns the index of the most-significant set bit
-[[nodiscard]] inline long find_highest_bit(unsigned long long value) noexcept
+[[nodiscard]] constexpr inline long find_highest_bit(unsigned long long value) noexcept
 {
     assert(value != 0);
 	return std::bit_width(value) - 1;
@@ -23,79 +27,79 @@ namespace detail
 
 }
 
-template <typename B, typename I, unsigned int F, bool R>
+template <typename B, typename I, unsigned int F, auto R>
 [[nodiscard]] constexpr inline int fpclassify(fixed<B, I, F, R> x) noexcept
 {
     return (x.raw_value() == 0) ? FP_ZERO : FP_NORMAL;
 }
 
-template <typename B, typename I, unsigned int F, bool R>
+template <typename B, typename I, unsigned int F, auto R>
 [[nodiscard]] constexpr inline bool isfinite(fixed<B, I, F, R>) noexcept
 {
     return true;
 }
 
-template <typename B, typename I, unsigned int F, bool R>
+template <typename B, typename I, unsigned int F, auto R>
 [[nodiscard]] constexpr inline bool isinf(fixed<B, I, F, R>) noexcept
 {
     return false;
 }
 
-template <typename B, typename I, unsigned int F, bool R>
+template <typename B, typename I, unsigned int F, auto R>
 [[nodiscard]] constexpr inline bool isnan(fixed<B, I, F, R>) noexcept
 {
     return false;
 }
 
-template <typename B, typename I, unsigned int F, bool R>
+template <typename B, typename I, unsigned int F, auto R>
 [[nodiscard]] constexpr inline bool isnormal(fixed<B, I, F, R> x) noexcept
 {
     return x.raw_value() != 0;
 }
 
-template <typename B, typename I, unsigned int F, bool R>
+template <typename B, typename I, unsigned int F, auto R>
 [[nodiscard]] constexpr inline bool signbit(fixed<B, I, F, R> x) noexcept
 {
     return x.raw_value() < 0;
 }
 
-template <typename B, typename I, unsigned int F, bool R>
+template <typename B, typename I, unsigned int F, auto R>
 [[nodiscard]] constexpr inline bool isgreater(fixed<B, I, F, R> x, fixed<B, I, F, R> y) noexcept
 {
     return x > y;
 }
 
-template <typename B, typename I, unsigned int F, bool R>
+template <typename B, typename I, unsigned int F, auto R>
 [[nodiscard]] constexpr inline bool isgreaterequal(fixed<B, I, F, R> x, fixed<B, I, F, R> y) noexcept
 {
     return x >= y;
 }
 
-template <typename B, typename I, unsigned int F, bool R>
+template <typename B, typename I, unsigned int F, auto R>
 [[nodiscard]] constexpr inline bool isless(fixed<B, I, F, R> x, fixed<B, I, F, R> y) noexcept
 {
     return x < y;
 }
 
-template <typename B, typename I, unsigned int F, bool R>
+template <typename B, typename I, unsigned int F, auto R>
 [[nodiscard]] constexpr inline bool islessequal(fixed<B, I, F, R> x, fixed<B, I, F, R> y) noexcept
 {
     return x <= y;
 }
 
-template <typename B, typename I, unsigned int F, bool R>
+template <typename B, typename I, unsigned int F, auto R>
 [[nodiscard]] constexpr inline bool islessgreater(fixed<B, I, F, R> x, fixed<B, I, F, R> y) noexcept
 {
     return x != y;
 }
 
-template <typename B, typename I, unsigned int F, bool R>
+template <typename B, typename I, unsigned int F, auto R>
 [[nodiscard]] constexpr inline bool isunordered(fixed<B, I, F, R> x, fixed<B, I, F, R> y) noexcept
 {
     return false;
 }
 
-template <typename B, typename I, unsigned int F, bool R>
+template <typename B, typename I, unsigned int F, auto R>
 [[nodiscard]] constexpr inline fixed<B, I, F, R> ceil(fixed<B, I, F, R> x) noexcept
 {
     constexpr auto FRAC = B(1) << F;
@@ -105,7 +109,7 @@ template <typename B, typename I, unsigned int F, bool R>
     return fixed<B, I, F, R>::from_raw_value(value / FRAC * FRAC);
 }
 
-template <typename B, typename I, unsigned int F, bool R>
+template <typename B, typename I, unsigned int F, auto R>
 [[nodiscard]] constexpr inline fixed<B, I, F, R> floor(fixed<B, I, F, R> x) noexcept
 {
     constexpr auto FRAC = B(1) << F;
@@ -115,14 +119,14 @@ template <typename B, typename I, unsigned int F, bool R>
     return fixed<B, I, F, R>::from_raw_value(value / FRAC * FRAC);
 }
 
-template <typename B, typename I, unsigned int F, bool R>
+template <typename B, typename I, unsigned int F, auto R>
 [[nodiscard]] constexpr inline fixed<B, I, F, R> trunc(fixed<B, I, F, R> x) noexcept
 {
     constexpr auto FRAC = B(1) << F;
     return fixed<B, I, F, R>::from_raw_value(x.raw_value() / FRAC * FRAC);
 }
 
-template <typename B, typename I, unsigned int F, bool R>
+template <typename B, typename I, unsigned int F, auto R>
 [[nodiscard]] constexpr inline fixed<B, I, F, R> round(fixed<B, I, F, R> x) noexcept
 {
     constexpr auto FRAC = B(1) << F;
@@ -130,7 +134,7 @@ template <typename B, typename I, unsigned int F, bool R>
     return fixed<B, I, F, R>::from_raw_value(((value / 2) + (value % 2)) * FRAC);
 }
 
-template <typename B, typename I, unsigned int F, bool R>
+template <typename B, typename I, unsigned int F, auto R>
 [[nodiscard]] constexpr inline fixed<B, I, F, R> nearbyint(fixed<B, I, F, R> x) noexcept
 {
     // Rounding mode is assumed to be FE_TONEAREST
@@ -143,20 +147,20 @@ template <typename B, typename I, unsigned int F, bool R>
     return fixed<B, I, F, R>::from_raw_value(value * FRAC);
 }
 
-template <typename B, typename I, unsigned int F, bool R>
+template <typename B, typename I, unsigned int F, auto R>
 [[nodiscard]] constexpr inline fixed<B, I, F, R> rint(fixed<B, I, F, R> x) noexcept
 {
     // Rounding mode is assumed to be FE_TONEAREST
     return nearbyint(x);
 }
 
-template <typename B, typename I, unsigned int F, bool R> requires std::is_signed_v<B>
+template <typename B, typename I, unsigned int F, auto R> requires std::is_signed_v<B>
 [[nodiscard]] constexpr inline fixed<B, I, F, R> abs(fixed<B, I, F, R> x) noexcept
 {
     return (x >= fixed<B, I, F, R>{0}) ? x : -x;
 }
 
-template <typename B, typename I, unsigned int F, bool R>
+template <typename B, typename I, unsigned int F, auto R>
 [[nodiscard]] constexpr inline fixed<B, I, F, R> fmod(fixed<B, I, F, R> x, fixed<B, I, F, R> y) noexcept
 {
     return
@@ -164,7 +168,7 @@ template <typename B, typename I, unsigned int F, bool R>
         fixed<B, I, F, R>::from_raw_value(x.raw_value() % y.raw_value());
 }
 
-template <typename B, typename I, unsigned int F, bool R>
+template <typename B, typename I, unsigned int F, auto R>
 [[nodiscard]] constexpr inline fixed<B, I, F, R> circmod(fixed<B, I, F, R> x, fixed<B, I, F, R> y) noexcept
 {
 	return
@@ -175,7 +179,7 @@ template <typename B, typename I, unsigned int F, bool R>
 		);
 }
 
-template <typename B, typename I, unsigned int F, bool R>
+template <typename B, typename I, unsigned int F, auto R>
 [[nodiscard]] constexpr inline fixed<B, I, F, R> remainder(fixed<B, I, F, R> x, fixed<B, I, F, R> y) noexcept
 {
     return
@@ -183,7 +187,7 @@ template <typename B, typename I, unsigned int F, bool R>
         x - nearbyint(x / y) * y;
 }
 
-template <typename B, typename I, unsigned int F, bool R>
+template <typename B, typename I, unsigned int F, auto R>
 [[nodiscard]] constexpr inline fixed<B, I, F, R> remquo(fixed<B, I, F, R> x, fixed<B, I, F, R> y, int* quo) noexcept
 {
     assert(y.raw_value() != 0);
@@ -192,7 +196,7 @@ template <typename B, typename I, unsigned int F, bool R>
     return fixed<B, I, F, R>::from_raw_value(x.raw_value() % y.raw_value());
 }
 
-template <typename B, typename I, unsigned int F, bool R, typename C, typename J, unsigned int G, bool S>
+template <typename B, typename I, unsigned int F, auto R, typename C, typename J, unsigned int G, auto S>
 [[nodiscard]] constexpr inline fixed<B, I, F, R> copysign(fixed<B, I, F, R> x, fixed<C, J, G, S> y) noexcept
 {
     return
@@ -200,7 +204,7 @@ template <typename B, typename I, unsigned int F, bool R, typename C, typename J
         (y >= fixed<C, J, G, S>{0}) ? x : -x;
 }
 
-template <typename B, typename I, unsigned int F, bool R>
+template <typename B, typename I, unsigned int F, auto R>
 [[nodiscard]] constexpr inline fixed<B, I, F, R> nextafter(fixed<B, I, F, R> from, fixed<B, I, F, R> to) noexcept
 {
     return from == to ? to :
@@ -208,13 +212,13 @@ template <typename B, typename I, unsigned int F, bool R>
                      : fixed<B, I, F, R>::from_raw_value(from.raw_value() - 1);
 }
 
-template <typename B, typename I, unsigned int F, bool R>
+template <typename B, typename I, unsigned int F, auto R>
 [[nodiscard]] constexpr inline fixed<B, I, F, R> nexttoward(fixed<B, I, F, R> from, fixed<B, I, F, R> to) noexcept
 {
     return nextafter(from, to);
 }
 
-template <typename B, typename I, unsigned int F, bool R>
+template <typename B, typename I, unsigned int F, auto R>
 [[nodiscard]] constexpr inline fixed<B, I, F, R> modf(fixed<B, I, F, R> x, fixed<B, I, F, R>* iptr) noexcept
 {
     const auto raw = x.raw_value();
@@ -223,7 +227,210 @@ template <typename B, typename I, unsigned int F, bool R>
     return fixed<B, I, F, R>::from_raw_value(raw % FRAC);
 }
 
-template <typename B, typename I, unsigned int F, bool R, typename T> requires std::is_integral_v<T>
+//
+// Division without a division instruction
+//
+
+namespace detail
+{
+
+/// Seed table for reciprocal_word: 11-bit approximations of 2**19 / (256 + i).
+inline constexpr auto reciprocal_table = [] {
+    std::array<std::uint16_t, 256> table{};
+    for (std::uint32_t i = 0; i < table.size(); ++i) {
+        table[i] = static_cast<std::uint16_t>(((std::uint32_t{1} << 19) - 3 * (std::uint32_t{1} << 8)) / (256 + i));
+    }
+    return table;
+}();
+
+/// Returns an approximation of 2**97 / d for a normalized d (with the highest bit set), which is at most 2 too low.
+/// The seed from the table is refined with two Newton-Raphson iterations.
+[[nodiscard]] constexpr inline std::uint64_t reciprocal_estimate(std::uint64_t d) noexcept
+{
+    assert(d >> 63 != 0);
+    const std::uint64_t d9 = d >> 55;
+    const std::uint64_t d40 = (d >> 24) + 1;
+    const std::uint64_t v0 = reciprocal_table[d9 - 256];
+    const std::uint64_t v1 = (v0 << 11) - ((v0 * v0 * d40) >> 40) - 1;
+    return (v1 << 13) + ((v1 * ((std::uint64_t{1} << 60) - v1 * d40)) >> 47);
+}
+
+#ifdef FPM_INT128
+/// Returns floor((2**128 - 1) / d) - 2**64 for a normalized d (with the highest bit set).
+/// This refines reciprocal_estimate with another iteration, and the last step makes the result exact.
+/// See Möller and Granlund, "Improved division by invariant integers", Algorithm 2.
+[[nodiscard]] constexpr inline std::uint64_t reciprocal_word(std::uint64_t d) noexcept
+{
+    const std::uint64_t d0 = d & 1;
+    const std::uint64_t d63 = (d >> 1) + d0;
+    const std::uint64_t v2 = reciprocal_estimate(d);
+    const std::uint64_t e = ((v2 >> 1) & (0 - d0)) - v2 * d63;
+    const std::uint64_t v3 = (v2 << 31) + static_cast<std::uint64_t>((static_cast<uint128_t>(v2) * e) >> 65);
+    return v3 - static_cast<std::uint64_t>((static_cast<uint128_t>(v3) * d + d) >> 64) - d;
+}
+#endif
+
+/// Returns the magnitude of the raw value of x.
+template <typename B, typename I, unsigned int F, auto R>
+[[nodiscard]] constexpr inline std::uint64_t magnitude(fixed<B, I, F, R> x) noexcept
+{
+    const B value = x.raw_value();
+    return (value < 0) ? 0 - static_cast<std::uint64_t>(value) : static_cast<std::uint64_t>(value);
+}
+
+}
+
+/// Calculates 1 / x with the same result as Fixed(1) / x for all results that fit the type, but without a
+/// division instruction.
+template <typename B, typename I, unsigned int F, auto R>
+[[nodiscard]] constexpr inline fixed<B, I, F, R> reciprocal(fixed<B, I, F, R> x) noexcept
+{
+    using Fixed = fixed<B, I, F, R>;
+    assert(x.raw_value() != 0);
+    constexpr bool round = (Fixed::rounding_mode == rounding::half_away_from_zero);
+    if constexpr (!round && Fixed::rounding_mode != rounding::toward_zero) {
+        // Only rounding on the extra bit is implemented
+        return Fixed(1) / x;
+    }
+
+    // With v normalized to d = v * 2**n, the quotient 2**(2F) / v is floor(2**(2F + n) / d), which is
+    // a scaled reciprocal of d. Rounding needs one more bit of the quotient.
+    constexpr unsigned int dividend_bits = 2 * F + (round ? 1 : 0);
+    const std::uint64_t v = detail::magnitude(x);
+    const int n = std::countl_zero(v);
+    const std::uint64_t d = v << n;
+    const int shift = static_cast<int>(dividend_bits) + n;
+
+    if constexpr (sizeof(B) <= 4) {
+        // Quotients that fit the type are below 2**34, so the estimate of 2**97 / d is precise enough to be
+        // at most 2 too low. The remainder tells how much.
+        const std::uint64_t r = detail::reciprocal_estimate(d);
+        std::uint64_t q = (shift <= 97) ? (r >> (97 - shift)) : (r << (shift - 97));
+        constexpr std::uint64_t dividend = (dividend_bits < 64) ? (std::uint64_t{1} << dividend_bits) : 0;
+        const std::uint64_t remainder = dividend - q * v;
+        q += (remainder >= v) + (remainder >= 2 * v);
+        if (round) {
+            q = (q + 1) >> 1;
+        }
+        const I value = static_cast<I>(q);
+        return Fixed::from_raw_value(static_cast<B>((x.raw_value() < 0) ? -value : value));
+    } else {
+#ifdef FPM_INT128
+        // floor(2**128 / d) differs from the exact reciprocal when d is a power of two.
+        // Quotients that need more than 128 bits don't fit the type anyway.
+        const uint128_t r = (uint128_t{1} << 64) + detail::reciprocal_word(d) + ((d << 1) == 0 ? 1 : 0);
+        uint128_t q = (shift <= 128) ? (r >> (128 - shift)) : (r << (shift - 128));
+        if (round) {
+            q = (q + 1) >> 1;
+        }
+        const I value = static_cast<I>(q);
+        return Fixed::from_raw_value(static_cast<B>((x.raw_value() < 0) ? -value : value));
+#else
+        return Fixed(1) / x;
+#endif
+    }
+}
+
+//! Divisor for fast division by the same number, such as a constant.
+//! The division is replaced by a multiplication and a shift, with the same result as operator/:
+//! \code
+//! constexpr fpm::divisor half_pi(fpm::fixed_16_16::half_pi());
+//! fpm::fixed_16_16 quadrant = x / half_pi;
+//! \endcode
+//! When the divisor is constexpr, the multiplier is calculated at compile time. Otherwise, constructing it
+//! takes about as long as a hundred divisions.
+template <typename Fixed> requires is_fixed_v<Fixed>
+class divisor
+{
+    using B = typename Fixed::base_type;
+    using I = typename Fixed::intermediate_type;
+    static constexpr unsigned int F = Fixed::fraction_bits;
+    static constexpr unsigned int RoundingBits = (Fixed::rounding_mode == rounding::half_away_from_zero) ? 1 : 0;
+    static constexpr unsigned int BaseBits = sizeof(B) * 8;
+
+#ifdef FPM_INT128
+    // The multiplier is below 2**(F + RoundingBits + BaseBits + 1)
+    // Only rounding on the extra bit is implemented
+    static constexpr bool use_multiplier = (F + RoundingBits + BaseBits + 2 <= 128) &&
+        (RoundingBits == 1 || Fixed::rounding_mode == rounding::toward_zero);
+    using multiplier_type = std::conditional_t<(F + RoundingBits + BaseBits + 2 <= 64), std::uint64_t, uint128_t>;
+#else
+    static constexpr bool use_multiplier = false;
+    using multiplier_type = std::uint64_t;
+#endif
+
+public:
+    constexpr inline explicit divisor(Fixed y) noexcept
+        : m_divisor(y)
+    {
+        assert(y.raw_value() != 0);
+#ifdef FPM_INT128
+        if constexpr (use_multiplier) {
+            // For a dividend below 2**BaseBits, the quotient is exact with a multiplier of
+            // ceil(2**(F + RoundingBits + shift) / |y|) as long as 2**shift >= 2**BaseBits * |y|.
+            const std::uint64_t y_abs = detail::magnitude(y);
+            m_shift = BaseBits + static_cast<unsigned int>(std::bit_width(y_abs));
+
+            // Long division of 2**k by |y|, keeping the remainder for the ceiling
+            const unsigned int k = F + RoundingBits + m_shift;
+            uint128_t quotient = 0, remainder = 0;
+            for (unsigned int i = 0; i <= k; ++i) {
+                remainder = (remainder << 1) + ((i == 0) ? 1 : 0);
+                quotient <<= 1;
+                if (remainder >= y_abs) {
+                    remainder -= y_abs;
+                    quotient |= 1;
+                }
+            }
+            m_multiplier = static_cast<multiplier_type>(quotient + ((remainder != 0) ? 1 : 0));
+        }
+#endif
+    }
+
+    /// Returns the fixed-point number to divide by.
+    [[nodiscard]] constexpr inline Fixed value() const noexcept
+    {
+        return m_divisor;
+    }
+
+    [[nodiscard]] friend constexpr inline Fixed operator/(Fixed x, const divisor& y) noexcept
+    {
+#ifdef FPM_INT128
+        if constexpr (use_multiplier) {
+            const std::uint64_t a = detail::magnitude(x);
+            uint128_t q;
+            if constexpr (std::is_same_v<multiplier_type, std::uint64_t>) {
+                q = (static_cast<uint128_t>(a) * y.m_multiplier) >> y.m_shift;
+            } else {
+                // floor(a * multiplier / 2**64) in 128 bits, with the low bits for small shifts
+                const uint128_t low = static_cast<uint128_t>(a) * static_cast<std::uint64_t>(y.m_multiplier);
+                const uint128_t high = static_cast<uint128_t>(a) * static_cast<std::uint64_t>(y.m_multiplier >> 64) + (low >> 64);
+                q = (y.m_shift >= 64) ? (high >> (y.m_shift - 64)) :
+                    (high << (64 - y.m_shift)) | (static_cast<std::uint64_t>(low) >> y.m_shift);
+            }
+            if (RoundingBits == 1) {
+                q = (q + 1) >> 1;
+            }
+            const I value = static_cast<I>(q);
+            const bool negative = (x.raw_value() < 0) != (y.m_divisor.raw_value() < 0);
+            return Fixed::from_raw_value(static_cast<B>(negative ? -value : value));
+        }
+#endif
+        return x / y.m_divisor;
+    }
+
+    constexpr inline friend Fixed& operator/=(Fixed& x, const divisor& y) noexcept
+    {
+        return x = x / y;
+    }
+
+private:
+    Fixed m_divisor;
+    multiplier_type m_multiplier = 0;
+    unsigned int m_shift = 0;
+};
+
+template <typename B, typename I, unsigned int F, auto R, typename T> requires std::is_integral_v<T>
 [[nodiscard]] constexpr fixed<B, I, F, R> pow(fixed<B, I, F, R> base, T exp) noexcept
 {
     using Fixed = fixed<B, I, F, R>;
@@ -257,7 +464,7 @@ template <typename B, typename I, unsigned int F, bool R, typename T> requires s
     return result;
 }
 
-template <typename B, typename I, unsigned int F, bool R>
+template <typename B, typename I, unsigned int F, auto R>
 [[nodiscard]] constexpr fixed<B, I, F, R> pow(fixed<B, I, F, R> base, fixed<B, I, F, R> exp) noexcept
 {
     using Fixed = fixed<B, I, F, R>;
@@ -268,7 +475,7 @@ template <typename B, typename I, unsigned int F, bool R>
     }
 
     if (exp < Fixed(0)) {
-        return 1 / pow(base, -exp);
+        return reciprocal(pow(base, -exp));
     }
 
     constexpr auto FRAC = B(1) << F;
@@ -284,33 +491,12 @@ template <typename B, typename I, unsigned int F, bool R>
     return exp2(log2(base) * exp);
 }
 
-template <typename B, typename I, unsigned int F, bool R>
-[[nodiscard]] constexpr fixed<B, I, F, R> exp(fixed<B, I, F, R> x) noexcept
-{
-    using Fixed = fixed<B, I, F, R>;
-    if (x < Fixed(0)) {
-        return 1 / exp(-x);
-    }
-    constexpr auto FRAC = B(1) << F;
-    const B x_int = x.raw_value() / FRAC;
-    x -= x_int;
-    assert(x >= Fixed(0) && x < Fixed(1));
-
-    constexpr auto fA = Fixed::template from_fixed_point<63>( 128239257017632854ll); // 1.3903728105644451e-2
-    constexpr auto fB = Fixed::template from_fixed_point<63>( 320978614890280666ll); // 3.4800571158543038e-2
-    constexpr auto fC = Fixed::template from_fixed_point<63>(1571680799599592947ll); // 1.7040197373796334e-1
-    constexpr auto fD = Fixed::template from_fixed_point<63>(4603349000587966862ll); // 4.9909609871464493e-1
-    constexpr auto fE = Fixed::template from_fixed_point<62>(4612052447974689712ll); // 1.0000794567422495
-    constexpr auto fF = Fixed::template from_fixed_point<63>(9223361618412247875ll); // 9.9999887043019773e-1
-    return pow(Fixed::e(), x_int) * (((((fA * x + fB) * x + fC) * x + fD) * x + fE) * x + fF);
-}
-
-template <typename B, typename I, unsigned int F, bool R>
+template <typename B, typename I, unsigned int F, auto R>
 [[nodiscard]] constexpr fixed<B, I, F, R> exp2(fixed<B, I, F, R> x) noexcept
 {
     using Fixed = fixed<B, I, F, R>;
     if (x < Fixed(0)) {
-        return 1 / exp2(-x);
+        return reciprocal(exp2(-x));
     }
     constexpr auto FRAC = B(1) << F;
     const B x_int = x.raw_value() / FRAC;
@@ -326,107 +512,15 @@ template <typename B, typename I, unsigned int F, bool R>
     return Fixed(1 << x_int) * (((((fA * x + fB) * x + fC) * x + fD) * x + fE) * x + fF);
 }
 
-template <typename B, typename I, unsigned int F, bool R>
+template <typename B, typename I, unsigned int F, auto R>
 [[nodiscard]] constexpr inline fixed<B, I, F, R> expm1(fixed<B, I, F, R> x) noexcept
 {
     return exp(x) - 1;
 }
 
-template <typename B, typename I, unsigned int F, bool R>
-[[nodiscard]] constexpr fixed<B, I, F, R> log2(fixed<B, I, F, R> x) noexcept
-{
-    using Fixed = fixed<B, I, F, R>;
-    assert(x > Fixed(0));
-
-    // Normalize input to the [1:2] domain
-    B value = x.raw_value();
-    const long highest = detail::find_highest_bit(value);
-    if (highest >= F) {
-        value >>= (highest - F);
-    } else {
-        value <<= (F - highest);
-    }
-    x = Fixed::from_raw_value(value);
-    assert(x >= Fixed(1) && x < Fixed(2));
-
-    constexpr auto fA = Fixed::template from_fixed_point<63>(  413886001457275979ll); //  4.4873610194131727e-2
-    constexpr auto fB = Fixed::template from_fixed_point<63>(-3842121857793256941ll); // -4.1656368651734915e-1
-    constexpr auto fC = Fixed::template from_fixed_point<62>( 7522345947206307744ll); //  1.6311487636297217
-    constexpr auto fD = Fixed::template from_fixed_point<61>(-8187571043052183818ll); // -3.5507929249026341
-    constexpr auto fE = Fixed::template from_fixed_point<60>( 5870342889289496598ll); //  5.0917108110420042
-    constexpr auto fF = Fixed::template from_fixed_point<61>(-6457199832668582866ll); // -2.8003640347009253
-    return Fixed(highest - F) + (((((fA * x + fB) * x + fC) * x + fD) * x + fE) * x + fF);
-}
-
-template <typename B, typename I, unsigned int F, bool R>
-[[nodiscard]] constexpr inline fixed<B, I, F, R> log(fixed<B, I, F, R> x) noexcept
-{
-    using Fixed = fixed<B, I, F, R>;
-    return log2(x) / log2(Fixed::e());
-}
-
-template <typename B, typename I, unsigned int F, bool R>
-[[nodiscard]] constexpr inline fixed<B, I, F, R> log10(fixed<B, I, F, R> x) noexcept
-{
-    using Fixed = fixed<B, I, F, R>;
-    return log2(x) / log2(Fixed(10));
-}
-
-template <typename B, typename I, unsigned int F, bool R>
-[[nodiscard]] constexpr inline fixed<B, I, F, R> log1p(fixed<B, I, F, R> x) noexcept
-{
-    return log(1 + x);
-}
-
-template <typename B, typename I, unsigned int F, bool R>
-[[nodiscard]] constexpr fixed<B, I, F, R> cbrt(fixed<B, I, F, R> x) noexcept
-{
-    using Fixed = fixed<B, I, F, R>;
-
-    if (x == Fixed(0)) {
-        return x;
-    }
-    if (x < Fixed(0)) {
-        return -cbrt(-x);
-    }
-    assert(x >= Fixed(0));
-
-    // Finding the cube root of an integer, taken from Hacker's Delight,
-    // based on the square root algorithm.
-
-    // We start at the greatest power of eight that's less than the argument.
-    int ofs = ((detail::find_highest_bit(x.raw_value()) + 2*F) / 3 * 3);
-    I num = I{x.raw_value()};
-    I res = 0;
-
-    const auto do_round = [&] {
-        for (; ofs >= 0; ofs -= 3) {
-            res += res;
-            const I val = (3*res*(res + 1) + 1) << ofs;
-            if (num >= val) {
-                num -= val;
-                res++;
-            }
-        }
-    };
-
-    // We should shift by 2*F (since there are two multiplications), but that
-    // could overflow even the intermediate type, so we have to split the
-    // algorithm up in two rounds of F bits each. Each round will deplete
-    // 'num' digit by digit, so after a round we can shift it again.
-    num <<= F;
-    ofs -= F;
-    do_round();
-
-    num <<= F;
-    ofs += F;
-    do_round();
-
-    return Fixed::from_raw_value(static_cast<B>(res));
-}
-
-template <typename B, typename I, unsigned int F, bool R>
-[[nodiscard]] constexpr fixed<B, I, F, R> sqrt(fixed<B, I, F, R> x) noexcept
+/// Calculates the square root one result bit at a time, rounded to nearest. sqrt() gives the same results faster.
+template <typename B, typename I, unsigned int F, auto R>
+[[nodiscard]] constexpr fixed<B, I, F, R> sqrt_exact(fixed<B, I, F, R> x) noexcept
 {
     using Fixed = fixed<B, I, F, R>;
 
@@ -460,29 +554,32 @@ template <typename B, typename I, unsigned int F, bool R>
     return Fixed::from_raw_value(static_cast<B>(res));
 }
 
-template <typename B, typename I, unsigned int F, bool R>
-[[nodiscard]] constexpr inline fixed<B, I, F, R> hypot(fixed<B, I, F, R> x, fixed<B, I, F, R> y) noexcept
-{
-    assert(x != 0 || y != 0);
-    return sqrt(x*x + y*y);
-}
+namespace detail {
 
-template <typename B, typename I, unsigned int F, bool R>
-[[nodiscard]] constexpr fixed<B, I, F, R> sin(fixed<B, I, F, R> x) noexcept
+/// Turns x from the [0..2*PI] domain into the [0..4] domain.
+template <typename B, typename I, unsigned int F, auto R>
+[[nodiscard]] constexpr fixed<B, I, F, R> sin_reduce(fixed<B, I, F, R> x) noexcept
 {
-    // This sine uses a fifth-order curve-fitting approximation originally
-    // described by Jasper Vijn on coranac.com which has a worst-case
-    // relative error of 0.07% (over [-pi:pi]).
     using Fixed = fixed<B, I, F, R>;
-
-    // Turn x from [0..2*PI] domain into [0..4] domain
+    constexpr divisor<Fixed> half_pi(Fixed::half_pi());
     x = fmod(x, Fixed::two_pi());
-    x = x / Fixed::half_pi();
+    x = x / half_pi;
 
     // Take x modulo one rotation, so [-4..+4].
     if (x < Fixed(0)) {
         x += Fixed(4);
     }
+    return x;
+}
+
+/// Calculates sin(x * PI/2) for x in [0..4].
+template <typename B, typename I, unsigned int F, auto R>
+[[nodiscard]] constexpr fixed<B, I, F, R> sin_quadrant(fixed<B, I, F, R> x) noexcept
+{
+    // This sine uses a fifth-order curve-fitting approximation originally
+    // described by Jasper Vijn on coranac.com which has a worst-case
+    // relative error of 0.07% (over [-pi:pi]).
+    using Fixed = fixed<B, I, F, R>;
 
     int sign = +1;
     if (x > Fixed(2)) {
@@ -500,7 +597,15 @@ template <typename B, typename I, unsigned int F, bool R>
     return sign * x * (Fixed::pi() - x2*(Fixed::two_pi() - 5 - x2*(Fixed::pi() - 3)))/2;
 }
 
-template <typename B, typename I, unsigned int F, bool R>
+}
+
+template <typename B, typename I, unsigned int F, auto R>
+[[nodiscard]] constexpr fixed<B, I, F, R> sin(fixed<B, I, F, R> x) noexcept
+{
+    return detail::sin_quadrant(detail::sin_reduce(x));
+}
+
+template <typename B, typename I, unsigned int F, auto R>
 [[nodiscard]] constexpr inline fixed<B, I, F, R> cos(fixed<B, I, F, R> x) noexcept
 {
     using Fixed = fixed<B, I, F, R>;
@@ -511,7 +616,19 @@ template <typename B, typename I, unsigned int F, bool R>
     }    
 }
 
-template <typename B, typename I, unsigned int F, bool R>
+/// Calculates sin(x) and cos(x) with a single range reduction.
+/// The sine is identical to sin(x). The cosine is evaluated a quarter turn further along in the reduced
+/// domain, so it can differ from cos(x) in the last bit, but it doesn't overflow for any x.
+template <typename B, typename I, unsigned int F, auto R>
+[[nodiscard]] constexpr std::pair<fixed<B, I, F, R>, fixed<B, I, F, R>> sincos(fixed<B, I, F, R> x) noexcept
+{
+    using Fixed = fixed<B, I, F, R>;
+    const Fixed t = detail::sin_reduce(x);
+    const Fixed u = (t >= Fixed(3)) ? t - Fixed(3) : t + Fixed(1);
+    return { detail::sin_quadrant(t), detail::sin_quadrant(u) };
+}
+
+template <typename B, typename I, unsigned int F, auto R>
 [[nodiscard]] constexpr inline fixed<B, I, F, R> tan(fixed<B, I, F, R> x) noexcept
 {
     auto cx = cos(x);
@@ -525,8 +642,148 @@ template <typename B, typename I, unsigned int F, bool R>
 
 namespace detail {
 
+/// Calculates sin(x) for x in [0, pi/2] with a Taylor series, for use in constant expressions.
+[[nodiscard]] constexpr double sin_taylor(double x) noexcept
+{
+    double term = x, sum = x;
+    for (int n = 2; n < 32; n += 2) {
+        term *= -x * x / (n * (n + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+/// Quarter-wave table of sin(x) for x in [0, pi/2] in Size steps, as Q2.30 numbers.
+template <std::size_t Size>
+inline constexpr auto sin_table = [] {
+    std::array<std::int32_t, Size + 1> table{};
+    for (std::size_t i = 0; i <= Size; ++i) {
+        const double x = 1.57079632679489661923 * static_cast<double>(i) / static_cast<double>(Size);
+        table[i] = static_cast<std::int32_t>(sin_taylor(x) * (1 << 30) + 0.5);
+    }
+    return table;
+}();
+
+/// Calculates the sine of a binary angle (2**64 is one full turn) as a Q2.30 number, by interpolating
+/// between the entries of sin_table<Size>. Order selects nearest (0), linear (1) or cubic Hermite (3)
+/// interpolation. The cubic interpolation takes the derivatives from the same table, since sin' = cos.
+template <std::size_t Size, unsigned int Order>
+[[nodiscard]] constexpr std::int32_t lut_sin(std::uint64_t phase) noexcept
+{
+    static_assert(Size >= 2 && Size <= (std::size_t{1} << 32) && std::has_single_bit(Size), "Size must be a power of two");
+    static_assert(Order == 0 || Order == 1 || Order == 3, "Order must be 0 (nearest), 1 (linear) or 3 (cubic)");
+
+    constexpr auto& table = sin_table<Size>;
+    constexpr unsigned int shift = 62 - std::countr_zero(Size);
+    constexpr std::uint64_t quarter_mask = (std::uint64_t{1} << 62) - 1;
+
+    // Reduce to the first quadrant. Mirroring is done with the one's complement so that the offset
+    // stays below a quarter turn, which is off by 2**-64 turns.
+    const auto quadrant = static_cast<unsigned int>(phase >> 62);
+    std::uint64_t offset = phase & quarter_mask;
+    if (quadrant & 1) {
+        offset = quarter_mask - offset;
+    }
+
+    std::int64_t y;
+    if constexpr (Order == 0) {
+        y = table[(offset + (std::uint64_t{1} << (shift - 1))) >> shift];
+    } else {
+        const auto i = static_cast<std::size_t>(offset >> shift);
+        const std::int64_t w = static_cast<std::int64_t>((offset & ((std::uint64_t{1} << shift) - 1)) >> (shift - 30));
+        const std::int64_t y0 = table[i], y1 = table[i + 1];
+        if constexpr (Order == 1) {
+            y = y0 + (((y1 - y0) * w + (1 << 29)) >> 30);
+        } else {
+            // Step size in radians, to scale the derivatives to the table index
+            constexpr auto step = static_cast<std::int64_t>(1.57079632679489661923 / Size * (1 << 30) + 0.5);
+            const std::int64_t m0 = (table[Size - i] * step) >> 30;
+            const std::int64_t m1 = (table[Size - i - 1] * step) >> 30;
+            const std::int64_t c2 = 3 * (y1 - y0) - 2 * m0 - m1;
+            const std::int64_t c3 = m0 + m1 - 2 * (y1 - y0);
+            y = y0 + ((w * (m0 + ((w * (c2 + ((w * c3) >> 30))) >> 30))) >> 30);
+        }
+    }
+    return static_cast<std::int32_t>((quadrant & 2) ? -y : y);
+}
+
+/// Converts an angle in radians to a binary angle, where 2**64 is one full turn, multiplying in the signed type W.
+/// This multiplies by 2/pi with as many bits as W allows, so the quadrant ends up in the two highest bits.
+template <typename W, typename B, typename I, unsigned int F, auto R>
+[[nodiscard]] constexpr std::uint64_t binary_angle_in(fixed<B, I, F, R> x) noexcept
+{
+    static_assert(sizeof(W) > sizeof(B), "W must be wider than the base type");
+    constexpr unsigned int G = ((sizeof(W) - sizeof(B)) * 8 - 1 < 63) ? (sizeof(W) - sizeof(B)) * 8 - 1 : 63;
+    constexpr auto two_over_pi = static_cast<std::uint64_t>(0.636619772367581343076 * static_cast<double>(std::uint64_t{1} << G) + 0.5);
+
+    const W phase = static_cast<W>(x.raw_value()) * static_cast<W>(two_over_pi);
+    if constexpr (F + G >= 62) {
+        return static_cast<std::uint64_t>(phase >> (F + G - 62));
+    } else {
+        return static_cast<std::uint64_t>(phase) << (62 - F - G);
+    }
+}
+
+/// Converts an angle in radians to a binary angle, multiplying in at least 64 bits.
+template <typename B, typename I, unsigned int F, auto R>
+[[nodiscard]] constexpr std::uint64_t binary_angle(fixed<B, I, F, R> x) noexcept
+{
+    return binary_angle_in<std::conditional_t<(sizeof(I) > sizeof(std::int64_t)), I, std::int64_t>>(x);
+}
+
+/// Converts a Q2.30 number to the fixed-point type.
+template <typename Fixed>
+[[nodiscard]] constexpr Fixed from_q30(std::int32_t y) noexcept
+{
+    using B = typename Fixed::base_type;
+    constexpr unsigned int F = Fixed::fraction_bits;
+    if constexpr (F >= 30) {
+        return Fixed::from_raw_value(static_cast<B>(static_cast<B>(y) << (F - 30)));
+    } else {
+        // Round like the arithmetic operators
+        return Fixed::from_raw_value(static_cast<B>(detail::shift_right<Fixed::rounding_mode>(y, 30 - F)));
+    }
+}
+
+}
+
+namespace lut {
+
+/// Calculates sin(x) with a compile-time quarter-wave table of Size entries (a power of two), interpolated with the
+/// given Order: 0 (nearest entry), 1 (linear) or 3 (cubic). The default has a worst-case absolute error of 5e-6,
+/// compared to 7e-4 for fpm::sin. The table is generated at compile time and takes 4 * (Size + 1) bytes.
+template <std::size_t Size = 256, unsigned int Order = 1, typename B, typename I, unsigned int F, auto R> requires std::is_signed_v<B>
+[[nodiscard]] constexpr fixed<B, I, F, R> sin(fixed<B, I, F, R> x) noexcept
+{
+    return detail::from_q30<fixed<B, I, F, R>>(detail::lut_sin<Size, Order>(detail::binary_angle(x)));
+}
+
+/// Calculates cos(x) like fpm::lut::sin.
+template <std::size_t Size = 256, unsigned int Order = 1, typename B, typename I, unsigned int F, auto R> requires std::is_signed_v<B>
+[[nodiscard]] constexpr fixed<B, I, F, R> cos(fixed<B, I, F, R> x) noexcept
+{
+    // Add a quarter turn, which wraps around without overflowing
+    return detail::from_q30<fixed<B, I, F, R>>(detail::lut_sin<Size, Order>(detail::binary_angle(x) + (std::uint64_t{1} << 62)));
+}
+
+/// Calculates sin(x) and cos(x) like fpm::lut::sin and fpm::lut::cos, with a single range reduction.
+template <std::size_t Size = 256, unsigned int Order = 1, typename B, typename I, unsigned int F, auto R> requires std::is_signed_v<B>
+[[nodiscard]] constexpr std::pair<fixed<B, I, F, R>, fixed<B, I, F, R>> sincos(fixed<B, I, F, R> x) noexcept
+{
+    using Fixed = fixed<B, I, F, R>;
+    const std::uint64_t phase = detail::binary_angle(x);
+    return {
+        detail::from_q30<Fixed>(detail::lut_sin<Size, Order>(phase)),
+        detail::from_q30<Fixed>(detail::lut_sin<Size, Order>(phase + (std::uint64_t{1} << 62)))
+    };
+}
+
+}
+
+namespace detail {
+
 /// Calculates atan(x) assuming that x is in the range [0,1].
-template <typename B, typename I, unsigned int F, bool R>
+template <typename B, typename I, unsigned int F, auto R>
 [[nodiscard]] constexpr inline fixed<B, I, F, R> atan_sanitized(fixed<B, I, F, R> x) noexcept
 {
     using Fixed = fixed<B, I, F, R>;
@@ -546,7 +803,7 @@ template <typename B, typename I, unsigned int F, bool R>
 /// If q = y/x and q > 1, atan(q) would calculate atan(1/q) as intermediate step
 /// anyway. We can shortcut that here and avoid the loss of information, thus
 /// improving the accuracy of atan(y/x) for very small x.
-template <typename B, typename I, unsigned int F, bool R>
+template <typename B, typename I, unsigned int F, auto R>
 [[nodiscard]] constexpr inline fixed<B, I, F, R> atan_div(fixed<B, I, F, R> y, fixed<B, I, F, R> x) noexcept
 {
     using Fixed = fixed<B, I, F, R>;
@@ -575,7 +832,7 @@ template <typename B, typename I, unsigned int F, bool R>
 
 }
 
-template <typename B, typename I, unsigned int F, bool R> requires std::is_signed_v<B>
+template <typename B, typename I, unsigned int F, auto R> requires std::is_signed_v<B>
 [[nodiscard]] constexpr inline fixed<B, I, F, R> atan(fixed<B, I, F, R> x) noexcept
 {
     using Fixed = fixed<B, I, F, R>;
@@ -586,13 +843,13 @@ template <typename B, typename I, unsigned int F, bool R> requires std::is_signe
 
     if (x > Fixed(1))
     {
-        return Fixed::half_pi() - detail::atan_sanitized(Fixed(1) / x);
+        return Fixed::half_pi() - detail::atan_sanitized(reciprocal(x));
     }
 
     return detail::atan_sanitized(x);
 }
 
-template <typename B, typename I, unsigned int F, bool R>
+template <typename B, typename I, unsigned int F, auto R>
 [[nodiscard]] constexpr inline fixed<B, I, F, R> asin(fixed<B, I, F, R> x) noexcept
 {
     using Fixed = fixed<B, I, F, R>;
@@ -606,7 +863,7 @@ template <typename B, typename I, unsigned int F, bool R>
     return detail::atan_div(x, sqrt(yy));
 }
 
-template <typename B, typename I, unsigned int F, bool R>
+template <typename B, typename I, unsigned int F, auto R>
 [[nodiscard]] constexpr inline fixed<B, I, F, R> acos(fixed<B, I, F, R> x) noexcept
 {
     using Fixed = fixed<B, I, F, R>;
@@ -620,7 +877,7 @@ template <typename B, typename I, unsigned int F, bool R>
     return Fixed(2)*detail::atan_div(sqrt(yy), Fixed(1) + x);
 }
 
-template <typename B, typename I, unsigned int F, bool R>
+template <typename B, typename I, unsigned int F, auto R>
 [[nodiscard]] constexpr inline fixed<B, I, F, R> atan2(fixed<B, I, F, R> y, fixed<B, I, F, R> x) noexcept
 {
     using Fixed = fixed<B, I, F, R>;
@@ -639,6 +896,947 @@ template <typename B, typename I, unsigned int F, bool R>
     return ret;
 }
 
+namespace detail {
+
+/// Calculates e**x for x in [0, 1] with a Taylor series, for use in constant expressions.
+[[nodiscard]] constexpr double exp_taylor(double x) noexcept
+{
+    double term = 1, sum = 1;
+    for (int n = 1; n < 32; ++n) {
+        term *= x / n;
+        sum += term;
+    }
+    return sum;
+}
+
+/// Calculates 2**x for x in [0, 1] with a Taylor series, for use in constant expressions.
+[[nodiscard]] constexpr double exp2_taylor(double x) noexcept
+{
+    return exp_taylor(x * 0.693147180559945309417);
+}
+
+/// Calculates log2(x) for x in [1, 2] with the series of atanh((x - 1) / (x + 1)), for use in constant expressions.
+[[nodiscard]] constexpr double log2_taylor(double x) noexcept
+{
+    const double s = (x - 1) / (x + 1);
+    double term = s, sum = 0;
+    for (int n = 1; n < 64; n += 2) {
+        sum += term / n;
+        term *= s * s;
+    }
+    return sum * 2.88539008177792681472; // 2 / ln(2)
+}
+
+/// Calculates sin(sqrt(v) * pi/2) / sqrt(v) for v in [0, 1], for use in constant expressions.
+/// sin(u * pi/2) is u times this function of u**2.
+[[nodiscard]] constexpr double sin_quarter_taylor(double v) noexcept
+{
+    const double z = 2.46740110027233965471 * v; // (pi/2)**2 * v
+    double term = 1.57079632679489661923, sum = term;
+    for (int n = 2; n < 40; n += 2) {
+        term *= -z / (n * (n + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+/// Calculates sqrt(x) with Newton's method, for use in constant expressions.
+[[nodiscard]] constexpr double sqrt_newton(double x) noexcept
+{
+    double r = (x > 1) ? x : 1;
+    for (int i = 0; i < 64 && x > 0; ++i) {
+        r = (r + x / r) / 2;
+    }
+    return (x > 0) ? r : 0;
+}
+
+/// Calculates cbrt(x) with Newton's method, for use in constant expressions.
+[[nodiscard]] constexpr double cbrt_newton(double x) noexcept
+{
+    double r = (x > 1) ? x : 1;
+    for (int i = 0; i < 128 && x > 0; ++i) {
+        r = (2 * r + x / (r * r)) / 3;
+    }
+    return (x > 0) ? r : 0;
+}
+
+/// Calculates atan(sqrt(v)) / sqrt(v) for v in [0, 1], for use in constant expressions.
+/// atan(z) is z times this function of z**2.
+[[nodiscard]] constexpr double atan_quarter_taylor(double v) noexcept
+{
+    if (v <= 0) {
+        return 1;
+    }
+    // Halve the angle twice, so that the series converges quickly
+    const double z = sqrt_newton(v);
+    double w = z / (1 + sqrt_newton(1 + z * z));
+    w = w / (1 + sqrt_newton(1 + w * w));
+    double term = w, sum = 0;
+    for (int n = 1; n < 40; n += 2) {
+        sum += term / n;
+        term *= -w * w;
+    }
+    return 4 * sum / z;
+}
+
+/// The number of Chebyshev coefficients that are calculated for the polynomials of fpm::fast and fpm::precise
+inline constexpr std::size_t chebyshev_size = 32;
+
+/// Chebyshev series of Func over [Lo, Lo + 1], in the variable y = 2 * (x - Lo) - 1, interpolated at chebyshev_size nodes.
+template <double (*Func)(double), int Lo>
+inline constexpr auto chebyshev_series = [] {
+    constexpr std::size_t N = chebyshev_size;
+    std::array<double, N> c{};
+    for (std::size_t j = 0; j < N; ++j) {
+        // The node cos(theta), with the cosine as a shifted sine
+        const double theta = 3.14159265358979323846 * (static_cast<double>(j) + 0.5) / N;
+        const double y = sin_taylor(1.57079632679489661923 - theta);
+        const double value = Func(Lo + (y + 1) / 2);
+
+        // Chebyshev polynomials T_k(y) = cos(k * theta)
+        double t0 = 1, t1 = y;
+        c[0] += value;
+        for (std::size_t k = 1; k < N; ++k) {
+            c[k] += value * t1;
+            const double t2 = 2 * y * t1 - t0;
+            t0 = t1;
+            t1 = t2;
+        }
+    }
+    for (std::size_t k = 0; k < N; ++k) {
+        c[k] *= ((k == 0) ? 1.0 : 2.0) / N;
+    }
+    return c;
+}();
+
+/// Returns the lowest degree for which the Chebyshev series of Func has an error below 2**-(bits + 1).
+/// The error of a truncated series is at most the sum of the magnitudes of the dropped coefficients.
+template <double (*Func)(double), int Lo>
+[[nodiscard]] constexpr std::size_t chebyshev_degree(unsigned int bits) noexcept
+{
+    const auto& c = chebyshev_series<Func, Lo>;
+    const double target = 1.0 / static_cast<double>(std::uint64_t{1} << (bits + 1));
+    double tail = 0;
+    for (std::size_t n = chebyshev_size - 1; n > 0; --n) {
+        tail += (c[n] < 0) ? -c[n] : c[n];
+        if (tail > target) {
+            return n;
+        }
+    }
+    return 0;
+}
+
+/// The signed integer type in which polynomials are evaluated for a result accurate to Bits fraction bits.
+/// Values in it have poly_fraction_bits fraction bits and magnitudes below 4.
+#ifdef FPM_INT128
+template <unsigned int Bits>
+using poly_type = std::conditional_t<(Bits <= 26), std::int64_t, ::fpm::int128_t>;
+#else
+template <unsigned int Bits>
+using poly_type = std::int64_t;
+#endif
+
+template <typename W>
+inline constexpr unsigned int poly_fraction_bits = sizeof(W) * 4 - 2;
+
+/// Coefficients of the Chebyshev series of Func, truncated for an error below 2**-Bits, as a polynomial in y = 2 * (x - Lo) - 1.
+/// They're stored in W, with poly_fraction_bits<W> fraction bits, lowest order first.
+template <typename W, double (*Func)(double), int Lo, unsigned int Bits>
+inline constexpr auto poly_coefficients = [] {
+    constexpr std::size_t D = chebyshev_degree<Func, Lo>(Bits);
+    const auto& c = chebyshev_series<Func, Lo>;
+
+    // Sum the monomial coefficients of the Chebyshev polynomials T_0 to T_D
+    std::array<double, D + 1> a{}, t0{}, t1{};
+    t0[0] = 1;
+    a[0] = c[0];
+    if constexpr (D > 0) {
+        t1[1] = 1;
+        a[1] = c[1];
+    }
+    for (std::size_t k = 2; k <= D; ++k) {
+        std::array<double, D + 1> t2{};
+        for (std::size_t j = 0; j <= D; ++j) {
+            t2[j] = ((j > 0) ? 2 * t1[j - 1] : 0.0) - t0[j];
+            a[j] += c[k] * t2[j];
+        }
+        t0 = t1;
+        t1 = t2;
+    }
+
+    // The magnitudes of the coefficients add up to less than 3 for the functions here, which keeps
+    // every step of Horner's method below 4 for |y| <= 1
+    constexpr double scale = static_cast<double>(std::uint64_t{1} << poly_fraction_bits<W>);
+    std::array<W, D + 1> result{};
+    W at_lo = 0;
+    for (std::size_t j = 0; j <= D; ++j) {
+        result[j] = static_cast<W>(a[j] * scale + ((a[j] < 0) ? -0.5 : 0.5));
+        at_lo += (j % 2 == 0) ? result[j] : -result[j];
+    }
+    // Make the polynomial exact at y = -1, where Horner's method doesn't round, at the cost of at most
+    // doubling the error. This makes exp2 of integers and log2 of powers of two exact.
+    const double lo = Func(Lo) * scale;
+    result[0] += static_cast<W>(lo + ((lo < 0) ? -0.5 : 0.5)) - at_lo;
+    return result;
+}();
+
+/// Evaluates a polynomial with Horner's method at y, with |y| <= 1. Both have poly_fraction_bits<W> fraction bits.
+template <typename W, std::size_t N>
+[[nodiscard]] constexpr W horner(const std::array<W, N>& c, W y) noexcept
+{
+    constexpr unsigned int P = poly_fraction_bits<W>;
+    W result = c[N - 1];
+    for (std::size_t i = N - 1; i > 0; --i) {
+        result = ((result * y + (W{1} << (P - 1))) >> P) + c[i - 1];
+    }
+    return result;
+}
+
+/// Converts a non-negative number with F fraction bits to P fraction bits, truncating bits that are dropped.
+template <unsigned int P, unsigned int F, typename W>
+[[nodiscard]] constexpr W rescale(W value) noexcept
+{
+    if constexpr (P >= F) {
+        return value << (P - F);
+    } else {
+        return value >> (F - P);
+    }
+}
+
+/// Returns value * 2**exponent as Fixed, where value has P fraction bits. This rounds with the rounding mode of Fixed.
+template <typename Fixed, unsigned int P, typename W>
+[[nodiscard]] constexpr Fixed from_poly(W value, std::int64_t exponent) noexcept
+{
+    using B = typename Fixed::base_type;
+    constexpr std::int64_t bits = sizeof(W) * 8;
+    const std::int64_t shift = static_cast<std::int64_t>(P) - Fixed::fraction_bits - exponent;
+    if (shift > 0) {
+        // Shifting everything out leaves only the rounding
+        const auto s = static_cast<unsigned int>((shift < bits - 1) ? shift : bits - 1);
+        return Fixed::from_raw_value(static_cast<B>(shift_right<Fixed::rounding_mode>(value, s)));
+    }
+    return Fixed::from_raw_value(static_cast<B>(value << -shift));
+}
+
+/// Calculates 2**x with a polynomial that's accurate to Bits fraction bits.
+template <unsigned int Bits, typename B, typename I, unsigned int F, auto R>
+[[nodiscard]] constexpr fixed<B, I, F, R> exp2_poly(fixed<B, I, F, R> x) noexcept
+{
+    using Fixed = fixed<B, I, F, R>;
+    using W = poly_type<Bits>;
+    using U = std::make_unsigned_t<B>;
+    constexpr unsigned int P = poly_fraction_bits<W>;
+    constexpr auto& c = poly_coefficients<W, &exp2_taylor, 0, Bits>;
+
+    // Split x into an integer, which only scales the result, and a fraction in [0, 1)
+    const std::int64_t n = x.raw_value() >> F;
+    assert(n < static_cast<std::int64_t>(Fixed::integral_bits) - 1);
+    const W f = static_cast<W>(static_cast<U>(x.raw_value()) & ((U{1} << (F - 1) << 1) - 1));
+
+    const W y = rescale<P + 1, F>(f) - (W{1} << P);
+    return from_poly<Fixed, P>(horner(c, y), n);
+}
+
+/// Calculates log2(x) with a polynomial that's accurate to Bits fraction bits.
+template <unsigned int Bits, typename B, typename I, unsigned int F, auto R>
+[[nodiscard]] constexpr fixed<B, I, F, R> log2_poly(fixed<B, I, F, R> x) noexcept
+{
+    using Fixed = fixed<B, I, F, R>;
+    using W = poly_type<Bits>;
+    using U = std::make_unsigned_t<B>;
+    constexpr unsigned int P = poly_fraction_bits<W>;
+    constexpr auto& c = poly_coefficients<W, &log2_taylor, 1, Bits>;
+    assert(x > Fixed(0));
+
+    // Normalize x to m * 2**e, with m in [1, 2)
+    const int highest = std::bit_width(static_cast<U>(x.raw_value())) - 1;
+    const W m = (highest <= static_cast<int>(P))
+        ? static_cast<W>(x.raw_value()) << (P - highest)
+        : static_cast<W>(x.raw_value()) >> (highest - P);
+
+    const W y = m * 2 - (W{3} << P);
+    const W e = static_cast<W>(highest - static_cast<int>(F));
+    return from_poly<Fixed, P>(horner(c, y) + e * (W{1} << P), 0);
+}
+
+/// The signed integer type in which exp() and the logarithms evaluate, with poly_fraction_bits fraction bits:
+/// at least 64 bits, so that the product of two numbers below 4 fits for the base types up to 32 bits.
+template <typename I>
+using scaled_type = std::conditional_t<(sizeof(I) > sizeof(std::int64_t)), I, std::int64_t>;
+
+/// The number of fraction bits that the polynomial of exp() is accurate to. The polynomial is scaled by up
+/// to the largest power of e, so this is the relative accuracy for every bit of B, up to the limit of W.
+template <typename B, typename W>
+inline constexpr unsigned int exp_bits = [] {
+    constexpr unsigned int bits = sizeof(B) * 8 - 1;
+    constexpr unsigned int limit = (sizeof(W) > sizeof(std::int64_t)) ? 40 : 26;
+    return (bits < limit) ? bits : limit;
+}();
+
+/// The lowest integer n for which e**x with x in [n, n + 1) can be at least half of 2**-F
+template <unsigned int F>
+inline constexpr int exp_lowest = static_cast<int>(-0.693147180559945309417 * (F + 1) - 1);
+
+/// The highest integer n for which e**n fits in the integral bits of B
+template <typename B, unsigned int F>
+inline constexpr int exp_highest = static_cast<int>(0.693147180559945309417 * (sizeof(B) * 8 - F - (std::is_signed_v<B> ? 1 : 0)));
+
+/// e**n as a normalized mantissa and the shift that turns its product with a number with
+/// poly_fraction_bits<W> fraction bits into one with the fraction bits of the result.
+template <typename W>
+struct exp_power
+{
+    W mantissa;             //!< In [1, 2), with poly_fraction_bits<W> fraction bits
+    unsigned int shift;
+};
+
+/// e**n for every integer n from exp_lowest<F> to exp_highest<B, F>
+template <typename B, typename W, unsigned int F>
+inline constexpr auto exp_powers = [] {
+    constexpr unsigned int P = poly_fraction_bits<W>;
+    constexpr int lowest = exp_lowest<F>, highest = exp_highest<B, F>;
+    const double e = exp_taylor(1);
+    std::array<exp_power<W>, highest - lowest + 1> table{};
+    for (int n = lowest; n <= highest; ++n) {
+        double value = 1;
+        for (int i = 0; i < ((n < 0) ? -n : n); ++i) {
+            value *= e;
+        }
+        if (n < 0) {
+            value = 1 / value;
+        }
+
+        // Normalize to [1, 2)
+        int exponent = 0;
+        for (; value >= 2; value /= 2) ++exponent;
+        for (; value < 1; value *= 2) --exponent;
+        auto mantissa = static_cast<W>(value * static_cast<double>(std::uint64_t{1} << P) + 0.5);
+        if (mantissa >> (P + 1) != 0) {
+            mantissa >>= 1;
+            ++exponent;
+        }
+        table[static_cast<std::size_t>(n - lowest)] = { mantissa, static_cast<unsigned int>(static_cast<int>(2 * P - F) - exponent) };
+    }
+    return table;
+}();
+
+/// The number of mantissa bits that index log2_table
+inline constexpr unsigned int log2_table_bits = 7;
+
+/// A reciprocal that takes a mantissa close to 1, and the log2 that this adds back
+template <typename W>
+struct log2_entry
+{
+    W reciprocal;           //!< Of the lowest mantissa with the index, rounded, with poly_fraction_bits<W> fraction bits
+    W log2;                 //!< -log2 of the rounded reciprocal, with poly_fraction_bits<W> fraction bits
+};
+
+/// The entries for the mantissas 1 + i / 2**log2_table_bits
+template <typename W>
+inline constexpr auto log2_table = [] {
+    constexpr unsigned int P = poly_fraction_bits<W>;
+    constexpr std::size_t N = std::size_t{1} << log2_table_bits;
+    constexpr double scale = static_cast<double>(std::uint64_t{1} << P);
+    std::array<log2_entry<W>, N> table{};
+    for (std::size_t i = 0; i < N; ++i) {
+        const double reciprocal = static_cast<double>(N) / static_cast<double>(N + i);
+        const auto rounded = static_cast<W>(reciprocal * scale + 0.5);
+        table[i] = { rounded, static_cast<W>(log2_taylor(scale / static_cast<double>(rounded)) * scale + 0.5) };
+    }
+    return table;
+}();
+
+/// The Taylor coefficients of log2(1 + r) / r, truncated for an error below 2**-Bits for |r| below
+/// 2**-log2_table_bits, with poly_fraction_bits<W> fraction bits, lowest order first.
+template <typename W, unsigned int Bits>
+inline constexpr auto log2_coefficients = [] {
+    constexpr std::size_t D = [] {
+        const double r = 1.0 / static_cast<double>(std::uint64_t{1} << log2_table_bits);
+        const double target = 1.0 / static_cast<double>(std::uint64_t{1} << (Bits + 1));
+        double power = r;
+        std::size_t degree = 0;
+        for (; power / (degree + 1) * 1.44269504088896340736 > target; ++degree) {
+            power *= r;
+        }
+        return degree;
+    }();
+    constexpr double scale = static_cast<double>(std::uint64_t{1} << poly_fraction_bits<W>);
+    std::array<W, D + 1> c{};
+    for (std::size_t k = 0; k <= D; ++k) {
+        const double value = 1.44269504088896340736 / static_cast<double>(k + 1) * scale + 0.5;
+        c[k] = (k % 2 == 0) ? static_cast<W>(value) : -static_cast<W>(value);
+    }
+    return c;
+}();
+
+/// The number of fraction bits that the logarithms are accurate to, for a type with F fraction bits
+template <typename W>
+[[nodiscard]] constexpr unsigned int log2_bits(unsigned int f) noexcept
+{
+    constexpr unsigned int limit = (sizeof(W) > sizeof(std::int64_t)) ? 40 : 26;
+    return (f + 1 < limit) ? f + 1 : limit;
+}
+
+/// Calculates log2(m) for a mantissa m in [1, 2), both with poly_fraction_bits<W> fraction bits. The highest
+/// bits of m select a reciprocal that brings it close to 1, where a short series takes over.
+template <typename W, unsigned int Bits>
+[[nodiscard]] constexpr W log2_mantissa(W m) noexcept
+{
+    constexpr unsigned int P = poly_fraction_bits<W>;
+    constexpr auto& table = log2_table<W>;
+    constexpr auto& c = log2_coefficients<W, Bits>;
+    constexpr W half = W{1} << (P - 1);
+
+    // m * reciprocal = 1 + r, with r in about [0, 2**-log2_table_bits)
+    const auto& entry = table[static_cast<std::size_t>(m >> (P - log2_table_bits)) & (table.size() - 1)];
+    const W r = ((m * entry.reciprocal + half) >> P) - (W{1} << P);
+    W q = c[c.size() - 1];
+    for (std::size_t i = c.size() - 1; i > 0; --i) {
+        q = ((q * r + half) >> P) + c[i - 1];
+    }
+    return entry.log2 + ((q * r + half) >> P);
+}
+
+/// Calculates log2(x) * k, where k has poly_fraction_bits<W> fraction bits and is at most 1.
+/// The integral exponent and the log2 of the mantissa are scaled separately, so that neither product overflows.
+template <typename W, typename B, typename I, unsigned int F, auto R>
+[[nodiscard]] constexpr fixed<B, I, F, R> log2_scaled(fixed<B, I, F, R> x, W k) noexcept
+{
+    using Fixed = fixed<B, I, F, R>;
+    using U = std::make_unsigned_t<B>;
+    constexpr unsigned int P = poly_fraction_bits<W>;
+    assert(x > Fixed(0));
+
+    // Normalize x to m * 2**e, with m in [1, 2)
+    const auto value = static_cast<U>(x.raw_value());
+    const int highest = static_cast<int>(sizeof(U) * 8) - 1 - std::countl_zero(value);
+    const W m = (highest <= static_cast<int>(P))
+        ? static_cast<W>(value) << (P - highest)
+        : static_cast<W>(value >> (highest - P));
+
+    const W e = static_cast<W>(highest - static_cast<int>(F));
+    const W fraction = log2_mantissa<W, log2_bits<W>(F)>(m);
+    return from_poly<Fixed, P>(e * k + ((fraction * k + (W{1} << (P - 1))) >> P), 0);
+}
+
+/// The factors that turn log2 into log and log10
+inline constexpr double ln_2 = 0.693147180559945309417;
+inline constexpr double log10_2 = 0.301029995663981195214;
+
+/// Returns k with poly_fraction_bits<W> fraction bits
+template <typename W>
+[[nodiscard]] constexpr W log2_scale(double k) noexcept
+{
+    return static_cast<W>(k * static_cast<double>(std::uint64_t{1} << poly_fraction_bits<W>) + 0.5);
+}
+
+/// Seeds for 1/sqrt(v) with v in [1/4, 1), indexed by the 8 highest fraction bits of v, with 14 fraction bits.
+/// Each is the mean of 1/sqrt at the ends of its interval, which is within 2**-8 of 1/sqrt(v).
+inline constexpr auto rsqrt_seeds = [] {
+    std::array<std::uint16_t, 192> seeds{};
+    for (std::size_t i = 0; i < seeds.size(); ++i) {
+        const double low = static_cast<double>(i + 64) / 256;
+        const double high = static_cast<double>(i + 65) / 256;
+        seeds[i] = static_cast<std::uint16_t>((1 / sqrt_newton(low) + 1 / sqrt_newton(high)) * 8192 + 0.5);
+    }
+    return seeds;
+}();
+
+/// The number of Newton steps for rsqrt(). Each one about doubles the correct bits, up to the bits(T)/2 - 2
+/// fraction bits of the result. 128-bit numbers start from two steps in 64 bits.
+template <typename T>
+inline constexpr int rsqrt_steps = (sizeof(T) > sizeof(std::uint64_t)) ? 1 : 2;
+
+/// The number of Newton steps for sqrt(), which needs about half of the bits of the result from them
+template <typename T>
+inline constexpr int sqrt_steps = 1;
+
+/// Calculates 1/sqrt(v) for v = m / 2**bits(T) in [1/4, 1), with bits(T)/2 - 2 fraction bits.
+/// Newton's method for 1/sqrt, y' = y * (3 - v * y**2) / 2, needs no division.
+template <int Steps, typename T>
+[[nodiscard]] constexpr T rsqrt_normalized(T m) noexcept
+{
+    constexpr unsigned int h = sizeof(T) * 4;
+    const T v = m >> h;
+    T y;
+    if constexpr (sizeof(T) > sizeof(std::uint64_t)) {
+        // The first steps are as accurate in 64 bits, and much cheaper
+        y = T{rsqrt_normalized<rsqrt_steps<std::uint64_t>>(static_cast<std::uint64_t>(m >> (h * 2 - 64)))} << (h - 32);
+    } else {
+        y = T{rsqrt_seeds[static_cast<std::size_t>(v >> (h - 8)) - 64]} << (h - 16);
+    }
+    for (int i = 0; i < Steps; ++i) {
+        const T vyy = (v * ((y * y) >> (h - 2))) >> h;
+        y = (y * ((T{3} << (h - 2)) - vyy)) >> (h - 1);
+    }
+    return y;
+}
+
+/// Returns sqrt(n) rounded to nearest, for n > 0 whose highest set bit is the given one.
+/// The result is exact, like the digit-by-digit sqrt_exact. A fixed number of multiplications gets within a few
+/// units of it, and the last ones are corrected one at a time.
+template <typename T>
+[[nodiscard]] constexpr T sqrt_rounded(T n, int highest) noexcept
+{
+    using S = typename sized_integer<sizeof(T), true>::type;
+    constexpr int h = sizeof(T) * 4;
+
+    // Normalize n to m / 4**e, with m in [2**(bits(T) - 2), 2**bits(T))
+    const int e = (2 * h - 1 - highest) / 2;
+    const T m = n << (2 * e);
+    const T y = rsqrt_normalized<sqrt_steps<T>>(m);
+
+    // sqrt(m) = m / sqrt(m) has about half of the bits. A Newton step for sqrt with the remainder,
+    // s' = s + (m - s**2) / (2 * s), doubles them, and only the remainder needs all bits of m.
+    T s = ((m >> h) * y) >> (h - 2);
+    const S rest = static_cast<S>(m - s * s) >> (h - 12);
+    s += static_cast<T>((rest * static_cast<S>(y)) >> (h + 11));
+    s >>= e;
+
+    // Rounded to nearest, (s - 1/2)**2 < n < (s + 1/2)**2, or -s < n - s**2 <= s. The truncations above
+    // often leave s one too low, which is corrected without a branch. With the single Newton step of the
+    // 1/sqrt estimate in 64 bits, s can also be two or three too low, rarely, which the loops correct.
+    S rest_n = static_cast<S>(n - s * s);
+    const T up = (rest_n > static_cast<S>(s)) ? 1 : 0;
+    rest_n -= static_cast<S>(up * (2 * s + 1));
+    s += up;
+    while (rest_n > static_cast<S>(s)) {
+        rest_n -= static_cast<S>(2 * s + 1);
+        ++s;
+    }
+    while (rest_n <= -static_cast<S>(s)) {
+        --s;
+        rest_n += static_cast<S>(2 * s + 1);
+    }
+    return s;
+}
+
+/// The unsigned integer type in which sqrt() and hypot() evaluate, with at least 64 bits like scaled_type
+template <typename I>
+using root_type = typename sized_integer<sizeof(scaled_type<I>), false>::type;
+
+/// Returns the index of the highest set bit of n, which must not be 0
+template <typename T>
+[[nodiscard]] constexpr int highest_bit(T n) noexcept
+{
+    if constexpr (sizeof(T) > sizeof(std::uint64_t)) {
+        const auto high = static_cast<std::uint64_t>(n >> 64);
+        return (high != 0) ? 64 + highest_bit(high) : highest_bit(static_cast<std::uint64_t>(n));
+    } else {
+        return static_cast<int>(find_highest_bit(n));
+    }
+}
+
+/// Returns the square of the raw value of x, which has twice the fraction bits of x
+template <typename T, typename B, typename I, unsigned int F, auto R>
+[[nodiscard]] constexpr T raw_square(fixed<B, I, F, R> x) noexcept
+{
+    const T value = magnitude(x);
+    return value * value;
+}
+
+/// Returns the square root of a sum of raw_square()s as Fixed, rounded to nearest like sqrt()
+template <typename Fixed, typename T>
+[[nodiscard]] constexpr Fixed sqrt_of_squares(T sum) noexcept
+{
+    using B = typename Fixed::base_type;
+    return Fixed::from_raw_value((sum == 0) ? B{0} : static_cast<B>(sqrt_rounded(sum, highest_bit(sum))));
+}
+
+/// Seeds for 1/cbrt(v) with v in [1/8, 1), indexed by the 8 highest fraction bits of v, with 14 fraction bits.
+/// Each is the mean of 1/cbrt at the ends of its interval, which is within 2**-7 of 1/cbrt(v).
+inline constexpr auto rcbrt_seeds = [] {
+    std::array<std::uint16_t, 224> seeds{};
+    for (std::size_t i = 0; i < seeds.size(); ++i) {
+        const double low = static_cast<double>(i + 32) / 256;
+        const double high = static_cast<double>(i + 33) / 256;
+        seeds[i] = static_cast<std::uint16_t>((1 / cbrt_newton(low) + 1 / cbrt_newton(high)) * 8192 + 0.5);
+    }
+    return seeds;
+}();
+
+/// The number of correct bits of 1/cbrt from the seeds, and after each Newton step
+inline constexpr int rcbrt_accuracy[] = { 7, 14, 27, 53 };
+
+/// The number of Newton steps for 1/cbrt that cbrt() needs for results with the given number of bits.
+/// The exact remainder makes an estimate with an error of 2**-n accurate to about 2**-2n.
+template <int Bits>
+inline constexpr int cbrt_steps = (Bits <= 13) ? 0 : (Bits <= 26) ? 1 : (Bits <= 52) ? 2 : 3;
+
+/// Calculates 1/cbrt(v) for v = m / 2**bits(T) in [1/8, 1), with bits(T)/2 - 2 fraction bits.
+/// Newton's method for 1/cbrt, y' = y * (4 - v * y**3) / 3, needs no division.
+template <int Steps, typename T>
+[[nodiscard]] constexpr T rcbrt_normalized(T m) noexcept
+{
+    constexpr unsigned int h = sizeof(T) * 4;
+    constexpr T third = (T{1} << h) / 3;
+    const T v = m >> h;
+    T y;
+    int steps = Steps;
+    if constexpr (sizeof(T) > sizeof(std::uint64_t)) {
+        // The first steps are as accurate in 64 bits, and much cheaper
+        constexpr int narrow_steps = (Steps < 2) ? Steps : 2;
+        y = T{rcbrt_normalized<narrow_steps>(static_cast<std::uint64_t>(m >> (h * 2 - 64)))} << (h - 32);
+        steps -= narrow_steps;
+    } else {
+        y = T{rcbrt_seeds[static_cast<std::size_t>(v >> (h - 8)) - 32]} << (h - 16);
+    }
+    for (int i = 0; i < steps; ++i) {
+        const T vy = (v * y) >> h;
+        const T vyyy = (((vy * y) >> (h - 2)) * y) >> (h - 2);
+        y = (y * ((((T{4} << (h - 2)) - vyyy) * third) >> h)) >> (h - 2);
+    }
+    return y;
+}
+
+/// Returns cbrt(value * 2**shift) rounded to nearest, for value > 0 and shift < bits(T), where the result
+/// must be below 2**(bits(T)/2 - 1). Only value * 2**shift modulo 2**bits(T) is needed to make it exact.
+template <int Steps, typename T>
+[[nodiscard]] constexpr T cbrt_rounded(T value, int shift) noexcept
+{
+    using S = typename sized_integer<sizeof(T), true>::type;
+    constexpr int h = sizeof(T) * 4;
+
+    // Normalize n = value * 2**shift to m / 8**q, with m in [2**(bits(T) - 3), 2**bits(T)).
+    // The bits that are shifted out of large n only affect the estimate.
+    const int q = (highest_bit(value) + shift) / 3 + 1;
+    const int e = 2 * h + shift - 3 * q;
+    const T m = (e >= 0) ? (value << e) : (value >> -e);
+    const T y = rcbrt_normalized<Steps>(m);
+
+    // cbrt(m) = m * (1/cbrt(m))**2 is as accurate as y. It's rounded to s, an estimate of cbrt(n / 8**j) that's
+    // small enough for the exact remainder of a Newton step for cbrt, s' = s + (n - s**3) / (3 * s**2).
+    // 1 / (3 * s**2) is y**2 / 3, scaled, and is only needed to a few more bits than y.
+    constexpr int precision = h / 2;
+    constexpr int coarse = (2 * h - 8 - precision + rcbrt_accuracy[Steps]) / 3;
+    const int j = (q > coarse) ? q - coarse : 0;
+    const T c = ((((m >> h) * y) >> h) * y) >> (h - 2);
+    const int c_shift = h - 2 - (q - j);
+    T s = (c + (T{1} << (c_shift - 1))) >> c_shift;
+    const S rest = static_cast<S>((value << (shift - 3 * j)) - s * s * s);
+    const T yy3 = (((y * y) >> (2 * h - 4 - precision)) * ((T{1} << h) / 3)) >> h;
+    const int rest_shift = precision + 2 * (q - j) - j;
+    s = (s << j) + static_cast<T>((rest * static_cast<S>(yy3) + (S{1} << (rest_shift - 1))) >> rest_shift);
+
+    // Rounded to nearest, (s - 1/2)**3 < n < (s + 1/2)**3, or -(12*s**2 - 6*s + 1) / 8 < n - s**3 < (12*s**2 + 6*s + 1) / 8.
+    // These bounds are odd eighths, so the remainder is compared with their integer parts. 3*s**2 only fits
+    // unsigned, so the steps between the remainders of s and s + 1 are taken in T.
+    const auto eighths = [](T a, T b) { return static_cast<S>((a >> 1) + ((4 * (a & 1) + b) >> 3)); };
+    S rest_n = static_cast<S>((value << shift) - s * s * s);
+    while (rest_n > eighths(3 * s * s, 6 * s + 1)) {
+        rest_n = static_cast<S>(static_cast<T>(rest_n) - (3 * s * s + 3 * s + 1));
+        ++s;
+    }
+    while (-rest_n > eighths(3 * s * s - 2 * s, 2 * s + 1)) {
+        --s;
+        rest_n = static_cast<S>(static_cast<T>(rest_n) + (3 * s * s + 3 * s + 1));
+    }
+    return s;
+}
+
+/// Calculates sin(x) of a binary angle (2**64 is one full turn) with a polynomial that's accurate to Bits fraction bits.
+template <unsigned int Bits, typename Fixed>
+[[nodiscard]] constexpr Fixed sin_poly(std::uint64_t phase) noexcept
+{
+    using W = poly_type<Bits>;
+    constexpr unsigned int P = poly_fraction_bits<W>;
+    constexpr auto& c = poly_coefficients<W, &sin_quarter_taylor, 0, Bits>;
+    constexpr std::uint64_t quarter_mask = (std::uint64_t{1} << 62) - 1;
+
+    // Reduce to the first quadrant, like lut_sin
+    const auto quadrant = static_cast<unsigned int>(phase >> 62);
+    std::uint64_t offset = phase & quarter_mask;
+    if (quadrant & 1) {
+        offset = quarter_mask - offset;
+    }
+
+    // sin(u * pi/2) = u * p(u**2), for u in [0, 1)
+    const W u = static_cast<W>(offset >> (62 - P));
+    const W y = ((u * u) >> (P - 1)) - (W{1} << P);
+    const W s = (u * horner(c, y)) >> P;
+    return from_poly<Fixed, P>((quadrant & 2) ? -s : s, 0);
+}
+
+/// Calculates atan(x) with a polynomial that's accurate to Bits fraction bits.
+template <unsigned int Bits, typename B, typename I, unsigned int F, auto R>
+[[nodiscard]] constexpr fixed<B, I, F, R> atan_poly(fixed<B, I, F, R> x) noexcept
+{
+    using Fixed = fixed<B, I, F, R>;
+    using W = poly_type<Bits>;
+    using U = std::make_unsigned_t<B>;
+    constexpr unsigned int P = poly_fraction_bits<W>;
+    constexpr auto& c = poly_coefficients<W, &atan_quarter_taylor, 0, Bits>;
+    constexpr auto half_pi = static_cast<W>(1.57079632679489661923 * static_cast<double>(std::uint64_t{1} << P) + 0.5);
+
+    // atan(-x) = -atan(x), and atan(x) = pi/2 - atan(1/x) for x > 1
+    const bool negative = x.raw_value() < 0;
+    const U magnitude = negative ? U{0} - static_cast<U>(x.raw_value()) : static_cast<U>(x.raw_value());
+    const bool inverted = magnitude > (U{1} << (F - 1) << 1);
+    W z;
+    if (!inverted) {
+        z = rescale<P, F>(static_cast<W>(magnitude));
+    } else if constexpr (P + F < sizeof(W) * 8 - 1) {
+        z = (W{1} << (P + F)) / static_cast<W>(magnitude);
+    } else {
+        z = (W{1} << (2 * P)) / static_cast<W>(magnitude >> (F - P));
+    }
+
+    // atan(z) = z * p(z**2), for z in [0, 1]
+    const W y = ((z * z) >> (P - 1)) - (W{1} << P);
+    W result = (z * horner(c, y)) >> P;
+    if (inverted) {
+        result = half_pi - result;
+    }
+    return from_poly<Fixed, P>(negative ? -result : result, 0);
+}
+
+/// The number of fraction bits that the functions of fpm::fast are accurate to, for a type with F fraction bits
+[[nodiscard]] constexpr unsigned int fast_bits(unsigned int f) noexcept
+{
+    return (f < 12) ? f : 12;
+}
+
+/// The number of fraction bits that the functions of fpm::precise are accurate to, for a type with F fraction bits.
+/// This is limited by the double-precision calculation of the coefficients, and by the width of the evaluation.
+[[nodiscard]] constexpr unsigned int precise_bits(unsigned int f) noexcept
+{
+#ifdef FPM_INT128
+    return (f < 40) ? f : 40;
+#else
+    return (f < 26) ? f : 26;
+#endif
+}
+
+/// Converts an angle in radians to a binary angle for fpm::precise, with 63 bits of 2/pi where possible
+template <typename B, typename I, unsigned int F, auto R>
+[[nodiscard]] constexpr std::uint64_t precise_angle(fixed<B, I, F, R> x) noexcept
+{
+#ifdef FPM_INT128
+    return binary_angle_in<::fpm::int128_t>(x);
+#else
+    return binary_angle(x);
+#endif
+}
+
+}
+
+template <typename B, typename I, unsigned int F, auto R>
+[[nodiscard]] constexpr fixed<B, I, F, R> exp(fixed<B, I, F, R> x) noexcept
+{
+    using Fixed = fixed<B, I, F, R>;
+    using W = detail::scaled_type<I>;
+    using U = std::make_unsigned_t<B>;
+    constexpr unsigned int P = detail::poly_fraction_bits<W>;
+    constexpr auto& c = detail::poly_coefficients<W, &detail::exp_taylor, 0, detail::exp_bits<B, W>>;
+    constexpr auto& powers = detail::exp_powers<B, W, F>;
+    constexpr int lowest = detail::exp_lowest<F>, highest = detail::exp_highest<B, F>;
+
+    // Split x into an integer n, whose power is in the table, and a fraction in [0, 1). This is the same
+    // for negative x, so there is no reciprocal.
+    const std::int64_t n = x.raw_value() >> F;
+    if (n < lowest) {
+        // Less than half of the resolution
+        return Fixed::from_raw_value((Fixed::rounding_mode == rounding::ceil) ? 1 : 0);
+    }
+    // Larger n overflow; they only need to stay inside the table
+    const auto& power = powers[static_cast<std::size_t>(((n < highest) ? n : highest) - lowest)];
+    const W f = static_cast<W>(static_cast<U>(x.raw_value()) & ((U{1} << (F - 1) << 1) - 1));
+
+    // e**x = e**n * e**f, rounded once
+    const W p = detail::horner(c, detail::rescale<P + 1, F>(f) - (W{1} << P));
+    return Fixed::from_raw_value(static_cast<B>(detail::shift_right<Fixed::rounding_mode>(p * power.mantissa, power.shift)));
+}
+
+template <typename B, typename I, unsigned int F, auto R>
+[[nodiscard]] constexpr fixed<B, I, F, R> log2(fixed<B, I, F, R> x) noexcept
+{
+    using W = detail::scaled_type<I>;
+    return detail::log2_scaled(x, W{1} << detail::poly_fraction_bits<W>);
+}
+
+template <typename B, typename I, unsigned int F, auto R>
+[[nodiscard]] constexpr fixed<B, I, F, R> log(fixed<B, I, F, R> x) noexcept
+{
+    using W = detail::scaled_type<I>;
+    return detail::log2_scaled(x, detail::log2_scale<W>(detail::ln_2));
+}
+
+template <typename B, typename I, unsigned int F, auto R>
+[[nodiscard]] constexpr fixed<B, I, F, R> log10(fixed<B, I, F, R> x) noexcept
+{
+    using W = detail::scaled_type<I>;
+    return detail::log2_scaled(x, detail::log2_scale<W>(detail::log10_2));
+}
+
+template <typename B, typename I, unsigned int F, auto R>
+[[nodiscard]] constexpr inline fixed<B, I, F, R> log1p(fixed<B, I, F, R> x) noexcept
+{
+    return log(1 + x);
+}
+
+template <typename B, typename I, unsigned int F, auto R>
+[[nodiscard]] constexpr fixed<B, I, F, R> sqrt(fixed<B, I, F, R> x) noexcept
+{
+    using Fixed = fixed<B, I, F, R>;
+    using T = detail::root_type<I>;
+    using U = std::make_unsigned_t<B>;
+
+    assert(x >= Fixed(0));
+    if (x == Fixed(0)) {
+        return x;
+    }
+
+    // Shift by F first because it's fixed-point
+    const auto value = static_cast<U>(x.raw_value());
+    const int highest = std::bit_width(value) - 1 + static_cast<int>(F);
+    return Fixed::from_raw_value(static_cast<B>(detail::sqrt_rounded(static_cast<T>(value) << F, highest)));
+}
+
+/// Calculates 1/sqrt(x) with a relative error below 2**-28, or 2**-56 for 128-bit intermediate types,
+/// before it's rounded with the rounding mode of the type. This takes no division.
+template <typename B, typename I, unsigned int F, auto R>
+[[nodiscard]] constexpr fixed<B, I, F, R> rsqrt(fixed<B, I, F, R> x) noexcept
+{
+    using Fixed = fixed<B, I, F, R>;
+    using W = detail::scaled_type<I>;
+    using T = detail::root_type<I>;
+    using U = std::make_unsigned_t<B>;
+    constexpr int h = sizeof(T) * 4;
+    assert(x > Fixed(0));
+
+    // 1/sqrt(x) = 2**(2*F) / sqrt(x * 2**F) in raw values, where x * 2**F is normalized to m / 4**e
+    const auto value = static_cast<U>(x.raw_value());
+    const int e = (2 * h - 1 - (std::bit_width(value) - 1 + static_cast<int>(F))) / 2;
+    const T y = detail::rsqrt_normalized<detail::rsqrt_steps<T>>(static_cast<T>(value) << (F + 2 * e));
+    return detail::from_poly<Fixed, F>(static_cast<W>(y), 2 * static_cast<int>(F) + e + 2 - 2 * h);
+}
+
+/// Calculates sqrt(x*x + y*y) without overflow or rounding in between: the squares keep twice the fraction bits,
+/// in an integer type with at least 64 bits. Only the result has to fit the type. It's rounded to nearest, like sqrt().
+template <typename B, typename I, unsigned int F, auto R>
+[[nodiscard]] constexpr fixed<B, I, F, R> hypot(fixed<B, I, F, R> x, fixed<B, I, F, R> y) noexcept
+{
+    using T = detail::root_type<I>;
+    return detail::sqrt_of_squares<fixed<B, I, F, R>>(detail::raw_square<T>(x) + detail::raw_square<T>(y));
+}
+
+/// Calculates sqrt(x*x + y*y + z*z) like hypot(x, y)
+template <typename B, typename I, unsigned int F, auto R>
+[[nodiscard]] constexpr fixed<B, I, F, R> hypot(fixed<B, I, F, R> x, fixed<B, I, F, R> y, fixed<B, I, F, R> z) noexcept
+{
+    using T = detail::root_type<I>;
+    return detail::sqrt_of_squares<fixed<B, I, F, R>>(detail::raw_square<T>(x) + detail::raw_square<T>(y) + detail::raw_square<T>(z));
+}
+
+/// Calculates the cube root, rounded to nearest like sqrt(). The estimate from a table and Newton's method
+/// is corrected with the exact remainder, without a division or a loop over the result bits.
+template <typename B, typename I, unsigned int F, auto R>
+[[nodiscard]] constexpr fixed<B, I, F, R> cbrt(fixed<B, I, F, R> x) noexcept
+{
+    using Fixed = fixed<B, I, F, R>;
+    using T = detail::root_type<I>;
+
+    if (x == Fixed(0)) {
+        return x;
+    }
+
+    // cbrt(x) = cbrt(x * 2**(2*F)) in raw values, with at most this many bits
+    constexpr int bits = (std::numeric_limits<B>::digits + 2 * static_cast<int>(F)) / 3 + 1;
+    const T value = detail::magnitude(x);
+    const auto root = static_cast<B>(detail::cbrt_rounded<detail::cbrt_steps<bits>>(value, 2 * static_cast<int>(F)));
+    return Fixed::from_raw_value((x < Fixed(0)) ? static_cast<B>(-root) : root);
+}
+
+/// Accuracy tier with polynomials for an error below 2**-12, or the resolution of types with fewer fraction bits.
+/// Types with few fraction bits evaluate the lowest degree that's accurate for them.
+namespace fast {
+
+template <typename B, typename I, unsigned int F, auto R> requires std::is_signed_v<B>
+[[nodiscard]] constexpr fixed<B, I, F, R> exp2(fixed<B, I, F, R> x) noexcept
+{
+    return detail::exp2_poly<detail::fast_bits(F)>(x);
+}
+
+template <typename B, typename I, unsigned int F, auto R> requires std::is_signed_v<B>
+[[nodiscard]] constexpr fixed<B, I, F, R> log2(fixed<B, I, F, R> x) noexcept
+{
+    return detail::log2_poly<detail::fast_bits(F)>(x);
+}
+
+template <typename B, typename I, unsigned int F, auto R> requires std::is_signed_v<B>
+[[nodiscard]] constexpr fixed<B, I, F, R> sin(fixed<B, I, F, R> x) noexcept
+{
+    return detail::sin_poly<detail::fast_bits(F), fixed<B, I, F, R>>(detail::binary_angle(x));
+}
+
+template <typename B, typename I, unsigned int F, auto R> requires std::is_signed_v<B>
+[[nodiscard]] constexpr fixed<B, I, F, R> cos(fixed<B, I, F, R> x) noexcept
+{
+    return detail::sin_poly<detail::fast_bits(F), fixed<B, I, F, R>>(detail::binary_angle(x) + (std::uint64_t{1} << 62));
+}
+
+/// Calculates sin(x) and cos(x) with a single range reduction. Both are identical to sin(x) and cos(x).
+template <typename B, typename I, unsigned int F, auto R> requires std::is_signed_v<B>
+[[nodiscard]] constexpr std::pair<fixed<B, I, F, R>, fixed<B, I, F, R>> sincos(fixed<B, I, F, R> x) noexcept
+{
+    using Fixed = fixed<B, I, F, R>;
+    const std::uint64_t phase = detail::binary_angle(x);
+    return { detail::sin_poly<detail::fast_bits(F), Fixed>(phase), detail::sin_poly<detail::fast_bits(F), Fixed>(phase + (std::uint64_t{1} << 62)) };
+}
+
+template <typename B, typename I, unsigned int F, auto R> requires std::is_signed_v<B>
+[[nodiscard]] constexpr fixed<B, I, F, R> atan(fixed<B, I, F, R> x) noexcept
+{
+    return detail::atan_poly<detail::fast_bits(F)>(x);
+}
+
+}
+
+/// Accuracy tier with polynomials for an error below the resolution of the type, up to 40 fraction bits
+/// (26 without 128-bit integers). Types with more than 26 fraction bits evaluate them in 128 bits.
+namespace precise {
+
+template <typename B, typename I, unsigned int F, auto R> requires std::is_signed_v<B>
+[[nodiscard]] constexpr fixed<B, I, F, R> exp2(fixed<B, I, F, R> x) noexcept
+{
+    return detail::exp2_poly<detail::precise_bits(F)>(x);
+}
+
+template <typename B, typename I, unsigned int F, auto R> requires std::is_signed_v<B>
+[[nodiscard]] constexpr fixed<B, I, F, R> log2(fixed<B, I, F, R> x) noexcept
+{
+    return detail::log2_poly<detail::precise_bits(F)>(x);
+}
+
+template <typename B, typename I, unsigned int F, auto R> requires std::is_signed_v<B>
+[[nodiscard]] constexpr fixed<B, I, F, R> sin(fixed<B, I, F, R> x) noexcept
+{
+    return detail::sin_poly<detail::precise_bits(F), fixed<B, I, F, R>>(detail::precise_angle(x));
+}
+
+template <typename B, typename I, unsigned int F, auto R> requires std::is_signed_v<B>
+[[nodiscard]] constexpr fixed<B, I, F, R> cos(fixed<B, I, F, R> x) noexcept
+{
+    return detail::sin_poly<detail::precise_bits(F), fixed<B, I, F, R>>(detail::precise_angle(x) + (std::uint64_t{1} << 62));
+}
+
+/// Calculates sin(x) and cos(x) with a single range reduction. Both are identical to sin(x) and cos(x).
+template <typename B, typename I, unsigned int F, auto R> requires std::is_signed_v<B>
+[[nodiscard]] constexpr std::pair<fixed<B, I, F, R>, fixed<B, I, F, R>> sincos(fixed<B, I, F, R> x) noexcept
+{
+    using Fixed = fixed<B, I, F, R>;
+    const std::uint64_t phase = detail::precise_angle(x);
+    return { detail::sin_poly<detail::precise_bits(F), Fixed>(phase), detail::sin_poly<detail::precise_bits(F), Fixed>(phase + (std::uint64_t{1} << 62)) };
+}
+
+template <typename B, typename I, unsigned int F, auto R> requires std::is_signed_v<B>
+[[nodiscard]] constexpr fixed<B, I, F, R> atan(fixed<B, I, F, R> x) noexcept
+{
+    return detail::atan_poly<detail::precise_bits(F)>(x);
+}
+
+}
+
 }
 
 #endif
@@ -0,0 +1,125 @@
+#ifndef FPM_OVERFLOW_HPP
+#define FPM_OVERFLOW_HPP
+
+#include "fixed.hpp"
+
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+// -------------------------------------------------------------------------------------------------
+// Range checks shared by <fpm/saturating.hpp> and <fpm/checked.hpp>
+
+#if defined(FPM_OVERFLOW_BUILTINS)
+// Already defined
+#elif defined(FPM_NO_OVERFLOW_BUILTINS)
+// Use the portable fallbacks
+#elif defined(__GNUC__) || defined(__clang__)
+#define FPM_OVERFLOW_BUILTINS true
+#endif
+
+
+namespace fpm
+{
+namespace detail
+{
+
+/// Returns true if the wide value doesn't fit in the base type.
+template <typename B, typename W>
+[[nodiscard]] constexpr inline bool overflows(W value) noexcept
+{
+    return static_cast<W>(static_cast<B>(value)) != value;
+}
+
+/// Clamps an integral multiplier of B to a range where its product with any B is exact in I.
+/// Any |y| beyond twice the range of B overflows for a non-zero x, so clamping y there doesn't change whether
+/// the product fits, nor the direction in which it overflows. For unsigned B, y must not be negative.
+template <typename B, typename I, typename T>
+[[nodiscard]] constexpr inline I clamp_multiplier(T y) noexcept
+{
+    if constexpr (std::is_signed_v<B>) {
+        constexpr I limit = static_cast<I>(std::numeric_limits<B>::max()) * 2;
+        return std::cmp_less(y, -limit) ? -limit : std::cmp_greater(y, limit) ? limit : static_cast<I>(y);
+    } else {
+        constexpr I limit = static_cast<I>(std::numeric_limits<B>::max()) + 1;
+        return std::cmp_greater(y, limit) ? limit : static_cast<I>(y);
+    }
+}
+
+/// The smallest integer that converts to the fixed-point type without overflow
+template <typename Fixed>
+inline constexpr typename Fixed::base_type integral_min_v = std::numeric_limits<typename Fixed::base_type>::lowest() >> Fixed::fraction_bits;
+
+/// The largest integer that converts to the fixed-point type without overflow
+template <typename Fixed>
+inline constexpr typename Fixed::base_type integral_max_v = std::numeric_limits<typename Fixed::base_type>::max() >> Fixed::fraction_bits;
+
+/// The smallest raw value of the base type B, as a floating-point number
+template <typename B, typename T>
+inline constexpr T float_min_v = static_cast<T>(std::numeric_limits<B>::lowest());
+
+/// The first raw value past the end of the range of the base type B. This is a power of two, so it's exact in T.
+template <typename B, typename T>
+inline constexpr T float_end_v = static_cast<T>(std::numeric_limits<B>::max() / 2 + 1) * 2;
+
+/// Returns the raw value of a fixed-point number in the scale of the fixed-point type \a Fixed, rounded like the
+/// converting constructor, in an integer type that can hold both base types. Narrowing it to the base type of
+/// \a Fixed gives the result of the converting constructor.
+template <typename Fixed, typename B, typename I, unsigned int F, auto R>
+[[nodiscard]] constexpr inline auto rescale_wide(fixed<B, I, F, R> value) noexcept
+{
+    using TB = typename Fixed::base_type;
+    using TI = typename Fixed::intermediate_type;
+    static_assert(std::is_signed_v<B> == std::is_signed_v<TB>, "fixed-point types must have the same signedness");
+
+    using W = std::conditional_t<(sizeof(TI) >= sizeof(I)), TI, I>;
+    constexpr unsigned int TF = Fixed::fraction_bits;
+
+    const W raw = value.raw_value();
+    if constexpr (F > TF) {
+        return detail::shift_right<Fixed::rounding_mode>(raw, F - TF);
+    } else {
+        return static_cast<W>(raw * (W(1) << (TF - F)));
+    }
+}
+
+//! Common part of the fixed-point wrappers with different overflow behavior, fpm::saturating and fpm::checked.
+//! \tparam Fixed the fixed-point type that stores the value
+template <typename Fixed>
+class fixed_wrapper
+{
+public:
+    using value_type = Fixed;
+
+    /// Returns the wrapped fixed-point number.
+    [[nodiscard]] constexpr inline Fixed value() const noexcept
+    {
+        return m_value;
+    }
+
+    [[nodiscard]] constexpr inline operator Fixed() const noexcept
+    {
+        return m_value;
+    }
+
+    /// Explicit conversion to an integral or floating-point type
+    template <typename T> requires std::is_arithmetic_v<T>
+    [[nodiscard]] constexpr inline explicit operator T() const noexcept
+    {
+        return static_cast<T>(m_value);
+    }
+
+protected:
+    constexpr inline fixed_wrapper() noexcept = default;
+
+    constexpr inline fixed_wrapper(Fixed value) noexcept
+        : m_value(value)
+    {}
+
+    Fixed m_value;
+};
+
+} // namespace detail
+} // namespace fpm
+
+#endif
@@ -0,0 +1,309 @@
+#ifndef FPM_QUAT_HPP
+#define FPM_QUAT_HPP
+
+#include "accumulator.hpp"
+#include "fixed.hpp"
+#include "linear.hpp"
+#include "math.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <span>
+#include <utility>
+
+namespace fpm
+{
+
+namespace detail
+{
+
+/// Calculates atan2(y, x) in [0, pi] for y >= 0, with the accuracy of fpm::precise::atan, whose argument is kept
+/// in [-1, 1]. x and y must not both be zero.
+template <typename Fixed>
+[[nodiscard]] constexpr Fixed half_plane_atan2(Fixed y, Fixed x) noexcept
+{
+    assert(y >= Fixed(0) && (x != Fixed(0) || y != Fixed(0)));
+    if (x >= y) {
+        return precise::atan(y / x);
+    }
+    if (-x >= y) {
+        return Fixed::pi() - precise::atan(y / -x);
+    }
+    return Fixed::half_pi() - precise::atan(x / y);
+}
+
+}
+
+//! Quaternion w + xi + yj + zk of fixed-point numbers, for rotations. It's an aggregate, so
+//! `quat<fixed_16_16>{ w, x, y, z }` initializes it. The functions on rotations expect unit quaternions, and
+//! evaluate every element of a result as one sum of products, rounded once, like the functions on vectors.
+//! The type must be able to contain 2, and from_matrix() needs 4.
+//! \tparam Fixed the fixed-point type of the elements
+template <typename Fixed> requires is_fixed_v<Fixed>
+struct quat
+{
+    using value_type = Fixed;
+
+    Fixed w;
+    Fixed x;
+    Fixed y;
+    Fixed z;
+
+    /// Returns the quaternion of no rotation
+    [[nodiscard]] static constexpr quat identity() noexcept
+    {
+        return { Fixed(1), Fixed(0), Fixed(0), Fixed(0) };
+    }
+
+    /// Returns the rotation by an angle in radians around an axis, which must be a unit vector.
+    /// The sine and cosine of half the angle are evaluated together with fpm::precise::sincos().
+    [[nodiscard]] static constexpr quat from_axis_angle(const vec3<Fixed>& axis, Fixed angle) noexcept
+    {
+        const auto [s, c] = precise::sincos(angle / 2);
+        return { c, axis[0] * s, axis[1] * s, axis[2] * s };
+    }
+
+    /// Returns the rotation of a rotation matrix, which must be orthonormal. The diagonal gives four times the
+    /// squares of w, x, y and z. The largest of them, r = 4a**2, gives a = r * s with s = 1 / (4a) = rsqrt(r) / 2,
+    /// and the other elements are sums of two elements of the matrix times s, without a division. No intermediate
+    /// value exceeds 4, so the type must be able to contain 4.
+    [[nodiscard]] static constexpr quat from_matrix(const mat3<Fixed>& m) noexcept
+    {
+        const Fixed rw = Fixed(1) + m[0][0] + m[1][1] + m[2][2];
+        const Fixed rx = Fixed(1) + m[0][0] - m[1][1] - m[2][2];
+        const Fixed ry = Fixed(1) - m[0][0] + m[1][1] - m[2][2];
+        const Fixed rz = Fixed(1) - m[0][0] - m[1][1] + m[2][2];
+        if (rw >= rx && rw >= ry && rw >= rz) {
+            const Fixed s = rsqrt(rw) / 2;
+            return { rw * s, (m[2][1] - m[1][2]) * s, (m[0][2] - m[2][0]) * s, (m[1][0] - m[0][1]) * s };
+        }
+        if (rx >= ry && rx >= rz) {
+            const Fixed s = rsqrt(rx) / 2;
+            return { (m[2][1] - m[1][2]) * s, rx * s, (m[0][1] + m[1][0]) * s, (m[0][2] + m[2][0]) * s };
+        }
+        if (ry >= rz) {
+            const Fixed s = rsqrt(ry) / 2;
+            return { (m[0][2] - m[2][0]) * s, (m[0][1] + m[1][0]) * s, ry * s, (m[1][2] + m[2][1]) * s };
+        }
+        const Fixed s = rsqrt(rz) / 2;
+        return { (m[1][0] - m[0][1]) * s, (m[0][2] + m[2][0]) * s, (m[1][2] + m[2][1]) * s, rz * s };
+    }
+
+    /// Returns the vector part (x, y, z)
+    [[nodiscard]] constexpr inline vec3<Fixed> vector() const noexcept
+    {
+        return { x, y, z };
+    }
+
+    /// Returns the rotation matrix. Each element is rounded once.
+    [[nodiscard]] constexpr mat3<Fixed> to_matrix() const noexcept
+    {
+        const Fixed x2 = x + x, y2 = y + y, z2 = z + z;
+        const auto one = [](Fixed a, Fixed a2, Fixed b, Fixed b2) {
+            return accumulator<Fixed>(Fixed(1)).fms(a, a2).fms(b, b2).value();
+        };
+        return { one(y, y2, z, z2), accumulator<Fixed>().fma(x, y2).fms(w, z2).value(), accumulator<Fixed>().fma(x, z2).fma(w, y2).value(),
+                 accumulator<Fixed>().fma(x, y2).fma(w, z2).value(), one(x, x2, z, z2), accumulator<Fixed>().fma(y, z2).fms(w, x2).value(),
+                 accumulator<Fixed>().fma(x, z2).fms(w, y2).value(), accumulator<Fixed>().fma(y, z2).fma(w, x2).value(), one(x, x2, y, y2) };
+    }
+
+    /// Returns the unit axis and the angle in radians, in [0, 2*pi], of the rotation.
+    /// The axis of no rotation is (1, 0, 0).
+    [[nodiscard]] constexpr std::pair<vec3<Fixed>, Fixed> to_axis_angle() const noexcept
+    {
+        const vec3<Fixed> v = vector();
+        if (v == vec3<Fixed>{}) {
+            return { vec3<Fixed>{ Fixed(1), Fixed(0), Fixed(0) }, Fixed(0) };
+        }
+        return { normalize(v), detail::half_plane_atan2(length(v), w) * 2 };
+    }
+
+    //
+    // Arithmetic member operators, element by element
+    //
+
+    [[nodiscard]] constexpr inline quat operator-() const noexcept
+    {
+        return { -w, -x, -y, -z };
+    }
+
+    constexpr inline quat& operator+=(const quat& q) noexcept
+    {
+        w += q.w;
+        x += q.x;
+        y += q.y;
+        z += q.z;
+        return *this;
+    }
+
+    constexpr inline quat& operator-=(const quat& q) noexcept
+    {
+        w -= q.w;
+        x -= q.x;
+        y -= q.y;
+        z -= q.z;
+        return *this;
+    }
+
+    constexpr inline quat& operator*=(Fixed s) noexcept
+    {
+        w *= s;
+        x *= s;
+        y *= s;
+        z *= s;
+        return *this;
+    }
+
+    [[nodiscard]] friend constexpr inline bool operator==(const quat& a, const quat& b) noexcept = default;
+};
+
+//
+// Quaternion operators
+//
+
+template <typename Fixed>
+[[nodiscard]] constexpr inline quat<Fixed> operator+(quat<Fixed> a, const quat<Fixed>& b) noexcept
+{
+    return a += b;
+}
+
+template <typename Fixed>
+[[nodiscard]] constexpr inline quat<Fixed> operator-(quat<Fixed> a, const quat<Fixed>& b) noexcept
+{
+    return a -= b;
+}
+
+template <typename Fixed>
+[[nodiscard]] constexpr inline quat<Fixed> operator*(quat<Fixed> a, std::type_identity_t<Fixed> s) noexcept
+{
+    return a *= s;
+}
+
+template <typename Fixed>
+[[nodiscard]] constexpr inline quat<Fixed> operator*(std::type_identity_t<Fixed> s, quat<Fixed> a) noexcept
+{
+    return a *= s;
+}
+
+/// Calculates the Hamilton product: the rotation by b, followed by the rotation by a. Each element is rounded once.
+template <typename Fixed>
+[[nodiscard]] constexpr quat<Fixed> operator*(const quat<Fixed>& a, const quat<Fixed>& b) noexcept
+{
+    return { accumulator<Fixed>().fma(a.w, b.w).fms(a.x, b.x).fms(a.y, b.y).fms(a.z, b.z).value(),
+             accumulator<Fixed>().fma(a.w, b.x).fma(a.x, b.w).fma(a.y, b.z).fms(a.z, b.y).value(),
+             accumulator<Fixed>().fma(a.w, b.y).fms(a.x, b.z).fma(a.y, b.w).fma(a.z, b.x).value(),
+             accumulator<Fixed>().fma(a.w, b.z).fma(a.x, b.y).fms(a.y, b.x).fma(a.z, b.w).value() };
+}
+
+//
+// Quaternion functions
+//
+
+/// Returns the conjugate, which is the inverse rotation of a unit quaternion
+template <typename Fixed>
+[[nodiscard]] constexpr inline quat<Fixed> conjugate(const quat<Fixed>& q) noexcept
+{
+    return { q.w, -q.x, -q.y, -q.z };
+}
+
+/// Calculates the dot product of the four elements, rounded once
+template <typename Fixed>
+[[nodiscard]] constexpr Fixed dot(const quat<Fixed>& a, const quat<Fixed>& b) noexcept
+{
+    return accumulator<Fixed>().fma(a.w, b.w).fma(a.x, b.x).fma(a.y, b.y).fma(a.z, b.z).value();
+}
+
+/// Calculates the norm like the length of a vector
+template <typename Fixed>
+[[nodiscard]] constexpr Fixed length(const quat<Fixed>& q) noexcept
+{
+    return length(vec4<Fixed>{ q.w, q.x, q.y, q.z });
+}
+
+/// Returns the unit quaternion q / length(q) like the normalize() of vectors, without a division.
+/// q must not be zero.
+template <typename Fixed>
+[[nodiscard]] constexpr quat<Fixed> normalize(const quat<Fixed>& q) noexcept
+{
+    const auto n = normalize(vec4<Fixed>{ q.w, q.x, q.y, q.z });
+    return { n[0], n[1], n[2], n[3] };
+}
+
+/// Rotates a vector by a unit quaternion, as v + w*t + cross(u, t) with t = cross(2u, v) for the vector part u.
+/// Each element of t and of the result is rounded once.
+template <typename Fixed>
+[[nodiscard]] constexpr vec3<Fixed> rotate(const quat<Fixed>& q, const vec3<Fixed>& v) noexcept
+{
+    const vec3<Fixed> u = q.vector();
+    const vec3<Fixed> t = cross(u + u, v);
+    return { accumulator<Fixed>(v[0]).fma(q.w, t[0]).fma(u[1], t[2]).fms(u[2], t[1]).value(),
+             accumulator<Fixed>(v[1]).fma(q.w, t[1]).fma(u[2], t[0]).fms(u[0], t[2]).value(),
+             accumulator<Fixed>(v[2]).fma(q.w, t[2]).fma(u[0], t[1]).fms(u[1], t[0]).value() };
+}
+
+/// Interpolates linearly from a to b along the shorter arc and normalizes the result. Like slerp(), a and b
+/// must be unit quaternions and t in [0, 1], but the rotation doesn't have a constant speed.
+template <typename Fixed>
+[[nodiscard]] constexpr quat<Fixed> nlerp(const quat<Fixed>& a, quat<Fixed> b, Fixed t) noexcept
+{
+    if (dot(a, b) < Fixed(0)) {
+        b = -b;
+    }
+    const auto lerp = [t](Fixed from, Fixed to) { return accumulator<Fixed>(from).fma(t, to - from).value(); };
+    return normalize(quat<Fixed>{ lerp(a.w, b.w), lerp(a.x, b.x), lerp(a.y, b.y), lerp(a.z, b.z) });
+}
+
+/// Interpolates spherically from a to b along the shorter arc, at a constant speed for t in [0, 1].
+/// The result is a * cos(t*theta) + c * sin(t*theta), where theta is the angle between a and b and c is the unit
+/// quaternion orthogonal to a towards b, so a single sincos() is needed. Nearly parallel quaternions are
+/// interpolated with nlerp(), which has the same result up to rounding there.
+template <typename Fixed>
+[[nodiscard]] constexpr quat<Fixed> slerp(const quat<Fixed>& a, quat<Fixed> b, Fixed t) noexcept
+{
+    Fixed cos_theta = dot(a, b);
+    if (cos_theta < Fixed(0)) {
+        b = -b;
+        cos_theta = -cos_theta;
+    }
+    if (cos_theta > Fixed(0.9995)) {
+        return nlerp(a, b, t);
+    }
+
+    // The part of b orthogonal to a has a length of sin(theta)
+    const auto orthogonal = [cos_theta](Fixed from, Fixed to) { return accumulator<Fixed>(to).fms(from, cos_theta).value(); };
+    const quat<Fixed> d{ orthogonal(a.w, b.w), orthogonal(a.x, b.x), orthogonal(a.y, b.y), orthogonal(a.z, b.z) };
+    const quat<Fixed> c = normalize(d);
+    const auto [s, co] = precise::sincos(detail::half_plane_atan2(length(d), cos_theta) * t);
+    const auto mix = [s, co](Fixed from, Fixed to) { return accumulator<Fixed>().fma(from, co).fma(to, s).value(); };
+    return { mix(a.w, c.w), mix(a.x, c.x), mix(a.y, c.y), mix(a.z, c.z) };
+}
+
+namespace batch
+{
+
+//! Computes out_i = rotate(q, x_i)
+template <typename Fixed> requires is_fixed_v<Fixed>
+inline void rotate(const quat<Fixed>& q, const const_soa<3, Fixed>& x, const soa<3, Fixed>& out) noexcept
+{
+    assert(detail::sized(x, out[0].size()) && detail::sized(out, out[0].size()));
+    for (std::size_t i = 0; i < out[0].size(); ++i) {
+        detail::store(out, i, fpm::rotate(q, detail::load(x, i)));
+    }
+}
+
+//! Computes out_i = rotate(q_i, x_i), with the quaternions stored as a structure of arrays of w, x, y and z
+template <typename Fixed> requires is_fixed_v<Fixed>
+inline void rotate(const const_soa<4, Fixed>& q, const const_soa<3, Fixed>& x, const soa<3, Fixed>& out) noexcept
+{
+    assert(detail::sized(q, out[0].size()) && detail::sized(x, out[0].size()) && detail::sized(out, out[0].size()));
+    for (std::size_t i = 0; i < out[0].size(); ++i) {
+        const quat<Fixed> qi{ q[0][i], q[1][i], q[2][i], q[3][i] };
+        detail::store(out, i, fpm::rotate(qi, detail::load(x, i)));
+    }
+}
+
+}
+
+}
+
+#endif
@@ -0,0 +1,302 @@
+#ifndef FPM_ROUNDING_HPP
+#define FPM_ROUNDING_HPP
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace fpm
+{
+
+//! Rounding modes for the last bit of multiplication, division and conversion results.
+//! A mode can be passed as the EnableRounding parameter of fpm::fixed; true and false select
+//! half_away_from_zero and toward_zero.
+enum class rounding
+{
+    toward_zero,            //!< Truncate, like integer division
+    half_away_from_zero,    //!< Round to nearest, ties away from zero
+    half_up,                //!< Round to nearest, ties toward positive infinity
+    half_even,              //!< Round to nearest, ties to the even result
+    floor,                  //!< Round toward negative infinity
+    ceil,                   //!< Round toward positive infinity
+    stochastic,             //!< Round away from zero with a probability equal to the discarded fraction
+};
+
+namespace detail
+{
+
+//! Returns the rounding mode selected by the EnableRounding parameter of fpm::fixed
+template <typename T>
+[[nodiscard]] constexpr inline rounding rounding_mode_of(T enable_rounding) noexcept
+{
+    static_assert(std::is_same_v<T, bool> || std::is_same_v<T, rounding>, "EnableRounding must be a bool or an fpm::rounding");
+    if constexpr (std::is_same_v<T, bool>) {
+        return enable_rounding ? rounding::half_away_from_zero : rounding::toward_zero;
+    } else {
+        return enable_rounding;
+    }
+}
+
+//! Returns the std::float_round_style that describes a rounding mode
+[[nodiscard]] constexpr inline std::float_round_style round_style_of(rounding mode) noexcept
+{
+    switch (mode) {
+    case rounding::toward_zero: return std::round_toward_zero;
+    case rounding::floor: return std::round_toward_neg_infinity;
+    case rounding::ceil: return std::round_toward_infinity;
+    case rounding::stochastic: return std::round_indeterminate;
+    default: return std::round_to_nearest;
+    }
+}
+
+//! Returns true if a rounding mode rounds to the nearest result, so that its error is at most half an ulp.
+//! The other modes can be off by almost a whole ulp.
+[[nodiscard]] constexpr inline bool rounds_to_nearest(rounding mode) noexcept
+{
+    return round_style_of(mode) == std::round_to_nearest;
+}
+
+//! The random number generator of stochastic rounding. It's counter-based: the numbers are a hash of
+//! consecutive counters, so that a vector of them can be computed at once. Every thread has its own.
+struct stochastic_stream
+{
+    std::uint32_t key_low;
+    std::uint32_t key_high;
+    std::uint32_t counter;
+};
+
+//! A bijective 32-bit integer hash with good avalanche (Chris Wellons' "lowbias32")
+[[nodiscard]] constexpr inline std::uint32_t stochastic_hash(std::uint32_t x) noexcept
+{
+    x ^= x >> 16;
+    x *= 0x7FEB352Du;
+    x ^= x >> 15;
+    x *= 0x846CA68Bu;
+    x ^= x >> 16;
+    return x;
+}
+
+//! Returns the low 32 random bits for the given counter. These are the only ones used for products
+//! of types with 32-bit base types, and are what the SIMD kernels compute.
+[[nodiscard]] constexpr inline std::uint32_t stochastic_low(const stochastic_stream& stream, std::uint32_t counter) noexcept
+{
+    return stochastic_hash(counter + stream.key_low);
+}
+
+//! Returns the stream for a seed, with keys that depend on all of its bits
+[[nodiscard]] constexpr inline stochastic_stream stochastic_seeded(std::uint64_t seed) noexcept
+{
+    const std::uint32_t low = stochastic_hash(static_cast<std::uint32_t>(seed) ^ stochastic_hash(static_cast<std::uint32_t>(seed >> 32)));
+    return { low, stochastic_hash(low + 0x9E3779B9u), 0 };
+}
+
+//! Returns the stream of the calling thread
+[[nodiscard]] inline stochastic_stream& stochastic_state() noexcept
+{
+    thread_local stochastic_stream stream = stochastic_seeded(0);
+    return stream;
+}
+
+//! Returns 64 random bits for stochastic rounding, and advances the counter of the calling thread.
+//! When the counter wraps around, the stream continues with new keys.
+[[nodiscard]] inline std::uint64_t stochastic_bits() noexcept
+{
+    stochastic_stream& stream = stochastic_state();
+    const std::uint32_t counter = stream.counter;
+    const std::uint64_t bits = (std::uint64_t{stochastic_hash(counter ^ stream.key_high)} << 32) | stochastic_low(stream, counter);
+    if (++stream.counter == 0) {
+        stream.key_low = stochastic_hash(stream.key_low + 0x9E3779B9u);
+        stream.key_high = stochastic_hash(stream.key_high + 0x7F4A7C15u);
+    }
+    return bits;
+}
+
+//! Returns a random number in [0, 2**shift) for stochastic rounding, for 0 < shift < the number of bits of T.
+template <typename T>
+[[nodiscard]] inline T stochastic_threshold(unsigned int shift) noexcept
+{
+    const std::uint64_t bits = stochastic_bits();
+    if (shift > 63) {
+        // Only 63 random bits are needed to round
+        return static_cast<T>(bits >> 1) << (shift - 63);
+    }
+    const T mask = ((T(1) << (shift - 1)) - 1) * 2 + 1;
+    return static_cast<T>(bits) & mask;
+}
+
+//! Returns true with a probability of rest / magnitude, for 0 <= rest < magnitude.
+template <typename T>
+[[nodiscard]] inline bool stochastic_round_away(T rest, T magnitude) noexcept
+{
+    const double uniform = static_cast<double>(stochastic_bits() >> 11) * 0x1p-53;
+    return static_cast<double>(rest) > uniform * static_cast<double>(magnitude);
+}
+
+//! Returns whether a result that was truncated toward zero must move one step away from zero.
+//! The stochastic mode rounds to nearest here, ties to even, since the size of the discarded part is unknown.
+//! \param negative whether the exact result is negative
+//! \param odd      whether the truncated result is odd
+//! \param above    whether the discarded part is more than half of the last bit
+//! \param half     whether the discarded part is exactly half of the last bit
+//! \param inexact  whether anything was discarded
+template <rounding Mode>
+[[nodiscard]] constexpr inline bool round_away(bool negative, bool odd, bool above, bool half, bool inexact) noexcept
+{
+    switch (Mode) {
+    case rounding::toward_zero: return false;
+    case rounding::half_away_from_zero: return above || half;
+    case rounding::half_up: return above || (half && !negative);
+    case rounding::half_even: return above || (half && odd);
+    case rounding::floor: return negative && inexact;
+    case rounding::ceil: return !negative && inexact;
+    case rounding::stochastic: return above || (half && odd);
+    }
+    return false;
+}
+
+//! Returns value / 2**shift rounded with Mode, for 0 < shift < the number of bits of T.
+//! Only arithmetic shifts and masks are used, and nothing can overflow.
+template <rounding Mode, typename T>
+[[nodiscard]] constexpr inline T shift_right(T value, unsigned int shift) noexcept
+{
+    constexpr bool is_signed = std::numeric_limits<T>::is_signed;
+    const bool negative = is_signed && value < 0;
+    const T floor = value >> shift;
+
+    if constexpr (Mode == rounding::stochastic) {
+        if (std::is_constant_evaluated()) {
+            return shift_right<rounding::half_even>(value, shift);
+        }
+        const T rest = value - (floor << shift);
+        return floor + ((rest > stochastic_threshold<T>(shift)) ? 1 : 0);
+    } else if constexpr (Mode == rounding::floor) {
+        return floor;
+    } else if constexpr (Mode == rounding::half_up) {
+        // The highest shifted-out bit decides
+        return floor + ((value >> (shift - 1)) & 1);
+    } else if constexpr (Mode == rounding::toward_zero || Mode == rounding::ceil) {
+        // Values must be rounded up if any bit was shifted out; for toward_zero, only negative ones
+        const T mask = ((T(1) << (shift - 1)) - 1) * 2 + 1;
+        return floor + (((Mode == rounding::ceil || negative) && (value & mask) != 0) ? 1 : 0);
+    } else {
+        // The shifted-out bits, as a non-negative number below 2**shift
+        const T rest = value - (floor << shift);
+        const T half = T(1) << (shift - 1);
+        const bool up = (rest > half) || (rest == half && (Mode == rounding::half_even ? (floor & 1) != 0 : !negative));
+        return floor + (up ? 1 : 0);
+    }
+}
+
+//! Returns value / 2**shift rounded with Mode, like shift_right, for values with headroom: adding 2**shift
+//! to the magnitude of value must not overflow T. This holds for a product in the intermediate type, and
+//! takes one addition and one shift.
+template <rounding Mode, typename T>
+[[nodiscard]] constexpr inline T shift_right_with_headroom(T value, unsigned int shift) noexcept
+{
+    if constexpr (Mode == rounding::stochastic) {
+        if (std::is_constant_evaluated()) {
+            return shift_right_with_headroom<rounding::half_even>(value, shift);
+        }
+        // A uniformly random bias carries into the result with a probability of the shifted-out fraction
+        return (value + stochastic_threshold<T>(shift)) >> shift;
+    }
+    const bool negative = std::numeric_limits<T>::is_signed && value < 0;
+    const T half = T(1) << (shift - 1);
+    T bias = 0;
+    switch (Mode) {
+    case rounding::toward_zero: bias = negative ? half * 2 - 1 : 0; break;
+    case rounding::half_away_from_zero: bias = negative ? half - 1 : half; break;
+    case rounding::half_up: bias = half; break;
+    case rounding::half_even: bias = half - 1 + ((value >> shift) & 1); break;
+    case rounding::floor: break;
+    case rounding::ceil: bias = half * 2 - 1; break;
+    case rounding::stochastic: break;
+    }
+    return (value + bias) >> shift;
+}
+
+//! Returns whether a quotient that was truncated toward zero must move one step away from zero.
+//! \param negative  whether the exact quotient is negative
+//! \param odd       whether the truncated quotient is odd
+//! \param rest      the magnitude of the remainder
+//! \param magnitude the magnitude of the divisor
+template <rounding Mode, typename T>
+[[nodiscard]] constexpr inline bool round_remainder(bool negative, bool odd, T rest, T magnitude) noexcept
+{
+    if constexpr (Mode == rounding::stochastic) {
+        if (!std::is_constant_evaluated()) {
+            return stochastic_round_away(rest, magnitude);
+        }
+    }
+    // Compare the remainder with half of the divisor without doubling it
+    const T other = magnitude - rest;
+    return round_away<Mode>(negative, odd, rest > other, rest == other, rest != 0);
+}
+
+//! Returns dividend / divisor rounded with Mode. The divisor must not be lowest().
+template <rounding Mode, typename T>
+[[nodiscard]] constexpr inline T divide(T dividend, T divisor) noexcept
+{
+    const T quotient = dividend / divisor;
+    if constexpr (Mode == rounding::toward_zero) {
+        return quotient;
+    } else {
+        const T remainder = dividend % divisor;
+        bool negative = false;
+        T rest = remainder, magnitude = divisor;
+        if constexpr (std::numeric_limits<T>::is_signed) {
+            negative = (dividend < 0) != (divisor < 0);
+            rest = (remainder < 0) ? -remainder : remainder;
+            magnitude = (divisor < 0) ? -divisor : divisor;
+        }
+        // Without branches, since the outcome of stochastic rounding can't be predicted
+        const T away = round_remainder<Mode>(negative, (quotient & 1) != 0, rest, magnitude) ? 1 : 0;
+        return quotient + (negative ? 0 - away : away);
+    }
+}
+
+//! Adjusts a scaled floating-point number so that converting it to an integer, which truncates,
+//! rounds it with Mode. The range of the integer can be checked on the result.
+template <rounding Mode, typename T>
+[[nodiscard]] constexpr inline T round_scaled(T scaled) noexcept
+{
+    if constexpr (Mode == rounding::toward_zero) {
+        return scaled;
+    } else if constexpr (Mode == rounding::half_away_from_zero) {
+        return (scaled >= T{0}) ? (scaled + T{0.5}) : (scaled - T{0.5});
+    } else {
+        // Beyond this magnitude, and for NaN, there is no fraction to round
+        constexpr T integral = static_cast<T>(std::uint64_t{1} << (std::numeric_limits<T>::digits - 1));
+        if (!(scaled > -integral && scaled < integral)) {
+            return scaled;
+        }
+        const auto truncated = static_cast<std::int64_t>(scaled);
+        // The discarded fraction is exact: it needs fewer bits than the scaled value
+        const T rest = scaled - static_cast<T>(truncated);
+        const bool negative = scaled < T{0};
+        const T magnitude = negative ? -rest : rest;
+        bool away = round_away<Mode>(negative, (truncated & 1) != 0, magnitude > T{0.5}, magnitude == T{0.5}, magnitude != T{0});
+        if constexpr (Mode == rounding::stochastic) {
+            if (!std::is_constant_evaluated()) {
+                away = stochastic_round_away(magnitude, T{1});
+            }
+        }
+        const std::int64_t step = away ? 1 : 0;
+        return static_cast<T>(truncated + (negative ? -step : step));
+    }
+}
+
+} // namespace detail
+
+//! Restarts the random numbers of stochastic rounding on the calling thread from the given seed.
+//! Every thread starts with the seed 0, so threads that should round independently need different seeds.
+//! The same seed and the same sequence of operations give the same results, including the bulk
+//! operations in <fpm/simd.hpp>.
+inline void seed_stochastic_rounding(std::uint64_t seed) noexcept
+{
+    detail::stochastic_state() = detail::stochastic_seeded(seed);
+}
+
+} // namespace fpm
+
+#endif
@@ -0,0 +1,375 @@
+#ifndef FPM_SATURATING_HPP
+#define FPM_SATURATING_HPP
+
+#include "fixed.hpp"
+#include "overflow.hpp"
+
+#include <cassert>
+#include <compare>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace fpm
+{
+
+namespace detail
+{
+
+/// Clamps a wide intermediate value to the range of the base type.
+template <typename B, typename W>
+[[nodiscard]] constexpr inline B saturate(W value) noexcept
+{
+    constexpr W min = static_cast<W>(std::numeric_limits<B>::lowest());
+    constexpr W max = static_cast<W>(std::numeric_limits<B>::max());
+    return static_cast<B>((value < min) ? min : (value > max) ? max : value);
+}
+
+template <typename B, typename I>
+[[nodiscard]] constexpr inline B add_sat(B x, B y) noexcept
+{
+#ifdef FPM_OVERFLOW_BUILTINS
+    // On overflow both operands have the same sign, which is the direction of the overflow
+    B result;
+    const bool overflow = __builtin_add_overflow(x, y, &result);
+    return overflow ? ((x < 0) ? std::numeric_limits<B>::lowest() : std::numeric_limits<B>::max()) : result;
+#else
+    return saturate<B>(static_cast<I>(x) + static_cast<I>(y));
+#endif
+}
+
+template <typename B, typename I>
+[[nodiscard]] constexpr inline B sub_sat(B x, B y) noexcept
+{
+#ifdef FPM_OVERFLOW_BUILTINS
+    // On overflow the operands have different signs, and x has the sign of the overflow.
+    // Unsigned types can only overflow below zero.
+    B result;
+    const bool overflow = __builtin_sub_overflow(x, y, &result);
+    return overflow ? ((!std::is_signed_v<B> || x < 0) ? std::numeric_limits<B>::lowest() : std::numeric_limits<B>::max()) : result;
+#else
+    if constexpr (std::is_signed_v<B>) {
+        return saturate<B>(static_cast<I>(x) - static_cast<I>(y));
+    } else {
+        return (x < y) ? B{0} : static_cast<B>(x - y);
+    }
+#endif
+}
+
+template <typename B, typename I, typename T>
+[[nodiscard]] constexpr inline B mul_sat(B x, T y) noexcept
+{
+#ifdef FPM_OVERFLOW_BUILTINS
+    B result;
+    const bool overflow = __builtin_mul_overflow(x, y, &result);
+    return overflow ? (((x < 0) != (y < 0)) ? std::numeric_limits<B>::lowest() : std::numeric_limits<B>::max()) : result;
+#else
+    if constexpr (!std::is_signed_v<B>) {
+        if (std::cmp_less(y, 0)) {
+            return B{0};
+        }
+    }
+    return saturate<B>(static_cast<I>(x) * clamp_multiplier<B, I>(y));
+#endif
+}
+
+/// Returns the magnitude of an integer operand of addition or subtraction, scaled to raw values in I.
+/// Magnitudes from 2^(bits of B - F) on saturate the result for any other operand, so they are clamped there,
+/// which keeps the result exact in I.
+template <typename B, typename I, unsigned int F, typename T>
+[[nodiscard]] constexpr inline I scaled_magnitude(T y) noexcept
+{
+    using M = std::make_unsigned_t<T>;
+    constexpr unsigned int limit_bits = sizeof(B) * 8 - F;
+    const M magnitude = std::cmp_less(y, 0) ? M(0 - static_cast<M>(y)) : static_cast<M>(y);
+    if constexpr (limit_bits < std::numeric_limits<M>::digits) {
+        if (magnitude >= (M{1} << limit_bits)) {
+            return I{1} << (sizeof(B) * 8);
+        }
+    }
+    return static_cast<I>(magnitude) << F;
+}
+
+/// Returns x + y * 2^F, or x - y * 2^F if \a subtract, clamped to the range of B.
+template <typename B, typename I, unsigned int F, typename T>
+[[nodiscard]] constexpr inline B add_integer_sat(B x, T y, bool subtract) noexcept
+{
+    const bool negative = std::cmp_less(y, 0) != subtract;
+    const I magnitude = scaled_magnitude<B, I, F>(y);
+    if constexpr (std::is_signed_v<B>) {
+        return saturate<B>(negative ? static_cast<I>(x) - magnitude : static_cast<I>(x) + magnitude);
+    } else {
+        return negative ? ((magnitude > x) ? B{0} : static_cast<B>(x - magnitude)) : saturate<B>(static_cast<I>(x) + magnitude);
+    }
+}
+
+/// Returns y * 2^F - x clamped to the range of B.
+template <typename B, typename I, unsigned int F, typename T>
+[[nodiscard]] constexpr inline B subtract_from_integer_sat(T y, B x) noexcept
+{
+    const I magnitude = scaled_magnitude<B, I, F>(y);
+    if constexpr (std::is_signed_v<B>) {
+        return saturate<B>((std::cmp_less(y, 0) ? -magnitude : magnitude) - static_cast<I>(x));
+    } else {
+        return (std::cmp_less(y, 0) || magnitude < x) ? B{0} : saturate<B>(magnitude - x);
+    }
+}
+
+} // namespace detail
+
+//
+// Saturating arithmetic on plain fixed-point numbers.
+// Instead of wrapping around, results that don't fit are clamped to lowest() or max().
+//
+
+template <typename B, typename I, unsigned int F, auto R>
+[[nodiscard]] constexpr inline fixed<B, I, F, R> add_sat(fixed<B, I, F, R> x, fixed<B, I, F, R> y) noexcept
+{
+    return fixed<B, I, F, R>::from_raw_value(detail::add_sat<B, I>(x.raw_value(), y.raw_value()));
+}
+
+template <typename B, typename I, unsigned int F, auto R>
+[[nodiscard]] constexpr inline fixed<B, I, F, R> sub_sat(fixed<B, I, F, R> x, fixed<B, I, F, R> y) noexcept
+{
+    return fixed<B, I, F, R>::from_raw_value(detail::sub_sat<B, I>(x.raw_value(), y.raw_value()));
+}
+
+/// Adds an integer like operator+, but clamps the result, even where the integer alone doesn't fit.
+template <typename B, typename I, unsigned int F, auto R, typename T> requires std::is_integral_v<T>
+[[nodiscard]] constexpr inline fixed<B, I, F, R> add_sat(fixed<B, I, F, R> x, T y) noexcept
+{
+    return fixed<B, I, F, R>::from_raw_value(detail::add_integer_sat<B, I, F>(x.raw_value(), y, false));
+}
+
+template <typename B, typename I, unsigned int F, auto R, typename T> requires std::is_integral_v<T>
+[[nodiscard]] constexpr inline fixed<B, I, F, R> add_sat(T x, fixed<B, I, F, R> y) noexcept
+{
+    return add_sat(y, x);
+}
+
+/// Subtracts an integer like operator-, but clamps the result, even where the integer alone doesn't fit.
+template <typename B, typename I, unsigned int F, auto R, typename T> requires std::is_integral_v<T>
+[[nodiscard]] constexpr inline fixed<B, I, F, R> sub_sat(fixed<B, I, F, R> x, T y) noexcept
+{
+    return fixed<B, I, F, R>::from_raw_value(detail::add_integer_sat<B, I, F>(x.raw_value(), y, true));
+}
+
+template <typename B, typename I, unsigned int F, auto R, typename T> requires std::is_integral_v<T>
+[[nodiscard]] constexpr inline fixed<B, I, F, R> sub_sat(T x, fixed<B, I, F, R> y) noexcept
+{
+    return fixed<B, I, F, R>::from_raw_value(detail::subtract_from_integer_sat<B, I, F>(x, y.raw_value()));
+}
+
+/// Multiplies like operator*, but clamps the intermediate result instead of truncating its high bits.
+template <typename B, typename I, unsigned int F, auto R>
+[[nodiscard]] constexpr inline fixed<B, I, F, R> mul_sat(fixed<B, I, F, R> x, fixed<B, I, F, R> y) noexcept
+{
+    using Fixed = fixed<B, I, F, R>;
+    const auto value = detail::shift_right_with_headroom<Fixed::rounding_mode>(static_cast<I>(x.raw_value()) * y.raw_value(), F);
+    return Fixed::from_raw_value(detail::saturate<B>(value));
+}
+
+template <typename B, typename I, unsigned int F, auto R, typename T> requires std::is_integral_v<T>
+[[nodiscard]] constexpr inline fixed<B, I, F, R> mul_sat(fixed<B, I, F, R> x, T y) noexcept
+{
+    return fixed<B, I, F, R>::from_raw_value(detail::mul_sat<B, I>(x.raw_value(), y));
+}
+
+/// Divides like operator/, but clamps the intermediate result instead of truncating its high bits.
+template <typename B, typename I, unsigned int F, auto R>
+[[nodiscard]] constexpr inline fixed<B, I, F, R> div_sat(fixed<B, I, F, R> x, fixed<B, I, F, R> y) noexcept
+{
+    using Fixed = fixed<B, I, F, R>;
+    assert(y.raw_value() != 0);
+    const auto value = detail::divide<Fixed::rounding_mode>(static_cast<I>(x.raw_value()) * Fixed::FRACTION_MULT, static_cast<I>(y.raw_value()));
+    return Fixed::from_raw_value(detail::saturate<B>(value));
+}
+
+/// Divides by an integer. Only lowest() / -1 can overflow.
+template <typename B, typename I, unsigned int F, auto R, typename T> requires std::is_integral_v<T>
+[[nodiscard]] constexpr inline fixed<B, I, F, R> div_sat(fixed<B, I, F, R> x, T y) noexcept
+{
+    assert(y != 0);
+    return fixed<B, I, F, R>::from_raw_value(detail::saturate<B>(static_cast<I>(x.raw_value()) / static_cast<I>(y)));
+}
+
+/// Shifts left by \a y bits, clamping if any significant bits are shifted out.
+template <typename B, typename I, unsigned int F, auto R, typename T> requires std::is_integral_v<T>
+[[nodiscard]] constexpr inline fixed<B, I, F, R> shl_sat(fixed<B, I, F, R> x, T y) noexcept
+{
+    assert(y >= 0 && std::cmp_less(y, sizeof(B) * 8));
+    const B value = x.raw_value();
+    const B min = std::numeric_limits<B>::lowest() >> y;
+    const B max = std::numeric_limits<B>::max() >> y;
+    return fixed<B, I, F, R>::from_raw_value(
+        (value < min) ? std::numeric_limits<B>::lowest() :
+        (value > max) ? std::numeric_limits<B>::max() :
+        static_cast<B>(value << y));
+}
+
+//
+// Saturating conversions
+//
+
+/// Converts an integral number to the fixed-point type, clamping it to the range of the type.
+template <typename Fixed, typename T> requires (is_fixed_v<Fixed> && std::is_integral_v<T>)
+[[nodiscard]] constexpr inline Fixed saturate_cast(T value) noexcept
+{
+    using B = typename Fixed::base_type;
+    return std::cmp_less(value, detail::integral_min_v<Fixed>) ? std::numeric_limits<Fixed>::lowest() :
+           std::cmp_greater(value, detail::integral_max_v<Fixed>) ? std::numeric_limits<Fixed>::max() :
+           Fixed(static_cast<B>(value));
+}
+
+/// Converts a floating-point number to the fixed-point type, clamping it to the range of the type.
+/// NaN converts to zero.
+template <typename Fixed, typename T> requires (is_fixed_v<Fixed> && std::is_floating_point_v<T>)
+[[nodiscard]] constexpr inline Fixed saturate_cast(T value) noexcept
+{
+    using B = typename Fixed::base_type;
+    const T scaled = detail::round_scaled<Fixed::rounding_mode>(value * static_cast<T>(Fixed::FRACTION_MULT));
+    return (scaled != scaled) ? Fixed(0) :
+           (scaled < detail::float_min_v<B, T>) ? std::numeric_limits<Fixed>::lowest() :
+           (scaled >= detail::float_end_v<B, T>) ? std::numeric_limits<Fixed>::max() :
+           Fixed::from_raw_value(static_cast<B>(scaled));
+}
+
+/// Converts between fixed-point types like the converting constructor, but clamps to the range of the type
+/// instead of truncating bits that don't fit.
+template <typename Fixed, typename B, typename I, unsigned int F, auto R> requires is_fixed_v<Fixed>
+[[nodiscard]] constexpr inline Fixed saturate_cast(fixed<B, I, F, R> value) noexcept
+{
+    return Fixed::from_raw_value(detail::saturate<typename Fixed::base_type>(detail::rescale_wide<Fixed>(value)));
+}
+
+//! Fixed-point number with saturating arithmetic.
+//! Wraps a fixed-point type so that all arithmetic operators clamp to lowest() and max() instead of wrapping.
+//! \tparam Fixed the fixed-point type that stores the value
+template <typename Fixed> requires is_fixed_v<Fixed>
+struct saturating : detail::fixed_wrapper<Fixed>
+{
+    constexpr inline saturating() noexcept = default;
+
+    /// Wraps a fixed-point number. This is lossless.
+    constexpr inline saturating(Fixed value) noexcept
+        : detail::fixed_wrapper<Fixed>(value)
+    {}
+
+    /// Converts an integral or floating-point number, clamping it to the range of the type.
+    template <typename T> requires std::is_arithmetic_v<T>
+    constexpr inline explicit saturating(T value) noexcept
+        : detail::fixed_wrapper<Fixed>(saturate_cast<Fixed>(value))
+    {}
+
+    /// Converts another fixed-point number, clamping it to the range of the type.
+    template <typename B, typename I, unsigned int F, auto R> requires (!std::is_same_v<fixed<B, I, F, R>, Fixed>)
+    constexpr inline explicit saturating(fixed<B, I, F, R> value) noexcept
+        : detail::fixed_wrapper<Fixed>(saturate_cast<Fixed>(value))
+    {}
+
+    constexpr inline saturating& operator+=(saturating y) noexcept { m_value = add_sat(m_value, y.m_value); return *this; }
+    constexpr inline saturating& operator-=(saturating y) noexcept { m_value = sub_sat(m_value, y.m_value); return *this; }
+    constexpr inline saturating& operator*=(saturating y) noexcept { m_value = mul_sat(m_value, y.m_value); return *this; }
+    constexpr inline saturating& operator/=(saturating y) noexcept { m_value = div_sat(m_value, y.m_value); return *this; }
+
+    template <typename T> requires std::is_integral_v<T>
+    constexpr inline saturating& operator+=(T y) noexcept { m_value = add_sat(m_value, y); return *this; }
+
+    template <typename T> requires std::is_integral_v<T>
+    constexpr inline saturating& operator-=(T y) noexcept { m_value = sub_sat(m_value, y); return *this; }
+
+    template <typename T> requires std::is_integral_v<T>
+    constexpr inline saturating& operator*=(T y) noexcept { m_value = mul_sat(m_value, y); return *this; }
+
+    template <typename T> requires std::is_integral_v<T>
+    constexpr inline saturating& operator/=(T y) noexcept { m_value = div_sat(m_value, y); return *this; }
+
+    template <typename T> requires std::is_integral_v<T>
+    constexpr inline saturating& operator<<=(T y) noexcept { m_value = shl_sat(m_value, y); return *this; }
+
+    template <typename T> requires std::is_integral_v<T>
+    constexpr inline saturating& operator>>=(T y) noexcept { m_value >>= y; return *this; }
+
+    [[nodiscard]] friend constexpr inline saturating operator-(saturating x) noexcept requires std::is_signed_v<typename Fixed::base_type>
+    {
+        return sub_sat(Fixed(0), x.m_value);
+    }
+
+    [[nodiscard]] friend constexpr inline saturating operator+(saturating x, saturating y) noexcept { return x += y; }
+    [[nodiscard]] friend constexpr inline saturating operator-(saturating x, saturating y) noexcept { return x -= y; }
+    [[nodiscard]] friend constexpr inline saturating operator*(saturating x, saturating y) noexcept { return x *= y; }
+    [[nodiscard]] friend constexpr inline saturating operator/(saturating x, saturating y) noexcept { return x /= y; }
+
+    template <typename T> requires std::is_integral_v<T>
+    [[nodiscard]] friend constexpr inline saturating operator+(saturating x, T y) noexcept { return x += y; }
+
+    template <typename T> requires std::is_integral_v<T>
+    [[nodiscard]] friend constexpr inline saturating operator+(T x, saturating y) noexcept { return y += x; }
+
+    template <typename T> requires std::is_integral_v<T>
+    [[nodiscard]] friend constexpr inline saturating operator-(saturating x, T y) noexcept { return x -= y; }
+
+    template <typename T> requires std::is_integral_v<T>
+    [[nodiscard]] friend constexpr inline saturating operator-(T x, saturating y) noexcept { return sub_sat(x, y.m_value); }
+
+    template <typename T> requires std::is_integral_v<T>
+    [[nodiscard]] friend constexpr inline saturating operator*(saturating x, T y) noexcept { return x *= y; }
+
+    template <typename T> requires std::is_integral_v<T>
+    [[nodiscard]] friend constexpr inline saturating operator*(T x, saturating y) noexcept { return y *= x; }
+
+    template <typename T> requires std::is_integral_v<T>
+    [[nodiscard]] friend constexpr inline saturating operator/(saturating x, T y) noexcept { return x /= y; }
+
+    template <typename T> requires std::is_integral_v<T>
+    [[nodiscard]] friend constexpr inline saturating operator<<(saturating x, T y) noexcept { return x <<= y; }
+
+    template <typename T> requires std::is_integral_v<T>
+    [[nodiscard]] friend constexpr inline saturating operator>>(saturating x, T y) noexcept { return x >>= y; }
+
+    [[nodiscard]] friend constexpr inline bool operator==(saturating x, saturating y) noexcept
+    {
+        return x.m_value == y.m_value;
+    }
+
+    [[nodiscard]] friend constexpr inline auto operator<=>(saturating x, saturating y) noexcept
+    {
+        return x.m_value <=> y.m_value;
+    }
+
+private:
+    using detail::fixed_wrapper<Fixed>::m_value;
+};
+
+} // namespace fpm
+
+// Specializations for customization points
+namespace std
+{
+
+template <typename Fixed>
+struct hash<fpm::saturating<Fixed>>
+{
+    [[nodiscard]] std::size_t operator()(fpm::saturating<Fixed> arg) const noexcept
+    {
+        return std::hash<Fixed>{}(arg.value());
+    }
+};
+
+template <typename Fixed>
+struct numeric_limits<fpm::saturating<Fixed>> : numeric_limits<Fixed>
+{
+    static constexpr bool is_modulo = false;
+    static constexpr bool traps = false;
+
+    static constexpr fpm::saturating<Fixed> lowest() noexcept { return numeric_limits<Fixed>::lowest(); }
+    static constexpr fpm::saturating<Fixed> min() noexcept { return numeric_limits<Fixed>::min(); }
+    static constexpr fpm::saturating<Fixed> max() noexcept { return numeric_limits<Fixed>::max(); }
+    static constexpr fpm::saturating<Fixed> epsilon() noexcept { return numeric_limits<Fixed>::epsilon(); }
+    static constexpr fpm::saturating<Fixed> round_error() noexcept { return numeric_limits<Fixed>::round_error(); }
+    static constexpr fpm::saturating<Fixed> denorm_min() noexcept { return numeric_limits<Fixed>::denorm_min(); }
+};
+
+}
+
+#endif
@@ -0,0 +1,1260 @@
+#ifndef FPM_SIMD_HPP
+#define FPM_SIMD_HPP
+
+#include "accumulator.hpp"
+#include "fixed.hpp"
+#include "math.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// -------------------------------------------------------------------------------------------------
+
+#if defined(FPM_SIMD_X86)
+// Already defined
+#elif defined(FPM_NO_SIMD)
+// Explicitly disabled, only the scalar kernels are used
+#elif (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)) && (defined(__GNUC__) || defined(_MSC_VER))
+#define FPM_SIMD_X86 true
+#endif
+
+#ifdef FPM_SIMD_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#if defined(__GNUC__) || defined(__clang__)
+// Compiles a single function for the given instruction set, so that it can be selected at runtime
+// without building the whole program for that instruction set.
+#define FPM_SIMD_TARGET(isa) __attribute__((target(isa)))
+#else
+#define FPM_SIMD_TARGET(isa)
+#endif
+#endif
+
+// Forces inlining of the generic kernel code into the per-instruction-set entry points,
+// so that it's compiled (and auto-vectorized) for that instruction set.
+#if defined(__GNUC__) || defined(__clang__)
+#define FPM_SIMD_INLINE [[gnu::always_inline]] inline
+#elif defined(_MSC_VER)
+#define FPM_SIMD_INLINE __forceinline
+#else
+#define FPM_SIMD_INLINE inline
+#endif
+
+namespace fpm::simd
+{
+
+//! Instruction sets the bulk kernels can be dispatched to, in increasing order of preference.
+enum class isa
+{
+    scalar,
+    sse4_1,
+    avx2,
+    avx512,
+};
+
+namespace detail
+{
+
+[[nodiscard]] inline isa detect_isa() noexcept
+{
+#if defined(FPM_SIMD_X86) && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    const int max_leaf = info[0];
+    __cpuid(info, 1);
+    const bool sse4_1 = (info[2] & (1 << 19)) != 0;
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    // The OS must save the YMM (bits 1-2) and ZMM (bits 5-7) registers on context switches
+    const unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+    bool avx2 = false, avx512 = false;
+    if (max_leaf >= 7)
+    {
+        __cpuidex(info, 7, 0);
+        avx2 = (info[1] & (1 << 5)) != 0 && (xcr0 & 0x06) == 0x06;
+        avx512 = (info[1] & (1 << 16)) != 0 && (xcr0 & 0xE6) == 0xE6;
+    }
+    if (avx512) return isa::avx512;
+    if (avx2) return isa::avx2;
+    if (sse4_1) return isa::sse4_1;
+#elif defined(FPM_SIMD_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return isa::avx512;
+    if (__builtin_cpu_supports("avx2")) return isa::avx2;
+    if (__builtin_cpu_supports("sse4.1")) return isa::sse4_1;
+#endif
+    return isa::scalar;
+}
+
+}
+
+//! Returns the best instruction set supported by the CPU this program is running on.
+//! The bulk operations in this namespace dispatch to it. It's detected once, on first use.
+[[nodiscard]] inline isa active_isa() noexcept
+{
+    static const isa s_isa = detail::detect_isa();
+    return s_isa;
+}
+
+namespace detail
+{
+
+enum class op
+{
+    add,
+    sub,
+    mul,
+    div,
+    fma,
+    scale,
+};
+
+/// The scalar reference for every kernel: the operators of fpm::fixed itself.
+template <op Op, typename Fixed>
+constexpr inline Fixed apply_scalar(Fixed x, Fixed y, Fixed z) noexcept
+{
+    if constexpr (Op == op::add) return x + y;
+    else if constexpr (Op == op::sub) return x - y;
+    else if constexpr (Op == op::mul || Op == op::scale) return x * y;
+    else if constexpr (Op == op::div) return x / y;
+    else return x * y + z;
+}
+
+/// Whether the kernels can reproduce the rounding of Fixed: they only implement the bool EnableRounding
+/// modes, and the bulk products also stochastic rounding. The other rounding modes use the scalar operators.
+template <typename Fixed>
+inline constexpr bool kernel_rounding_v =
+    Fixed::rounding_mode == rounding::toward_zero || Fixed::rounding_mode == rounding::half_away_from_zero;
+
+/// Whether the kernels of Fixed round half away from zero, instead of truncating.
+template <typename Fixed>
+inline constexpr bool kernel_round_v = Fixed::rounding_mode == rounding::half_away_from_zero;
+
+#ifdef FPM_SIMD_X86
+
+// The multiplication kernels below reproduce fpm::fixed's operator* for 32-bit base types.
+//
+// The scalar operator divides the signed 64-bit product by 2**F, rounding toward zero and, with
+// rounding enabled, half away from zero. Both are symmetric around zero, so they can be computed
+// on the magnitudes with unsigned multiplies and logical shifts (which exist on every instruction
+// set, unlike their signed 64-bit counterparts) and the sign of x*y applied afterwards.
+// The magnitude of INT32_MIN does not fit in a signed lane, but is correct when read as unsigned.
+// Only the low 32 bits of each result are kept, which is the same truncation the scalar operator
+// does when narrowing to the base type.
+//
+// Stochastic rounding adds a random bias below 2**F to the signed product before the arithmetic
+// shift. On the magnitude of a negative product, that is the same as adding 2**F - 1 - bias, which
+// is the bias with its low F bits inverted. The random bits are the ones the scalar operator would
+// draw: a hash of consecutive counters, one per element, computed by the hash_* functions.
+
+template <unsigned int F>
+inline constexpr std::uint32_t bias_mask = static_cast<std::uint32_t>((std::uint64_t{1} << F) - 1);
+
+FPM_SIMD_TARGET("sse4.1") inline __m128i hash_sse4_1(__m128i x) noexcept
+{
+    x = _mm_xor_si128(x, _mm_srli_epi32(x, 16));
+    x = _mm_mullo_epi32(x, _mm_set1_epi32(0x7FEB352D));
+    x = _mm_xor_si128(x, _mm_srli_epi32(x, 15));
+    x = _mm_mullo_epi32(x, _mm_set1_epi32(static_cast<int>(0x846CA68Bu)));
+    return _mm_xor_si128(x, _mm_srli_epi32(x, 16));
+}
+
+FPM_SIMD_TARGET("avx2") inline __m256i hash_avx2(__m256i x) noexcept
+{
+    x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 16));
+    x = _mm256_mullo_epi32(x, _mm256_set1_epi32(0x7FEB352D));
+    x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 15));
+    x = _mm256_mullo_epi32(x, _mm256_set1_epi32(static_cast<int>(0x846CA68Bu)));
+    return _mm256_xor_si256(x, _mm256_srli_epi32(x, 16));
+}
+
+FPM_SIMD_TARGET("avx512f") inline __m512i hash_avx512(__m512i x) noexcept
+{
+    x = _mm512_xor_si512(x, _mm512_srli_epi32(x, 16));
+    x = _mm512_mullo_epi32(x, _mm512_set1_epi32(0x7FEB352D));
+    x = _mm512_xor_si512(x, _mm512_srli_epi32(x, 15));
+    x = _mm512_mullo_epi32(x, _mm512_set1_epi32(static_cast<int>(0x846CA68Bu)));
+    return _mm512_xor_si512(x, _mm512_srli_epi32(x, 16));
+}
+
+template <unsigned int F, rounding Mode>
+FPM_SIMD_TARGET("sse4.1") inline __m128i mul_sse4_1(__m128i x, __m128i y, __m128i random) noexcept
+{
+    const __m128i sign = _mm_srai_epi32(_mm_xor_si128(x, y), 31);
+    const __m128i ax = _mm_abs_epi32(x);
+    const __m128i ay = _mm_abs_epi32(y);
+    __m128i even = _mm_mul_epu32(ax, ay);
+    __m128i odd = _mm_mul_epu32(_mm_srli_epi64(ax, 32), _mm_srli_epi64(ay, 32));
+    if constexpr (Mode == rounding::half_away_from_zero)
+    {
+        const __m128i half = _mm_set1_epi64x(std::int64_t{1} << (F - 1));
+        even = _mm_add_epi64(even, half);
+        odd = _mm_add_epi64(odd, half);
+    }
+    else if constexpr (Mode == rounding::stochastic)
+    {
+        const __m128i bias = _mm_and_si128(_mm_xor_si128(random, sign), _mm_set1_epi32(static_cast<int>(bias_mask<F>)));
+        even = _mm_add_epi64(even, _mm_and_si128(bias, _mm_set1_epi64x(0xFFFFFFFF)));
+        odd = _mm_add_epi64(odd, _mm_srli_epi64(bias, 32));
+    }
+    even = _mm_srli_epi64(even, F);
+    odd = _mm_slli_epi64(_mm_srli_epi64(odd, F), 32);
+    const __m128i magnitude = _mm_blend_epi16(even, odd, 0xCC);
+    return _mm_sub_epi32(_mm_xor_si128(magnitude, sign), sign);
+}
+
+template <unsigned int F, rounding Mode>
+FPM_SIMD_TARGET("avx2") inline __m256i mul_avx2(__m256i x, __m256i y, __m256i random) noexcept
+{
+    const __m256i sign = _mm256_srai_epi32(_mm256_xor_si256(x, y), 31);
+    const __m256i ax = _mm256_abs_epi32(x);
+    const __m256i ay = _mm256_abs_epi32(y);
+    __m256i even = _mm256_mul_epu32(ax, ay);
+    __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(ax, 32), _mm256_srli_epi64(ay, 32));
+    if constexpr (Mode == rounding::half_away_from_zero)
+    {
+        const __m256i half = _mm256_set1_epi64x(std::int64_t{1} << (F - 1));
+        even = _mm256_add_epi64(even, half);
+        odd = _mm256_add_epi64(odd, half);
+    }
+    else if constexpr (Mode == rounding::stochastic)
+    {
+        const __m256i bias = _mm256_and_si256(_mm256_xor_si256(random, sign), _mm256_set1_epi32(static_cast<int>(bias_mask<F>)));
+        even = _mm256_add_epi64(even, _mm256_and_si256(bias, _mm256_set1_epi64x(0xFFFFFFFF)));
+        odd = _mm256_add_epi64(odd, _mm256_srli_epi64(bias, 32));
+    }
+    even = _mm256_srli_epi64(even, F);
+    odd = _mm256_slli_epi64(_mm256_srli_epi64(odd, F), 32);
+    const __m256i magnitude = _mm256_blend_epi32(even, odd, 0xAA);
+    return _mm256_sub_epi32(_mm256_xor_si256(magnitude, sign), sign);
+}
+
+template <unsigned int F, rounding Mode>
+FPM_SIMD_TARGET("avx512f") inline __m512i mul_avx512(__m512i x, __m512i y, __m512i random) noexcept
+{
+    const __m512i sign = _mm512_srai_epi32(_mm512_xor_si512(x, y), 31);
+    const __m512i ax = _mm512_abs_epi32(x);
+    const __m512i ay = _mm512_abs_epi32(y);
+    __m512i even = _mm512_mul_epu32(ax, ay);
+    __m512i odd = _mm512_mul_epu32(_mm512_srli_epi64(ax, 32), _mm512_srli_epi64(ay, 32));
+    if constexpr (Mode == rounding::half_away_from_zero)
+    {
+        const __m512i half = _mm512_set1_epi64(std::int64_t{1} << (F - 1));
+        even = _mm512_add_epi64(even, half);
+        odd = _mm512_add_epi64(odd, half);
+    }
+    else if constexpr (Mode == rounding::stochastic)
+    {
+        const __m512i bias = _mm512_and_si512(_mm512_xor_si512(random, sign), _mm512_set1_epi32(static_cast<int>(bias_mask<F>)));
+        even = _mm512_add_epi64(even, _mm512_and_si512(bias, _mm512_set1_epi64(0xFFFFFFFF)));
+        odd = _mm512_add_epi64(odd, _mm512_srli_epi64(bias, 32));
+    }
+    even = _mm512_srli_epi64(even, F);
+    odd = _mm512_slli_epi64(_mm512_srli_epi64(odd, F), 32);
+    const __m512i magnitude = _mm512_mask_blend_epi32(0xAAAA, even, odd);
+    return _mm512_sub_epi32(_mm512_xor_si512(magnitude, sign), sign);
+}
+
+// Each kernel processes as many whole registers as fit in `n` and returns the number of elements
+// it processed. The caller finishes the remainder with the scalar operators. For stochastic
+// rounding, `first` is the hash input of the first element's random bits.
+
+template <op Op, unsigned int F, rounding Mode>
+FPM_SIMD_TARGET("sse4.1") inline std::size_t kernel_sse4_1(const std::int32_t* x, const std::int32_t* y, const std::int32_t* z, std::int32_t* out, std::size_t n, std::uint32_t first) noexcept
+{
+    __m128i counters = _mm_add_epi32(_mm_set1_epi32(static_cast<int>(first)), _mm_setr_epi32(0, 1, 2, 3));
+    __m128i s{};
+    if constexpr (Op == op::scale) s = _mm_set1_epi32(*y);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        const __m128i vx = _mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i));
+        __m128i vy = s;
+        if constexpr (Op != op::scale) vy = _mm_loadu_si128(reinterpret_cast<const __m128i*>(y + i));
+        __m128i random{};
+        if constexpr (Mode == rounding::stochastic)
+        {
+            random = hash_sse4_1(counters);
+            counters = _mm_add_epi32(counters, _mm_set1_epi32(4));
+        }
+        __m128i r;
+        if constexpr (Op == op::add) r = _mm_add_epi32(vx, vy);
+        else if constexpr (Op == op::sub) r = _mm_sub_epi32(vx, vy);
+        else if constexpr (Op == op::fma) r = _mm_add_epi32(mul_sse4_1<F, Mode>(vx, vy, random), _mm_loadu_si128(reinterpret_cast<const __m128i*>(z + i)));
+        else r = mul_sse4_1<F, Mode>(vx, vy, random);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), r);
+    }
+    return i;
+}
+
+template <op Op, unsigned int F, rounding Mode>
+FPM_SIMD_TARGET("avx2") inline std::size_t kernel_avx2(const std::int32_t* x, const std::int32_t* y, const std::int32_t* z, std::int32_t* out, std::size_t n, std::uint32_t first) noexcept
+{
+    __m256i counters = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(first)), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    __m256i s{};
+    if constexpr (Op == op::scale) s = _mm256_set1_epi32(*y);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        const __m256i vx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i));
+        __m256i vy = s;
+        if constexpr (Op != op::scale) vy = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(y + i));
+        __m256i random{};
+        if constexpr (Mode == rounding::stochastic)
+        {
+            random = hash_avx2(counters);
+            counters = _mm256_add_epi32(counters, _mm256_set1_epi32(8));
+        }
+        __m256i r;
+        if constexpr (Op == op::add) r = _mm256_add_epi32(vx, vy);
+        else if constexpr (Op == op::sub) r = _mm256_sub_epi32(vx, vy);
+        else if constexpr (Op == op::fma) r = _mm256_add_epi32(mul_avx2<F, Mode>(vx, vy, random), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(z + i)));
+        else r = mul_avx2<F, Mode>(vx, vy, random);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), r);
+    }
+    return i;
+}
+
+template <op Op, unsigned int F, rounding Mode>
+FPM_SIMD_TARGET("avx512f") inline std::size_t kernel_avx512(const std::int32_t* x, const std::int32_t* y, const std::int32_t* z, std::int32_t* out, std::size_t n, std::uint32_t first) noexcept
+{
+    __m512i counters = _mm512_add_epi32(_mm512_set1_epi32(static_cast<int>(first)), _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+    __m512i s{};
+    if constexpr (Op == op::scale) s = _mm512_set1_epi32(*y);
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        const __m512i vx = _mm512_loadu_si512(x + i);
+        __m512i vy = s;
+        if constexpr (Op != op::scale) vy = _mm512_loadu_si512(y + i);
+        __m512i random{};
+        if constexpr (Mode == rounding::stochastic)
+        {
+            random = hash_avx512(counters);
+            counters = _mm512_add_epi32(counters, _mm512_set1_epi32(16));
+        }
+        __m512i r;
+        if constexpr (Op == op::add) r = _mm512_add_epi32(vx, vy);
+        else if constexpr (Op == op::sub) r = _mm512_sub_epi32(vx, vy);
+        else if constexpr (Op == op::fma) r = _mm512_add_epi32(mul_avx512<F, Mode>(vx, vy, random), _mm512_loadu_si512(z + i));
+        else r = mul_avx512<F, Mode>(vx, vy, random);
+        _mm512_storeu_si512(out + i, r);
+    }
+    return i;
+}
+
+#endif
+
+/// Applies \a Op element-wise using the kernels for instruction set \a target.
+/// For Op::scale, \a y points to a single element. \a z is only used by Op::fma.
+/// Types and operations without a vector kernel (and any remainder) use the scalar operators.
+template <op Op, typename Fixed>
+inline void apply(isa target, const Fixed* x, const std::type_identity_t<Fixed>* y, const std::type_identity_t<Fixed>* z, Fixed* out, std::size_t n) noexcept
+{
+    using B = typename Fixed::base_type;
+    constexpr auto F = Fixed::fraction_bits;
+    constexpr auto Mode = Fixed::rounding_mode;
+    static_assert(sizeof(Fixed) == sizeof(B), "fixed must have the same layout as its base type");
+
+    std::size_t i = 0;
+#ifdef FPM_SIMD_X86
+    if constexpr (std::is_same_v<B, std::int32_t> && Op != op::div && (kernel_rounding_v<Fixed> || Mode == rounding::stochastic))
+    {
+        // fixed is a standard-layout wrapper around its base type, so it can be accessed as such
+        const auto raw_x = reinterpret_cast<const std::int32_t*>(x);
+        const auto raw_y = reinterpret_cast<const std::int32_t*>(y);
+        const auto raw_z = reinterpret_cast<const std::int32_t*>(z);
+        const auto raw_out = reinterpret_cast<std::int32_t*>(out);
+
+        // Products with stochastic rounding take the next random numbers of the calling thread, one per
+        // element like the scalar operator. The kernels stop before the counter wraps around, after which
+        // the scalar operator continues with new keys.
+        constexpr bool draws = (Mode == rounding::stochastic) && Op != op::add && Op != op::sub;
+        std::size_t count = n;
+        std::uint32_t first = 0;
+        if constexpr (draws)
+        {
+            const fpm::detail::stochastic_stream& stream = fpm::detail::stochastic_state();
+            count = std::min<std::size_t>(n, 0xFFFFFFFFu - stream.counter);
+            first = stream.counter + stream.key_low;
+        }
+        switch (target)
+        {
+        case isa::avx512: i = kernel_avx512<Op, F, Mode>(raw_x, raw_y, raw_z, raw_out, count, first); break;
+        case isa::avx2:   i = kernel_avx2<Op, F, Mode>(raw_x, raw_y, raw_z, raw_out, count, first); break;
+        case isa::sse4_1: i = kernel_sse4_1<Op, F, Mode>(raw_x, raw_y, raw_z, raw_out, count, first); break;
+        case isa::scalar: break;
+        }
+        if constexpr (draws)
+        {
+            fpm::detail::stochastic_state().counter += static_cast<std::uint32_t>(i);
+        }
+    }
+#else
+    static_cast<void>(target);
+#endif
+    for (; i < n; ++i)
+    {
+        const auto vy = (Op == op::scale) ? *y : y[i];
+        const auto vz = (Op == op::fma) ? z[i] : Fixed{};
+        out[i] = apply_scalar<Op>(x[i], vy, vz);
+    }
+}
+
+#ifdef FPM_SIMD_X86
+
+// The reduction kernels add up 32-bit elements, or their 64-bit products, in 64-bit lanes. Integer
+// additions give the same sum in any order, so this is exactly the sum of fpm::accumulator, including
+// the wrap-around if it doesn't fit. Each kernel adds the lanes to `total` and returns the number of
+// elements it processed.
+
+FPM_SIMD_TARGET("sse4.1") inline std::uint64_t reduce_sse4_1(__m128i sum) noexcept
+{
+    alignas(16) std::uint64_t lanes[2];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), sum);
+    return lanes[0] + lanes[1];
+}
+
+FPM_SIMD_TARGET("sse4.1") inline std::size_t dot_sse4_1(const std::int32_t* x, const std::int32_t* y, std::size_t n, std::uint64_t& total) noexcept
+{
+    __m128i even = _mm_setzero_si128(), odd = _mm_setzero_si128();
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        const __m128i vx = _mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i));
+        const __m128i vy = _mm_loadu_si128(reinterpret_cast<const __m128i*>(y + i));
+        even = _mm_add_epi64(even, _mm_mul_epi32(vx, vy));
+        odd = _mm_add_epi64(odd, _mm_mul_epi32(_mm_srli_epi64(vx, 32), _mm_srli_epi64(vy, 32)));
+    }
+    total += reduce_sse4_1(_mm_add_epi64(even, odd));
+    return i;
+}
+
+FPM_SIMD_TARGET("sse4.1") inline std::size_t sum_sse4_1(const std::int32_t* x, std::size_t n, std::uint64_t& total) noexcept
+{
+    __m128i sum = _mm_setzero_si128();
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        const __m128i vx = _mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i));
+        sum = _mm_add_epi64(sum, _mm_add_epi64(_mm_cvtepi32_epi64(vx), _mm_cvtepi32_epi64(_mm_srli_si128(vx, 8))));
+    }
+    total += reduce_sse4_1(sum);
+    return i;
+}
+
+FPM_SIMD_TARGET("avx2") inline std::uint64_t reduce_avx2(__m256i sum) noexcept
+{
+    alignas(32) std::uint64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), sum);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+
+FPM_SIMD_TARGET("avx2") inline std::size_t dot_avx2(const std::int32_t* x, const std::int32_t* y, std::size_t n, std::uint64_t& total) noexcept
+{
+    __m256i even = _mm256_setzero_si256(), odd = _mm256_setzero_si256();
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        const __m256i vx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i));
+        const __m256i vy = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(y + i));
+        even = _mm256_add_epi64(even, _mm256_mul_epi32(vx, vy));
+        odd = _mm256_add_epi64(odd, _mm256_mul_epi32(_mm256_srli_epi64(vx, 32), _mm256_srli_epi64(vy, 32)));
+    }
+    total += reduce_avx2(_mm256_add_epi64(even, odd));
+    return i;
+}
+
+FPM_SIMD_TARGET("avx2") inline std::size_t sum_avx2(const std::int32_t* x, std::size_t n, std::uint64_t& total) noexcept
+{
+    __m256i sum = _mm256_setzero_si256();
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        const __m256i vx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i));
+        const __m256i low = _mm256_cvtepi32_epi64(_mm256_castsi256_si128(vx));
+        const __m256i high = _mm256_cvtepi32_epi64(_mm256_extracti128_si256(vx, 1));
+        sum = _mm256_add_epi64(sum, _mm256_add_epi64(low, high));
+    }
+    total += reduce_avx2(sum);
+    return i;
+}
+
+FPM_SIMD_TARGET("avx512f") inline std::size_t dot_avx512(const std::int32_t* x, const std::int32_t* y, std::size_t n, std::uint64_t& total) noexcept
+{
+    __m512i even = _mm512_setzero_si512(), odd = _mm512_setzero_si512();
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        const __m512i vx = _mm512_loadu_si512(x + i);
+        const __m512i vy = _mm512_loadu_si512(y + i);
+        even = _mm512_add_epi64(even, _mm512_mul_epi32(vx, vy));
+        odd = _mm512_add_epi64(odd, _mm512_mul_epi32(_mm512_srli_epi64(vx, 32), _mm512_srli_epi64(vy, 32)));
+    }
+    total += static_cast<std::uint64_t>(_mm512_reduce_add_epi64(_mm512_add_epi64(even, odd)));
+    return i;
+}
+
+FPM_SIMD_TARGET("avx512f") inline std::size_t sum_avx512(const std::int32_t* x, std::size_t n, std::uint64_t& total) noexcept
+{
+    __m512i sum = _mm512_setzero_si512();
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        const __m512i vx = _mm512_loadu_si512(x + i);
+        const __m512i low = _mm512_cvtepi32_epi64(_mm512_castsi512_si256(vx));
+        const __m512i high = _mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(vx, 1));
+        sum = _mm512_add_epi64(sum, _mm512_add_epi64(low, high));
+    }
+    total += static_cast<std::uint64_t>(_mm512_reduce_add_epi64(sum));
+    return i;
+}
+
+#endif
+
+/// Whether the reduction kernels apply to Fixed: 32-bit base types with a 64-bit intermediate type
+template <typename Fixed>
+inline constexpr bool reduce_kernel_v =
+    std::is_same_v<typename Fixed::base_type, std::int32_t> && std::is_same_v<typename Fixed::intermediate_type, std::int64_t>;
+
+/// Adds x[i] * y[i] to \a acc using the kernels for instruction set \a target.
+template <typename Fixed>
+inline void apply_dot(isa target, const Fixed* x, const std::type_identity_t<Fixed>* y, std::size_t n, accumulator<Fixed>& acc) noexcept
+{
+    std::size_t i = 0;
+#ifdef FPM_SIMD_X86
+    if constexpr (reduce_kernel_v<Fixed>)
+    {
+        const auto raw_x = reinterpret_cast<const std::int32_t*>(x);
+        const auto raw_y = reinterpret_cast<const std::int32_t*>(y);
+        std::uint64_t total = static_cast<std::uint64_t>(acc.raw_value());
+        switch (target)
+        {
+        case isa::avx512: i = dot_avx512(raw_x, raw_y, n, total); break;
+        case isa::avx2:   i = dot_avx2(raw_x, raw_y, n, total); break;
+        case isa::sse4_1: i = dot_sse4_1(raw_x, raw_y, n, total); break;
+        case isa::scalar: break;
+        }
+        acc = accumulator<Fixed>::from_raw_value(static_cast<std::int64_t>(total));
+    }
+#else
+    static_cast<void>(target);
+#endif
+    for (; i < n; ++i)
+    {
+        acc.fma(x[i], y[i]);
+    }
+}
+
+/// Adds x[i] to \a acc using the kernels for instruction set \a target.
+template <typename Fixed>
+inline void apply_sum(isa target, const Fixed* x, std::size_t n, accumulator<Fixed>& acc) noexcept
+{
+    std::size_t i = 0;
+#ifdef FPM_SIMD_X86
+    if constexpr (reduce_kernel_v<Fixed>)
+    {
+        // The sum of the elements, shifted into the accumulator at once
+        std::uint64_t total = 0;
+        const auto raw_x = reinterpret_cast<const std::int32_t*>(x);
+        switch (target)
+        {
+        case isa::avx512: i = sum_avx512(raw_x, n, total); break;
+        case isa::avx2:   i = sum_avx2(raw_x, n, total); break;
+        case isa::sse4_1: i = sum_sse4_1(raw_x, n, total); break;
+        case isa::scalar: break;
+        }
+        const std::uint64_t shifted = total << Fixed::fraction_bits;
+        acc += accumulator<Fixed>::from_raw_value(static_cast<std::int64_t>(shifted));
+    }
+#else
+    static_cast<void>(target);
+#endif
+    for (; i < n; ++i)
+    {
+        acc += x[i];
+    }
+}
+
+}
+
+// The bulk operations below produce exactly the same results as applying the scalar operators of
+// fpm::fixed to each element, for every rounding mode. The output may be the same span as one of
+// the inputs, but must not otherwise overlap them. All spans must have the same size.
+// The fixed-point type is deduced from the output span, or can be given explicitly, e.g.
+// `fpm::simd::mul<fpm::fixed_16_16>(x, y, out)` for vectors or arrays.
+
+//! Computes out[i] = x[i] + y[i]
+template <typename Fixed> requires is_fixed_v<Fixed>
+inline void add(std::span<const std::type_identity_t<Fixed>> x, std::span<const std::type_identity_t<Fixed>> y, std::span<Fixed> out) noexcept
+{
+    assert(x.size() == out.size() && y.size() == out.size());
+    detail::apply<detail::op::add>(active_isa(), x.data(), y.data(), nullptr, out.data(), out.size());
+}
+
+//! Computes out[i] = x[i] - y[i]
+template <typename Fixed> requires is_fixed_v<Fixed>
+inline void sub(std::span<const std::type_identity_t<Fixed>> x, std::span<const std::type_identity_t<Fixed>> y, std::span<Fixed> out) noexcept
+{
+    assert(x.size() == out.size() && y.size() == out.size());
+    detail::apply<detail::op::sub>(active_isa(), x.data(), y.data(), nullptr, out.data(), out.size());
+}
+
+//! Computes out[i] = x[i] * y[i]
+template <typename Fixed> requires is_fixed_v<Fixed>
+inline void mul(std::span<const std::type_identity_t<Fixed>> x, std::span<const std::type_identity_t<Fixed>> y, std::span<Fixed> out) noexcept
+{
+    assert(x.size() == out.size() && y.size() == out.size());
+    detail::apply<detail::op::mul>(active_isa(), x.data(), y.data(), nullptr, out.data(), out.size());
+}
+
+//! Computes out[i] = x[i] / y[i]
+//! There is no vector integer division, so this always uses the scalar operator.
+template <typename Fixed> requires is_fixed_v<Fixed>
+inline void div(std::span<const std::type_identity_t<Fixed>> x, std::span<const std::type_identity_t<Fixed>> y, std::span<Fixed> out) noexcept
+{
+    assert(x.size() == out.size() && y.size() == out.size());
+    detail::apply<detail::op::div>(active_isa(), x.data(), y.data(), nullptr, out.data(), out.size());
+}
+
+//! Computes out[i] = x[i] * y[i] + z[i]
+//! The product is rounded before the addition, exactly like the scalar expression.
+template <typename Fixed> requires is_fixed_v<Fixed>
+inline void fma(std::span<const std::type_identity_t<Fixed>> x, std::span<const std::type_identity_t<Fixed>> y, std::span<const std::type_identity_t<Fixed>> z, std::span<Fixed> out) noexcept
+{
+    assert(x.size() == out.size() && y.size() == out.size() && z.size() == out.size());
+    detail::apply<detail::op::fma>(active_isa(), x.data(), y.data(), z.data(), out.data(), out.size());
+}
+
+//! Computes out[i] = x[i] * s
+template <typename Fixed> requires is_fixed_v<Fixed>
+inline void scale(std::span<const std::type_identity_t<Fixed>> x, std::type_identity_t<Fixed> s, std::span<Fixed> out) noexcept
+{
+    assert(x.size() == out.size());
+    detail::apply<detail::op::scale>(active_isa(), x.data(), &s, nullptr, out.data(), out.size());
+}
+
+// The reductions below add up their elements in an fpm::accumulator, at the full precision of the
+// intermediate type, and round the result once. Their result is exactly that of the scalar loop.
+
+//! Returns the sum of x[i] * y[i], rounded once.
+template <typename Fixed> requires is_fixed_v<Fixed>
+[[nodiscard]] inline Fixed dot(std::span<const std::type_identity_t<Fixed>> x, std::span<const std::type_identity_t<Fixed>> y) noexcept
+{
+    assert(x.size() == y.size());
+    accumulator<Fixed> acc;
+    detail::apply_dot(active_isa(), x.data(), y.data(), x.size(), acc);
+    return acc.value();
+}
+
+//! Returns the sum of x[i]. Only the total has to fit in Fixed, partial sums may use the whole intermediate type.
+template <typename Fixed> requires is_fixed_v<Fixed>
+[[nodiscard]] inline Fixed sum(std::span<const std::type_identity_t<Fixed>> x) noexcept
+{
+    accumulator<Fixed> acc;
+    detail::apply_sum(active_isa(), x.data(), x.size(), acc);
+    return acc.value();
+}
+
+
+// =================================================================================================
+// Array math functions
+//
+// These evaluate the same algorithms as the scalar functions in math.hpp, with the same
+// coefficients, but without branches so that every lane of a vector register can follow the
+// same path. The code is written once, in plain C++, and compiled for each instruction set by
+// inlining it into the entry points below, which leaves the vectorization to the compiler.
+// Elements are processed in fixed-size blocks copied to local arrays, so the compiler knows the
+// trip count and that the input and output don't overlap.
+//
+// Divisions by constants are multiplications by a reciprocal, computed at compile time, followed
+// by one correction step, like fpm::divisor. Each function is only vectorized for the fraction
+// bits where its intermediate results fit; other types use the scalar functions.
+
+namespace detail
+{
+
+/// Number of elements processed at a time by the array math kernels.
+inline constexpr std::size_t lane_block = 64;
+
+/// Computes fixed-point x * y like operator*, for 32-bit base types and non-negative x and y.
+template <unsigned int F, bool R>
+FPM_SIMD_INLINE constexpr std::uint32_t lane_mul(std::uint32_t x, std::uint32_t y) noexcept
+{
+    const std::uint64_t product = std::uint64_t{x} * y + (R ? std::uint64_t{1} << (F - 1) : 0);
+    return static_cast<std::uint32_t>(product >> F);
+}
+
+/// Computes floor(a * 2**Shift / D) for a constant D > 0, for a * 2**Shift < 2**(30 + bit_width(D)).
+/// The multiplier and the quotient are below 2**31, so the multiplication is 32x32-bit and the rest is 32-bit.
+template <std::uint32_t D, unsigned int Shift>
+FPM_SIMD_INLINE constexpr std::uint32_t lane_divide(std::uint32_t a) noexcept
+{
+    constexpr unsigned int s = 30 + std::bit_width(D);
+    static_assert(Shift < 32 && Shift <= s);
+    constexpr std::uint64_t multiplier = ((std::uint64_t{1} << s) + D - 1) / D;
+
+    // The multiplier is at most D too large per 2**s, so the estimate is exact or one too large.
+    // The remainder is then in (-D, D), so its lowest 32 bits tell which.
+    const auto q = static_cast<std::uint32_t>((std::uint64_t{a} * multiplier) >> (s - Shift));
+    const auto remainder = static_cast<std::int32_t>((a << Shift) - q * D);
+    return q - ((remainder < 0) ? 1 : 0);
+}
+
+template <typename Fixed>
+inline constexpr bool lane_math_v = std::is_same_v<typename Fixed::base_type, std::int32_t> && kernel_rounding_v<Fixed>;
+
+/// Turns x from the [0..2*PI] domain into the [0..4] domain, like fpm::detail::sin_reduce.
+/// Requires two_pi * 2**R < 2**31.
+template <typename Fixed>
+FPM_SIMD_INLINE constexpr std::int32_t lane_sin_reduce(std::int32_t x) noexcept
+{
+    constexpr auto F = Fixed::fraction_bits;
+    constexpr bool R = kernel_round_v<Fixed>;
+    constexpr std::int32_t one = std::int32_t{1} << F;
+    constexpr auto two_pi = static_cast<std::uint32_t>(Fixed::two_pi().raw_value());
+    constexpr auto half_pi = static_cast<std::uint32_t>(Fixed::half_pi().raw_value());
+
+    // x % two_pi and then x / half_pi, both truncating, on the magnitude
+    const std::uint32_t a = (x < 0) ? 0u - static_cast<std::uint32_t>(x) : static_cast<std::uint32_t>(x);
+    const std::uint32_t rest = a - lane_divide<two_pi, 0>(a) * two_pi;
+    std::uint32_t quotient = lane_divide<half_pi, R ? F + 1 : F>(rest);
+    quotient = R ? (quotient + 1) >> 1 : quotient;
+
+    const std::int32_t value = (x < 0) ? -static_cast<std::int32_t>(quotient) : static_cast<std::int32_t>(quotient);
+    return (value < 0) ? value + 4 * one : value;
+}
+
+/// Calculates sin(x * PI/2) for x in [0..4], like fpm::detail::sin_quadrant.
+template <typename Fixed>
+FPM_SIMD_INLINE constexpr std::int32_t lane_sin_quadrant(std::int32_t x) noexcept
+{
+    constexpr auto F = Fixed::fraction_bits;
+    constexpr bool R = kernel_round_v<Fixed>;
+    constexpr std::int32_t one = std::int32_t{1} << F;
+    constexpr auto pi = static_cast<std::uint32_t>(Fixed::pi().raw_value());
+    constexpr auto fA = static_cast<std::uint32_t>((Fixed::pi() - 3).raw_value());
+    constexpr auto fB = static_cast<std::uint32_t>((Fixed::two_pi() - 5).raw_value());
+
+    // Reduce domain to [0..1], remembering the sign of the result
+    const bool negate = x > 2 * one;
+    x = negate ? x - 2 * one : x;
+    x = (x > one) ? 2 * one - x : x;
+
+    // Every operand is non-negative, so only the magnitude is multiplied and the sign is applied last
+    const auto u = static_cast<std::uint32_t>(x);
+    const std::uint32_t x2 = lane_mul<F, R>(u, u);
+    const std::uint32_t poly = pi - lane_mul<F, R>(x2, fB - lane_mul<F, R>(x2, fA));
+    const auto magnitude = static_cast<std::int32_t>(lane_mul<F, R>(u, poly) / 2);
+    return negate ? -magnitude : magnitude;
+}
+
+/// Calculates sin(x) for a block, in two passes: a single loop over both steps vectorizes
+/// much worse, since the compiler then widens all of it to the 64-bit lanes of the reduction.
+template <typename Fixed>
+FPM_SIMD_INLINE void lane_sin(const std::int32_t* x, std::int32_t* out) noexcept
+{
+    std::int32_t t[lane_block];
+    for (std::size_t i = 0; i < lane_block; ++i)
+    {
+        t[i] = lane_sin_reduce<Fixed>(x[i]);
+    }
+    for (std::size_t i = 0; i < lane_block; ++i)
+    {
+        out[i] = lane_sin_quadrant<Fixed>(t[i]);
+    }
+}
+
+template <typename Fixed>
+struct sin_lanes
+{
+    // Keeps |x % 2pi| * 2**(F+1) within the range of lane_divide
+    static constexpr bool enabled = lane_math_v<Fixed> && Fixed::fraction_bits + (kernel_round_v<Fixed> ? 1 : 0) <= 28;
+
+    static Fixed scalar(Fixed x) noexcept { return fpm::sin(x); }
+
+    FPM_SIMD_INLINE static void block(const std::int32_t* x, std::int32_t* out) noexcept
+    {
+        lane_sin<Fixed>(x, out);
+    }
+};
+
+template <typename Fixed>
+struct cos_lanes
+{
+    static constexpr bool enabled = sin_lanes<Fixed>::enabled;
+
+    static Fixed scalar(Fixed x) noexcept { return fpm::cos(x); }
+
+    FPM_SIMD_INLINE static void block(const std::int32_t* x, std::int32_t* out) noexcept
+    {
+        constexpr std::int32_t half_pi = Fixed::half_pi().raw_value();
+        constexpr std::int32_t three_half_pi = (Fixed::two_pi() - Fixed::half_pi()).raw_value();
+        std::int32_t shifted[lane_block];
+        for (std::size_t i = 0; i < lane_block; ++i)
+        {
+            // Prevent an overflow due to the addition of pi/2
+            shifted[i] = (x[i] > 0) ? x[i] - three_half_pi : half_pi + x[i];
+        }
+        lane_sin<Fixed>(shifted, out);
+    }
+};
+
+template <typename Fixed>
+struct sincos_lanes
+{
+    static constexpr bool enabled = sin_lanes<Fixed>::enabled;
+    static constexpr bool two_outputs = true;
+
+    static std::pair<Fixed, Fixed> scalar(Fixed x) noexcept { return fpm::sincos(x); }
+
+    FPM_SIMD_INLINE static void block(const std::int32_t* x, std::int32_t* sin_out, std::int32_t* cos_out) noexcept
+    {
+        constexpr std::int32_t one = std::int32_t{1} << Fixed::fraction_bits;
+        std::int32_t t[lane_block];
+        for (std::size_t i = 0; i < lane_block; ++i)
+        {
+            t[i] = lane_sin_reduce<Fixed>(x[i]);
+        }
+        for (std::size_t i = 0; i < lane_block; ++i)
+        {
+            sin_out[i] = lane_sin_quadrant<Fixed>(t[i]);
+            cos_out[i] = lane_sin_quadrant<Fixed>((t[i] >= 3 * one) ? t[i] - 3 * one : t[i] + one);
+        }
+    }
+};
+
+template <typename Fixed>
+struct exp_lanes
+{
+    static constexpr bool enabled = lane_math_v<Fixed>;
+
+    static Fixed scalar(Fixed x) noexcept { return fpm::exp(x); }
+
+    FPM_SIMD_INLINE static void block(const std::int32_t* x, std::int32_t* out) noexcept
+    {
+        using W = std::int64_t;
+        constexpr auto F = Fixed::fraction_bits;
+        constexpr bool R = kernel_round_v<Fixed>;
+        constexpr unsigned int P = fpm::detail::poly_fraction_bits<W>;
+        constexpr auto& c = fpm::detail::poly_coefficients<W, &fpm::detail::exp_taylor, 0, fpm::detail::exp_bits<std::int32_t, W>>;
+        constexpr auto& powers = fpm::detail::exp_powers<std::int32_t, W, F>;
+        constexpr int lowest = fpm::detail::exp_lowest<F>, highest = fpm::detail::exp_highest<std::int32_t, F>;
+        constexpr std::int32_t mask = static_cast<std::int32_t>((std::uint32_t{1} << (F - 1) << 1) - 1);
+
+        for (std::size_t i = 0; i < lane_block; ++i)
+        {
+            // The same split into e**n from the table and a polynomial of the fraction, for either sign
+            const std::int32_t n = x[i] >> F;
+            const auto& power = powers[static_cast<std::size_t>(std::min(std::max(n, lowest), highest) - lowest)];
+            const W y = (W{x[i] & mask} << (P + 1 - F)) - (W{1} << P);
+            const W product = fpm::detail::horner(c, y) * power.mantissa;
+
+            // The product is positive, so rounding half away from zero adds the highest bit that's shifted
+            // out. Adding half of the divisor instead could overflow for the largest shifts.
+            const auto result = static_cast<std::int32_t>(((product >> (power.shift - 1)) + (R ? 1 : 0)) >> 1);
+            out[i] = (n < lowest) ? 0 : result;
+        }
+    }
+};
+
+/// Calculates log2(x) * k like fpm::detail::log2_scaled, for k with 30 fraction bits.
+template <typename Fixed>
+FPM_SIMD_INLINE constexpr std::int32_t lane_log2_scaled(std::int32_t x, std::int64_t k) noexcept
+{
+    using W = std::int64_t;
+    constexpr auto F = Fixed::fraction_bits;
+    constexpr bool R = kernel_round_v<Fixed>;
+    constexpr unsigned int P = fpm::detail::poly_fraction_bits<W>;
+    constexpr W half = W{1} << (P - 1);
+
+    // Every 32-bit integer is exact in a double, whose exponent is then the index of the highest
+    // set bit and whose mantissa holds the bits below it: the input normalized to [1:2].
+    const auto bits = std::bit_cast<std::uint64_t>(static_cast<double>(x));
+    const auto highest = static_cast<std::int32_t>(bits >> 52) - 1023;
+    const W m = static_cast<W>((bits & ((std::uint64_t{1} << 52) - 1)) >> (52 - P)) | (W{1} << P);
+
+    const W e = highest - static_cast<std::int32_t>(F);
+    const W fraction = fpm::detail::log2_mantissa<W, fpm::detail::log2_bits<W>(F)>(m);
+    const W value = e * k + ((fraction * k + half) >> P);
+
+    // Both rounding modes of the lanes round the magnitude
+    const W magnitude = (value < 0) ? -value : value;
+    const W rounded = (magnitude + (R ? (W{1} << (P - F - 1)) : 0)) >> (P - F);
+    return static_cast<std::int32_t>((value < 0) ? -rounded : rounded);
+}
+
+template <typename Fixed>
+struct log2_lanes
+{
+    // The result is rounded from 30 fraction bits
+    static constexpr bool enabled = lane_math_v<Fixed> && Fixed::fraction_bits < 30;
+
+    static Fixed scalar(Fixed x) noexcept { return fpm::log2(x); }
+
+    FPM_SIMD_INLINE static void block(const std::int32_t* x, std::int32_t* out) noexcept
+    {
+        for (std::size_t i = 0; i < lane_block; ++i)
+        {
+            out[i] = lane_log2_scaled<Fixed>(x[i], std::int64_t{1} << 30);
+        }
+    }
+};
+
+template <typename Fixed>
+struct log_lanes
+{
+    static constexpr bool enabled = log2_lanes<Fixed>::enabled;
+
+    static Fixed scalar(Fixed x) noexcept { return fpm::log(x); }
+
+    FPM_SIMD_INLINE static void block(const std::int32_t* x, std::int32_t* out) noexcept
+    {
+        constexpr std::int64_t ln2 = fpm::detail::log2_scale<std::int64_t>(fpm::detail::ln_2);
+        for (std::size_t i = 0; i < lane_block; ++i)
+        {
+            out[i] = lane_log2_scaled<Fixed>(x[i], ln2);
+        }
+    }
+};
+
+template <typename Fixed>
+struct sqrt_lanes
+{
+    static constexpr bool enabled = lane_math_v<Fixed>;
+
+    static Fixed scalar(Fixed x) noexcept { return fpm::sqrt(x); }
+
+    FPM_SIMD_INLINE static void block(const std::int32_t* x, std::int32_t* out) noexcept
+    {
+        constexpr auto F = Fixed::fraction_bits;
+
+        // The digit-by-digit square root of sqrt_exact, which gives the same results as sqrt, with the
+        // loops interchanged so that the inner loop runs across the lanes. Starting every lane at the highest possible digit only adds
+        // leading iterations that leave the result unchanged.
+        std::uint64_t num[lane_block], res[lane_block];
+        for (std::size_t i = 0; i < lane_block; ++i)
+        {
+            num[i] = std::uint64_t{static_cast<std::uint32_t>(x[i])} << F;
+            res[i] = 0;
+        }
+        for (std::uint64_t bit = std::uint64_t{1} << ((30 + F) / 2 * 2); bit != 0; bit >>= 2)
+        {
+            for (std::size_t i = 0; i < lane_block; ++i)
+            {
+                const std::uint64_t val = res[i] + bit;
+                const bool subtract = num[i] >= val;
+                res[i] >>= 1;
+                num[i] -= subtract ? val : 0;
+                res[i] += subtract ? bit : 0;
+            }
+        }
+        for (std::size_t i = 0; i < lane_block; ++i)
+        {
+            // Round the last digit up if necessary
+            out[i] = static_cast<std::int32_t>(res[i] + (num[i] > res[i]));
+        }
+    }
+};
+
+/// Computes hypot with two or three components, like fpm::hypot: the squares of the raw values are added with
+/// twice the fraction bits, and the digit-by-digit square root of sqrt_lanes runs on the sum. The rounding mode
+/// doesn't matter, since the result is always rounded to nearest.
+struct hypot_lanes
+{
+    template <typename Fixed>
+    static constexpr bool enabled = std::is_same_v<typename Fixed::base_type, std::int32_t>;
+
+    FPM_SIMD_INLINE static std::uint64_t square(std::int32_t x) noexcept
+    {
+        const std::uint32_t magnitude = (x < 0) ? 0u - static_cast<std::uint32_t>(x) : static_cast<std::uint32_t>(x);
+        return std::uint64_t{magnitude} * magnitude;
+    }
+
+    /// \a z may be null for two components
+    FPM_SIMD_INLINE static void block(const std::int32_t* x, const std::int32_t* y, const std::int32_t* z, std::int32_t* out) noexcept
+    {
+        std::uint64_t num[lane_block], res[lane_block];
+        for (std::size_t i = 0; i < lane_block; ++i)
+        {
+            num[i] = square(x[i]) + square(y[i]);
+            res[i] = 0;
+        }
+        if (z != nullptr)
+        {
+            for (std::size_t i = 0; i < lane_block; ++i)
+            {
+                num[i] += square(z[i]);
+            }
+        }
+        // Three squares of 32-bit numbers are below 2**64
+        for (std::uint64_t bit = std::uint64_t{1} << 62; bit != 0; bit >>= 2)
+        {
+            for (std::size_t i = 0; i < lane_block; ++i)
+            {
+                const std::uint64_t val = res[i] + bit;
+                const bool subtract = num[i] >= val;
+                res[i] >>= 1;
+                num[i] -= subtract ? val : 0;
+                res[i] += subtract ? bit : 0;
+            }
+        }
+        for (std::size_t i = 0; i < lane_block; ++i)
+        {
+            out[i] = static_cast<std::int32_t>(res[i] + (num[i] > res[i]));
+        }
+    }
+};
+
+/// True for kernels that compute two results per element, such as sincos_lanes.
+template <typename Lanes>
+inline constexpr bool two_outputs_v = requires { requires Lanes::two_outputs; };
+
+/// Runs the kernel over all whole blocks in [x, x+n) and returns the number of elements processed.
+/// Kernels with two results write the second one to \a out2.
+template <typename Lanes>
+FPM_SIMD_INLINE std::size_t apply_lanes(const std::int32_t* x, std::int32_t* out, std::int32_t* out2, std::size_t n) noexcept
+{
+    std::size_t i = 0;
+    for (; i + lane_block <= n; i += lane_block)
+    {
+        std::int32_t in[lane_block], result[lane_block];
+        std::copy_n(x + i, lane_block, in);
+        if constexpr (two_outputs_v<Lanes>)
+        {
+            std::int32_t result2[lane_block];
+            Lanes::block(in, result, result2);
+            std::copy_n(result2, lane_block, out2 + i);
+        }
+        else
+        {
+            Lanes::block(in, result);
+        }
+        std::copy_n(result, lane_block, out + i);
+    }
+    return i;
+}
+
+#ifdef FPM_SIMD_X86
+
+template <typename Lanes>
+FPM_SIMD_TARGET("sse4.1") inline std::size_t lanes_sse4_1(const std::int32_t* x, std::int32_t* out, std::int32_t* out2, std::size_t n) noexcept
+{
+    return apply_lanes<Lanes>(x, out, out2, n);
+}
+
+template <typename Lanes>
+FPM_SIMD_TARGET("avx2") inline std::size_t lanes_avx2(const std::int32_t* x, std::int32_t* out, std::int32_t* out2, std::size_t n) noexcept
+{
+    return apply_lanes<Lanes>(x, out, out2, n);
+}
+
+template <typename Lanes>
+FPM_SIMD_TARGET("avx512f") inline std::size_t lanes_avx512(const std::int32_t* x, std::int32_t* out, std::int32_t* out2, std::size_t n) noexcept
+{
+    return apply_lanes<Lanes>(x, out, out2, n);
+}
+
+#endif
+
+/// Runs hypot_lanes over all whole blocks and returns the number of elements processed
+FPM_SIMD_INLINE std::size_t apply_hypot_lanes(const std::int32_t* x, const std::int32_t* y, const std::int32_t* z, std::int32_t* out, std::size_t n) noexcept
+{
+    std::size_t i = 0;
+    for (; i + lane_block <= n; i += lane_block)
+    {
+        std::int32_t in_x[lane_block], in_y[lane_block], in_z[lane_block], result[lane_block];
+        std::copy_n(x + i, lane_block, in_x);
+        std::copy_n(y + i, lane_block, in_y);
+        if (z != nullptr)
+        {
+            std::copy_n(z + i, lane_block, in_z);
+        }
+        hypot_lanes::block(in_x, in_y, (z != nullptr) ? in_z : nullptr, result);
+        std::copy_n(result, lane_block, out + i);
+    }
+    return i;
+}
+
+#ifdef FPM_SIMD_X86
+
+FPM_SIMD_TARGET("sse4.1") inline std::size_t hypot_sse4_1(const std::int32_t* x, const std::int32_t* y, const std::int32_t* z, std::int32_t* out, std::size_t n) noexcept
+{
+    return apply_hypot_lanes(x, y, z, out, n);
+}
+
+FPM_SIMD_TARGET("avx2") inline std::size_t hypot_avx2(const std::int32_t* x, const std::int32_t* y, const std::int32_t* z, std::int32_t* out, std::size_t n) noexcept
+{
+    return apply_hypot_lanes(x, y, z, out, n);
+}
+
+FPM_SIMD_TARGET("avx512f") inline std::size_t hypot_avx512(const std::int32_t* x, const std::int32_t* y, const std::int32_t* z, std::int32_t* out, std::size_t n) noexcept
+{
+    return apply_hypot_lanes(x, y, z, out, n);
+}
+
+#endif
+
+/// Computes out[i] = hypot(x[i], y[i]), or hypot(x[i], y[i], z[i]) if \a z isn't null, using instruction set \a target.
+template <typename Fixed>
+inline void apply_hypot(isa target, const Fixed* x, const Fixed* y, const Fixed* z, Fixed* out, std::size_t n) noexcept
+{
+    std::size_t i = 0;
+    if constexpr (hypot_lanes::enabled<Fixed>)
+    {
+        const auto raw_x = reinterpret_cast<const std::int32_t*>(x);
+        const auto raw_y = reinterpret_cast<const std::int32_t*>(y);
+        const auto raw_z = reinterpret_cast<const std::int32_t*>(z);
+        const auto raw_out = reinterpret_cast<std::int32_t*>(out);
+        switch (target)
+        {
+#ifdef FPM_SIMD_X86
+        case isa::avx512: i = hypot_avx512(raw_x, raw_y, raw_z, raw_out, n); break;
+        case isa::avx2:   i = hypot_avx2(raw_x, raw_y, raw_z, raw_out, n); break;
+        case isa::sse4_1: i = hypot_sse4_1(raw_x, raw_y, raw_z, raw_out, n); break;
+#endif
+        default:          i = apply_hypot_lanes(raw_x, raw_y, raw_z, raw_out, n); break;
+        }
+    }
+    else
+    {
+        static_cast<void>(target);
+    }
+    for (; i < n; ++i)
+    {
+        out[i] = (z != nullptr) ? fpm::hypot(x[i], y[i], z[i]) : fpm::hypot(x[i], y[i]);
+    }
+}
+
+/// Applies the function implemented by \a Lanes element-wise using instruction set \a target.
+/// Types the kernel doesn't support (and any remainder) use the scalar function.
+/// Kernels with two results write the second one to \a out2.
+template <template <typename> class Lanes, typename Fixed>
+inline void apply_math(isa target, const Fixed* x, Fixed* out, std::size_t n, Fixed* out2 = nullptr) noexcept
+{
+    using L = Lanes<Fixed>;
+
+    std::size_t i = 0;
+    if constexpr (L::enabled)
+    {
+        const auto raw_x = reinterpret_cast<const std::int32_t*>(x);
+        const auto raw_out = reinterpret_cast<std::int32_t*>(out);
+        const auto raw_out2 = reinterpret_cast<std::int32_t*>(out2);
+        switch (target)
+        {
+#ifdef FPM_SIMD_X86
+        case isa::avx512: i = lanes_avx512<L>(raw_x, raw_out, raw_out2, n); break;
+        case isa::avx2:   i = lanes_avx2<L>(raw_x, raw_out, raw_out2, n); break;
+        case isa::sse4_1: i = lanes_sse4_1<L>(raw_x, raw_out, raw_out2, n); break;
+#endif
+        default:          i = apply_lanes<L>(raw_x, raw_out, raw_out2, n); break;
+        }
+    }
+    else
+    {
+        static_cast<void>(target);
+    }
+    for (; i < n; ++i)
+    {
+        if constexpr (two_outputs_v<L>)
+        {
+            std::tie(out[i], out2[i]) = L::scalar(x[i]);
+        }
+        else
+        {
+            out[i] = L::scalar(x[i]);
+        }
+    }
+}
+
+}
+
+// The array functions below produce exactly the same results as applying the scalar function of
+// the same name to each element, wherever that result is representable. Like the scalar
+// functions, they require arguments inside the function's domain. The output may be the same span
+// as the input, but must not otherwise overlap it.
+
+//! Computes out[i] = sin(x[i])
+template <typename Fixed> requires is_fixed_v<Fixed>
+inline void sin(std::span<const std::type_identity_t<Fixed>> x, std::span<Fixed> out) noexcept
+{
+    assert(x.size() == out.size());
+    detail::apply_math<detail::sin_lanes>(active_isa(), x.data(), out.data(), out.size());
+}
+
+//! Computes out[i] = cos(x[i])
+template <typename Fixed> requires is_fixed_v<Fixed>
+inline void cos(std::span<const std::type_identity_t<Fixed>> x, std::span<Fixed> out) noexcept
+{
+    assert(x.size() == out.size());
+    detail::apply_math<detail::cos_lanes>(active_isa(), x.data(), out.data(), out.size());
+}
+
+//! Computes sin_out[i] = sin(x[i]) and cos_out[i] = cos(x[i]) like fpm::sincos, with a single range reduction
+template <typename Fixed> requires is_fixed_v<Fixed>
+inline void sincos(std::span<const std::type_identity_t<Fixed>> x, std::span<Fixed> sin_out, std::span<Fixed> cos_out) noexcept
+{
+    assert(x.size() == sin_out.size() && x.size() == cos_out.size());
+    detail::apply_math<detail::sincos_lanes>(active_isa(), x.data(), sin_out.data(), x.size(), cos_out.data());
+}
+
+//! Computes out[i] = exp(x[i])
+template <typename Fixed> requires is_fixed_v<Fixed>
+inline void exp(std::span<const std::type_identity_t<Fixed>> x, std::span<Fixed> out) noexcept
+{
+    assert(x.size() == out.size());
+    detail::apply_math<detail::exp_lanes>(active_isa(), x.data(), out.data(), out.size());
+}
+
+//! Computes out[i] = log2(x[i])
+template <typename Fixed> requires is_fixed_v<Fixed>
+inline void log2(std::span<const std::type_identity_t<Fixed>> x, std::span<Fixed> out) noexcept
+{
+    assert(x.size() == out.size());
+    detail::apply_math<detail::log2_lanes>(active_isa(), x.data(), out.data(), out.size());
+}
+
+//! Computes out[i] = log(x[i])
+template <typename Fixed> requires is_fixed_v<Fixed>
+inline void log(std::span<const std::type_identity_t<Fixed>> x, std::span<Fixed> out) noexcept
+{
+    assert(x.size() == out.size());
+    detail::apply_math<detail::log_lanes>(active_isa(), x.data(), out.data(), out.size());
+}
+
+//! Computes out[i] = sqrt(x[i])
+template <typename Fixed> requires is_fixed_v<Fixed>
+inline void sqrt(std::span<const std::type_identity_t<Fixed>> x, std::span<Fixed> out) noexcept
+{
+    assert(x.size() == out.size());
+    detail::apply_math<detail::sqrt_lanes>(active_isa(), x.data(), out.data(), out.size());
+}
+
+//! Computes out[i] = hypot(x[i], y[i]), the lengths of 2D vectors stored as separate spans of their components
+template <typename Fixed> requires is_fixed_v<Fixed>
+inline void hypot(std::span<const std::type_identity_t<Fixed>> x, std::span<const std::type_identity_t<Fixed>> y, std::span<Fixed> out) noexcept
+{
+    assert(x.size() == out.size() && y.size() == out.size());
+    detail::apply_hypot(active_isa(), x.data(), y.data(), static_cast<const Fixed*>(nullptr), out.data(), out.size());
+}
+
+//! Computes out[i] = hypot(x[i], y[i], z[i]), the lengths of 3D vectors
+template <typename Fixed> requires is_fixed_v<Fixed>
+inline void hypot(std::span<const std::type_identity_t<Fixed>> x, std::span<const std::type_identity_t<Fixed>> y, std::span<const std::type_identity_t<Fixed>> z, std::span<Fixed> out) noexcept
+{
+    assert(x.size() == out.size() && y.size() == out.size() && z.size() == out.size());
+    detail::apply_hypot(active_isa(), x.data(), y.data(), z.data(), out.data(), out.size());
+}
+
+}
+
+#endif
@@ -0,0 +1,81 @@
+#include "common.hpp"
+#include <fpm/accumulator.hpp>
+#include <random>
+
+TEST(accumulator, products)
+{
+    using P = fpm::fixed_16_16;
+    using A = fpm::accumulator<P>;
+
+    A acc(P(1.5));
+    acc.fma(P(2.5), P(-4));
+    acc.fma(P(0.25), P(0.5));
+    EXPECT_EQ(P(-8.375), acc.value());
+    acc.fms(P(0.25), P(0.5));
+    acc += P(3);
+    acc -= P(0.5);
+    EXPECT_EQ(P(-6), acc.value());
+    EXPECT_EQ(P(-6), static_cast<P>(acc));
+    EXPECT_EQ(-6 * (std::int64_t{1} << 32), acc.raw_value());
+    static_assert(A::fraction_bits == 32);
+
+    EXPECT_EQ(acc, A(P(-6)));
+    EXPECT_EQ(A(P(-3)), A(P(-6)) - A(P(-3)));
+    EXPECT_EQ(A(P(1)), A(P(0.75)) + A(P(0.25)));
+    EXPECT_EQ(P(0), A().value());
+}
+
+TEST(accumulator, precision)
+{
+    // Products below the resolution of the type are not lost
+    using P = fpm::fixed_16_16;
+    const P tiny = P::from_raw_value(100);
+    fpm::accumulator<P> acc;
+    P rounded(0);
+    for (int i = 0; i < 1000; ++i)
+    {
+        acc.fma(tiny, tiny);
+        rounded += tiny * tiny;
+    }
+    EXPECT_EQ(P(0), rounded);
+    EXPECT_EQ(P::from_raw_value(153), acc.value()); // 100 * 100 * 1000 / 65536 = 152.6
+
+    // The result is rounded once, with the rounding mode of the type
+    std::mt19937 gen(1234);
+    std::uniform_int_distribution<std::int32_t> dist(-1 << 20, 1 << 20);
+    fpm::accumulator<P> sum;
+    double exact = 0;
+    for (int i = 0; i < 1000; ++i)
+    {
+        const P x = P::from_raw_value(dist(gen)), y = P::from_raw_value(dist(gen));
+        sum.fma(x, y);
+        exact += static_cast<double>(x) * static_cast<double>(y);
+    }
+    EXPECT_EQ(P(exact), sum.value());
+
+    using T = fpm::fixed<std::int32_t, std::int64_t, 16, false>;
+    fpm::accumulator<T> truncated;
+    truncated.fma(T::from_raw_value(-3), T::from_raw_value(1 << 15));
+    EXPECT_EQ(T::from_raw_value(-1), truncated.value());
+    fpm::accumulator<P> rounding;
+    rounding.fma(P::from_raw_value(-3), P::from_raw_value(1 << 15));
+    EXPECT_EQ(P::from_raw_value(-2), rounding.value());
+}
+
+#if defined(FPM_INT128)
+TEST(accumulator, wide)
+{
+    using P = fpm::fixed_32_32;
+    fpm::accumulator<P> acc;
+    acc.fma(P(100000), P(100000));
+    acc.fms(P(99999), P(100001));
+    EXPECT_EQ(P(1), acc.value());
+}
+#endif
+
+TEST(accumulator, constexpr)
+{
+    using P = fpm::fixed_16_16;
+    constexpr auto acc = fpm::accumulator<P>(P(1)).fma(P(2), P(0.25)).fma(P(-0.5), P(0.5));
+    static_assert(acc.value() == P(1.25), "fma failed");
+}
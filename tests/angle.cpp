@@ -0,0 +1,161 @@
+#include "common.hpp"
+#include <fpm/angle.hpp>
+
+// Returns the angle in turns, in [-0.5, 0.5)
+static double turns(fpm::angle<32> a)
+{
+    return static_cast<std::int32_t>(a.raw_value()) / 4294967296.0;
+}
+
+TEST(angle, construction)
+{
+    using A = fpm::angle<32>;
+    using P = fpm::fixed_16_16;
+
+    EXPECT_EQ(0u, A().raw_value());
+    EXPECT_EQ(0x40000000u, A::quarter_turn().raw_value());
+    EXPECT_EQ(0x80000000u, A::half_turn().raw_value());
+
+    // Q16.16 has a resolution of 2.4e-6 turns
+    EXPECT_NEAR(0.25, turns(A::from_radians(P::half_pi())), 2e-6);
+    EXPECT_NEAR(-0.25, turns(A::from_radians(-P::half_pi())), 2e-6);
+    EXPECT_NEAR(0.1, turns(A::from_radians(P(0.2 * 3.14159265358979))), 2e-6);
+    EXPECT_EQ(A::from_radians(-P::pi()), -A::from_radians(P::pi()));
+
+    // Angles wrap around
+    EXPECT_NEAR(0.25, turns(A::from_radians(P::half_pi() + 3 * P::two_pi())), 1e-5);
+    EXPECT_NEAR(0.25, turns(A::from_radians(P::half_pi() - 3 * P::two_pi())), 1e-5);
+
+    // Conversion between binary angles
+    EXPECT_EQ(0x4000u, fpm::angle<16>(A::quarter_turn()).raw_value());
+    EXPECT_EQ(0x40000000u, A(fpm::angle<16>::quarter_turn()).raw_value());
+    EXPECT_EQ(0x12u, fpm::angle<8>(A::from_raw_value(0x11800000u)).raw_value());
+    EXPECT_EQ(0u, fpm::angle<8>(A::from_raw_value(0xFFFFFFFFu)).raw_value());
+}
+
+TEST(angle, to_radians)
+{
+    using A = fpm::angle<32>;
+    using P = fpm::fixed_16_16;
+
+    EXPECT_EQ(P(0), A().to_radians<P>());
+    EXPECT_EQ(P::half_pi(), A::quarter_turn().to_radians<P>());
+    EXPECT_EQ(-P::half_pi(), (-A::quarter_turn()).to_radians<P>());
+    EXPECT_EQ(-P::pi(), A::half_turn().to_radians<P>());
+    EXPECT_EQ(P::pi(), A::from_raw_value(0x7FFFFFFFu).to_radians<P>());
+
+    // Rounded with the rounding mode of the type
+    const A tiny = A::from_raw_value(1);
+    EXPECT_EQ(P(0), tiny.to_radians<P>());
+    EXPECT_EQ(P(0), (-tiny).to_radians<P>());
+    using Floor = fpm::fixed<std::int32_t, std::int64_t, 16, fpm::rounding::floor>;
+    EXPECT_EQ(Floor(0), tiny.to_radians<Floor>());
+    EXPECT_EQ(Floor::from_raw_value(-1), (-tiny).to_radians<Floor>());
+    using Ceil = fpm::fixed<std::int32_t, std::int64_t, 16, fpm::rounding::ceil>;
+    EXPECT_EQ(Ceil::from_raw_value(1), tiny.to_radians<Ceil>());
+    EXPECT_EQ(Ceil(0), (-tiny).to_radians<Ceil>());
+
+    for (int i = -1000; i < 1000; ++i)
+    {
+        const P x = P::pi() * i / 1000;
+        EXPECT_EQ(x, A::from_radians(x).to_radians<P>());
+        EXPECT_EQ(x, fpm::angle<64>::from_radians(x).to_radians<P>());
+    }
+
+#ifdef FPM_INT128
+    // Exact to the last bit of a 64-bit type
+    using Q = fpm::fixed_8_56;
+    EXPECT_EQ(Q::from_raw_value(113187804032455044), fpm::angle<64>::quarter_turn().to_radians<Q>());
+    EXPECT_EQ(Q::from_raw_value(-99039328528398164), fpm::angle<8>::from_raw_value(200).to_radians<Q>());
+#endif
+}
+
+TEST(angle, arithmetic)
+{
+    using A = fpm::angle<16>;
+
+    EXPECT_EQ(A::half_turn(), A::quarter_turn() + A::quarter_turn());
+    EXPECT_EQ(A(), A::half_turn() + A::half_turn());
+    EXPECT_EQ(-A::quarter_turn(), A() - A::quarter_turn());
+    EXPECT_EQ(A::half_turn(), -A::half_turn());
+    EXPECT_EQ(-A::quarter_turn(), A::quarter_turn() * 3);
+    EXPECT_EQ(A::half_turn(), 6 * A::quarter_turn());
+
+    A a = A::quarter_turn();
+    a += A::half_turn();
+    EXPECT_EQ(-A::quarter_turn(), a);
+    a -= A::half_turn();
+    EXPECT_EQ(A::quarter_turn(), a);
+}
+
+TEST(angle, sin_cos)
+{
+    using A = fpm::angle<32>;
+    using P = fpm::fixed_16_16;
+    const double PI = std::acos(-1);
+
+    EXPECT_EQ(P(1), fpm::sin<P>(A::quarter_turn()));
+    EXPECT_EQ(P(0), fpm::cos<P>(A::quarter_turn()));
+    EXPECT_EQ(P(-1), fpm::cos<P>(A::half_turn()));
+
+    for (std::uint32_t i = 0; i < 4096; ++i)
+    {
+        const auto a = A::from_raw_value(i * 1048573u);
+        const double real = static_cast<double>(a.raw_value()) * 2 * PI / 4294967296.0;
+        EXPECT_NEAR(std::sin(real), static_cast<double>(fpm::sin<P>(a)), 4.8e-6 + 7.7e-6);
+        EXPECT_NEAR(std::cos(real), static_cast<double>(fpm::cos<P>(a)), 4.8e-6 + 7.7e-6);
+        EXPECT_NEAR(std::sin(real), static_cast<double>(fpm::sin<fpm::fixed_8_24, 64, 3>(a)), 1e-8 + 3e-8);
+        EXPECT_EQ(std::make_pair(fpm::sin<P>(a), fpm::cos<P>(a)), fpm::sincos<P>(a));
+
+        // The same results as the table-driven functions on radians
+        const auto x = a.to_radians<P>();
+        EXPECT_EQ(fpm::lut::sin(x), fpm::sin<P>(A::from_radians(x)));
+    }
+}
+
+TEST(angle, atan2)
+{
+    using A = fpm::angle<32>;
+    using P = fpm::fixed_16_16;
+    const double PI = std::acos(-1);
+
+    EXPECT_EQ(A(), fpm::atan2<A>(P(0), P(1)));
+    EXPECT_EQ(A::quarter_turn(), fpm::atan2<A>(P(1), P(0)));
+    EXPECT_EQ(A::half_turn(), fpm::atan2<A>(P(0), P(-1)));
+    EXPECT_EQ(-A::quarter_turn(), fpm::atan2<A>(P(-1), P(0)));
+
+    // Maximum error, in turns
+    constexpr double MAX_ERROR = 1e-6;
+    for (int angle = -1799; angle <= 1800; ++angle)
+    {
+        const double real = angle * PI / 1800;
+        for (double radius : { 0.001, 1.0, 30000.0 })
+        {
+            const P y(std::sin(real) * radius), x(std::cos(real) * radius);
+            const double expected = std::atan2(static_cast<double>(y), static_cast<double>(x)) / (2 * PI);
+            const double actual = turns(fpm::atan2<A>(y, x));
+            const double diff = expected - actual;
+            EXPECT_NEAR(0, diff - std::round(diff), MAX_ERROR) << "angle " << angle << ", radius " << radius;
+        }
+    }
+
+    // Extremes don't overflow
+    const P max = std::numeric_limits<P>::max(), min = std::numeric_limits<P>::lowest();
+    EXPECT_EQ(fpm::angle<16>::from_raw_value(0x2000), fpm::atan2<fpm::angle<16>>(max, max));
+    EXPECT_EQ(fpm::angle<16>::from_raw_value(0xA000), fpm::atan2<fpm::angle<16>>(min, min));
+    EXPECT_EQ(fpm::angle<16>::quarter_turn(), fpm::atan2<fpm::angle<16>>(P(1), P::from_raw_value(0)));
+    EXPECT_EQ(fpm::angle<16>(), fpm::atan2<fpm::angle<16>>(P::from_raw_value(0), P::from_raw_value(1)));
+
+    // Any precision
+    const auto a64 = fpm::atan2<fpm::angle<64>>(fpm::fixed_32_32(1), fpm::fixed_32_32(1));
+    EXPECT_NEAR(0.125, a64.raw_value() / 18446744073709551616.0, 1e-10);
+}
+
+TEST(angle, constexpr)
+{
+    using A = fpm::angle<32>;
+    using P = fpm::fixed_16_16;
+    static_assert(A::from_radians(P(0)) == A(), "angle conversion failed");
+    static_assert(fpm::sin<P>(A::quarter_turn()) == P(1), "angle sin failed");
+    static_assert(fpm::atan2<A>(P(1), P(0)) == A::quarter_turn(), "angle atan2 failed");
+}
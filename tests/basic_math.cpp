@@ -1,5 +1,6 @@
 #include "common.hpp"
 #include <fpm/math.hpp>
+#include <random>
 
 TEST(basic_math, abs)
 {
@@ -104,3 +105,81 @@ TEST(basic_math, remquo)
     EXPECT_EQ(P(0), remquo(P(0), P(1), &quo));
     EXPECT_EQ(0, quo % QUO_MIN_SIZE);
 }
+
+// Compares reciprocal and division by a divisor to operator/ on raw values spread over the whole range.
+template <typename P>
+static void ExpectFastDivisionExact()
+{
+    using B = typename P::base_type;
+    std::mt19937_64 gen(42);
+    const auto random_value = [&] {
+        // Random magnitudes on a logarithmic scale
+        const auto bits = static_cast<int>(gen() % (sizeof(B) * 8 - std::is_signed_v<B>)) + 1;
+        auto raw = static_cast<B>(gen() >> (64 - bits));
+        if (std::is_signed_v<B> && gen() % 2 == 0) raw = static_cast<B>(0 - raw);
+        return P::from_raw_value(raw == 0 ? B(1) : raw);
+    };
+
+    for (int i = 0; i < 20000; ++i)
+    {
+        // Results that don't fit the type can differ
+        const P x = random_value();
+        if (std::abs(1 / static_cast<double>(x)) < static_cast<double>(std::numeric_limits<P>::max()))
+        {
+            EXPECT_EQ(P(1) / x, fpm::reciprocal(x)) << x.raw_value();
+        }
+    }
+    for (int i = 0; i < 200; ++i)
+    {
+        const P y = random_value();
+        const fpm::divisor<P> d(y);
+        EXPECT_EQ(y, d.value());
+        for (int j = 0; j < 100; ++j)
+        {
+            const P x = random_value();
+            EXPECT_EQ(x / y, x / d) << x.raw_value() << " / " << y.raw_value();
+        }
+        EXPECT_EQ(std::numeric_limits<P>::max() / y, std::numeric_limits<P>::max() / d);
+        EXPECT_EQ(std::numeric_limits<P>::lowest() / y, std::numeric_limits<P>::lowest() / d);
+    }
+}
+
+TEST(basic_math, reciprocal)
+{
+    using P = fpm::fixed_16_16;
+
+    EXPECT_EQ(P(0.5), fpm::reciprocal(P(2)));
+    EXPECT_EQ(P(-4), fpm::reciprocal(P(-0.25)));
+    EXPECT_EQ(P(1) / P(3), fpm::reciprocal(P(3)));
+    EXPECT_EQ(P(1) / P(-7), fpm::reciprocal(P(-7)));
+
+    ExpectFastDivisionExact<fpm::fixed_8_8>();
+    ExpectFastDivisionExact<fpm::fixed_16_16>();
+    ExpectFastDivisionExact<fpm::fixed_24_8>();
+    ExpectFastDivisionExact<fpm::fixed_8_24>();
+    ExpectFastDivisionExact<fpm::fixed<std::int32_t, std::int64_t, 16, false>>();
+    ExpectFastDivisionExact<fpm::fixed<std::uint32_t, std::uint64_t, 16>>();
+    ExpectFastDivisionExact<fpm::fixed_48_16>();
+    ExpectFastDivisionExact<fpm::fixed_32_32>();
+    ExpectFastDivisionExact<fpm::fixed_16_48>();
+    ExpectFastDivisionExact<fpm::fixed<std::int64_t, fpm::int128_t, 32, false>>();
+}
+
+TEST(basic_math, divisor)
+{
+    using P = fpm::fixed_16_16;
+
+    constexpr fpm::divisor<P> three(P(3));
+    EXPECT_EQ(P(1) / P(3), P(1) / three);
+    EXPECT_EQ(P(-2.5) / P(3), P(-2.5) / three);
+
+    constexpr fpm::divisor half_pi(P::half_pi());
+    EXPECT_EQ(P(1) / P::half_pi(), P(1) / half_pi);
+
+    P x(10);
+    x /= fpm::divisor<P>(P(-4));
+    EXPECT_EQ(P(-2.5), x);
+
+    static_assert(P(6) / three == P(2), "constexpr divisor failed");
+    static_assert(fpm::reciprocal(P(4)) == P(0.25), "constexpr reciprocal failed");
+}
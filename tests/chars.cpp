@@ -1,10 +1,13 @@
 #include <array>
+#include <sstream>
+#include <string_view>
+#include <iomanip>
 
 #include "common.hpp"
 #include "fpm/ios.hpp"
 
 #if __cplusplus >= 201703L /* C++17 */
-template <std::size_t BufferSize, typename B, typename I, unsigned int F, bool R>
+template <std::size_t BufferSize, typename B, typename I, unsigned int F, auto R>
 inline static std::string fixed_to_string(const fpm::fixed<B,I,F,R>& value)
 {
   std::array<char, BufferSize> buffer{};
@@ -57,6 +60,84 @@ TEST(chars, to_chars)
   EXPECT_ANY_THROW(fixed_to_string<1>(fpm::fixed_16_16{1.25}));
 }
 
+template <typename TFixed>
+inline static void expect_to_chars_matches_stream(const TFixed value, const std::chars_format fmt, const int precision)
+{
+  std::stringstream ss;
+  ss << std::setprecision(precision);
+  switch(fmt)
+  {
+    case std::chars_format::scientific: ss << std::scientific; break;
+    case std::chars_format::fixed: ss << std::fixed; break;
+    case std::chars_format::hex: ss << std::hexfloat; break;
+    default: break;
+  }
+  ss << value;
+
+  std::array<char, 128> buffer{};
+  const std::to_chars_result result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value, fmt, precision);
+  ASSERT_EQ(result.ec, std::errc{});
+  EXPECT_EQ(std::string(buffer.data(), result.ptr), ss.str());
+}
+
+TEST(chars, to_chars_formats)
+{
+  using namespace std::string_literals;
+  std::array<char, 32> buffer{};
+  const auto to_string = [&](const fpm::fixed_16_16 value, const std::chars_format fmt, const int precision) {
+    const std::to_chars_result result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value, fmt, precision);
+    return std::string(buffer.data(), result.ptr);
+  };
+
+  EXPECT_EQ(to_string(fpm::fixed_16_16{-1.25}, std::chars_format::general, 6), "-1.25"s);
+  EXPECT_EQ(to_string(fpm::fixed_16_16{1.25}, std::chars_format::fixed, 3), "1.250"s);
+  EXPECT_EQ(to_string(fpm::fixed_16_16{1.25}, std::chars_format::scientific, 2), "1.25e+00"s);
+  EXPECT_EQ(to_string(fpm::fixed_16_16{1234.5}, std::chars_format::scientific, 1), "1.2e+03"s);
+  EXPECT_EQ(to_string(fpm::fixed_16_16{1.25}, std::chars_format::hex, 6), "0x1.4p+0"s);
+  EXPECT_EQ(to_string(fpm::fixed_16_16::from_raw_value(0x1fffffff), std::chars_format::hex, 6), "0x1.fffffffp+12"s);
+  EXPECT_EQ(to_string(fpm::fixed_16_16{9.96}, std::chars_format::fixed, 1), "10.0"s);
+
+  // Trailing zeros beyond the internal buffer
+  EXPECT_EQ(to_string(fpm::fixed_16_16{0.5}, std::chars_format::fixed, 20), "0.50000000000000000000"s);
+}
+
+TEST(chars, to_chars_matches_stream)
+{
+  const std::chars_format formats[] = {
+    std::chars_format::general, std::chars_format::fixed, std::chars_format::scientific, std::chars_format::hex
+  };
+  const double values[] = { 0, 1, -1, 0.5, 1.125, -7.8125, 0.0001, 0.00001, 3.14159, 99.999, 1234.5678, -32767.99 };
+
+  for (const auto fmt : formats)
+  {
+    for (int precision = -1; precision <= 12; ++precision)
+    {
+      for (const auto value : values)
+      {
+        expect_to_chars_matches_stream(fpm::fixed_16_16{value}, fmt, precision);
+        expect_to_chars_matches_stream(fpm::fixed_8_24{value / 1000}, fmt, precision);
+        expect_to_chars_matches_stream(fpm::fixed_24_8{value * 100}, fmt, precision);
+#ifdef FPM_INT128
+        expect_to_chars_matches_stream(fpm::fixed_32_32{value * 1000}, fmt, precision);
+#endif
+      }
+      expect_to_chars_matches_stream(std::numeric_limits<fpm::fixed_16_16>::min(), fmt, precision);
+      expect_to_chars_matches_stream(std::numeric_limits<fpm::fixed_16_16>::max(), fmt, precision);
+      expect_to_chars_matches_stream(std::numeric_limits<fpm::fixed_16_16>::epsilon(), fmt, precision);
+    }
+  }
+}
+
+TEST(chars, to_chars_constexpr)
+{
+  constexpr auto result = [] {
+    std::array<char, 16> buffer{};
+    const auto res = std::to_chars(buffer.data(), buffer.data() + buffer.size(), fpm::fixed_16_16{2.5}, std::chars_format::fixed, 2);
+    return std::make_pair(buffer, res.ptr - buffer.data());
+  }();
+  EXPECT_EQ(std::string(result.first.data(), result.second), "2.50");
+}
+
 TEST(chars, from_chars)
 {
   using namespace std::string_literals;
@@ -118,6 +199,138 @@ TEST(chars, from_chars_hexfloat)
   EXPECT_EQ(string_to_fixed<fpm::fixed_16_16>("1.1p4"s, std::chars_format::hex), fpm::fixed_16_16{17});
 }
 
+TEST(chars, from_chars_rounding)
+{
+  using namespace std::string_literals;
+  using P = fpm::fixed<std::int32_t, std::int64_t, 16, true>;
+  using Q = fpm::fixed<std::int32_t, std::int64_t, 16, false>;
+
+  // 1/3 is 0x5555.5555... in Q16.16
+  EXPECT_EQ(string_to_fixed<P>("0.33333333333"s).raw_value(), 0x5555);
+  EXPECT_EQ(string_to_fixed<Q>("0.33333333333"s).raw_value(), 0x5555);
+  // 2/3 is 0xaaaa.aaaa... in Q16.16
+  EXPECT_EQ(string_to_fixed<P>("0.66666666666"s).raw_value(), 0xaaab);
+  EXPECT_EQ(string_to_fixed<Q>("0.66666666666"s).raw_value(), 0xaaaa);
+  EXPECT_EQ(string_to_fixed<P>("-0.66666666666"s).raw_value(), -0xaaab);
+  EXPECT_EQ(string_to_fixed<Q>("-0.66666666666"s).raw_value(), -0xaaaa);
+
+  // Exactly half of the LSB rounds away from zero, just below it doesn't
+  EXPECT_EQ(string_to_fixed<P>("0.00000762939453125"s).raw_value(), 1);
+  EXPECT_EQ(string_to_fixed<P>("0.00000762939453124999999999999"s).raw_value(), 0);
+  EXPECT_EQ(string_to_fixed<P>("-0.00000762939453125"s).raw_value(), -1);
+  EXPECT_EQ(string_to_fixed<Q>("0.00001525878906249999999999999"s).raw_value(), 0);
+  EXPECT_EQ(string_to_fixed<Q>("0.00001525878906250000000000001"s).raw_value(), 1);
+
+  // Exponents move the decimal point across the digits
+  EXPECT_EQ(string_to_fixed<P>("12.5e-1"s), P{1.25});
+  EXPECT_EQ(string_to_fixed<P>("0.0125e2"s), P{1.25});
+  EXPECT_EQ(string_to_fixed<P>("125e-5"s).raw_value(), 82);
+  EXPECT_EQ(string_to_fixed<P>("0e1000"s), P{0});
+  EXPECT_EQ(string_to_fixed<P>("1e-1000"s), P{0});
+
+  // Hexadecimal
+  EXPECT_EQ(string_to_fixed<P>("1p-17"s, std::chars_format::hex).raw_value(), 1);
+  EXPECT_EQ(string_to_fixed<Q>("1p-17"s, std::chars_format::hex).raw_value(), 0);
+  EXPECT_EQ(string_to_fixed<P>("0.00018"s, std::chars_format::hex).raw_value(), 2);
+  EXPECT_EQ(string_to_fixed<Q>("0.00018"s, std::chars_format::hex).raw_value(), 1);
+}
+
+TEST(chars, from_chars_range)
+{
+  using namespace std::string_literals;
+  using P = fpm::fixed_16_16;
+
+  EXPECT_EQ(string_to_fixed<P>("32767.99998"s), std::numeric_limits<P>::max());
+  EXPECT_EQ(string_to_fixed<P>("-32768"s), std::numeric_limits<P>::min());
+  EXPECT_EQ(string_to_fixed<P>("7fff.ffff"s, std::chars_format::hex), std::numeric_limits<P>::max());
+  EXPECT_EQ(string_to_fixed<P>("-8p12"s, std::chars_format::hex), std::numeric_limits<P>::min());
+
+  EXPECT_THROW(string_to_fixed<P>("32768"s), std::runtime_error);
+  EXPECT_THROW(string_to_fixed<P>("32767.999995"s), std::runtime_error);
+  EXPECT_THROW(string_to_fixed<P>("-32768.00001"s), std::runtime_error);
+  EXPECT_THROW(string_to_fixed<P>("1e5"s), std::runtime_error);
+  EXPECT_THROW(string_to_fixed<P>("1e1000000000"s), std::runtime_error);
+  EXPECT_THROW(string_to_fixed<P>("100000000000000000000000000000"s), std::runtime_error);
+  EXPECT_THROW(string_to_fixed<P>("8p12"s, std::chars_format::hex), std::runtime_error);
+  EXPECT_THROW(string_to_fixed<P>("inf"s), std::runtime_error);
+  EXPECT_THROW(string_to_fixed<P>("nan"s), std::runtime_error);
+
+  using U = fpm::fixed<std::uint32_t, std::uint64_t, 16>;
+  EXPECT_EQ(string_to_fixed<U>("65535.99998"s), std::numeric_limits<U>::max());
+  EXPECT_EQ(string_to_fixed<U>("-0"s), U{0});
+  EXPECT_THROW(string_to_fixed<U>("-1"s), std::runtime_error);
+
+  // Out of range leaves the value untouched, but consumes the pattern
+  P value{1};
+  const std::string text = "1e10,"s;
+  const auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+  EXPECT_EQ(result.ec, std::errc::result_out_of_range);
+  EXPECT_EQ(result.ptr, text.data() + 4);
+  EXPECT_EQ(value, P{1});
+}
+
+TEST(chars, from_chars_ptr)
+{
+  using P = fpm::fixed_16_16;
+  const auto parsed_length = [](const std::string& text, std::chars_format fmt = std::chars_format::general) {
+    P value{};
+    const auto result = std::from_chars(text.data(), text.data() + text.size(), value, fmt);
+    return (result.ec == std::errc{}) ? result.ptr - text.data() : -1;
+  };
+
+  EXPECT_EQ(parsed_length("1.5,2.5"), 3);
+  EXPECT_EQ(parsed_length("-1.5e2;"), 6);
+  EXPECT_EQ(parsed_length("1.5e"), 3);
+  EXPECT_EQ(parsed_length("1.5e+"), 3);
+  EXPECT_EQ(parsed_length("1.5.3"), 3);
+  EXPECT_EQ(parsed_length(".5"), 2);
+  EXPECT_EQ(parsed_length("5."), 2);
+  EXPECT_EQ(parsed_length("."), -1);
+  EXPECT_EQ(parsed_length("-"), -1);
+  EXPECT_EQ(parsed_length(" 1"), -1);
+  EXPECT_EQ(parsed_length("1.5e3", std::chars_format::scientific), 5);
+  EXPECT_EQ(parsed_length("1.fp1x", std::chars_format::hex), 5);
+  EXPECT_EQ(parsed_length("1.fe", std::chars_format::hex), 4);
+}
+
+TEST(chars, from_chars_round_trip)
+{
+  using P = fpm::fixed_16_16;
+  std::array<char, 64> buffer{};
+  for (std::int32_t raw = std::numeric_limits<std::int32_t>::min(); raw < std::numeric_limits<std::int32_t>::max() - 65521; raw += 65521)
+  {
+    const auto original = P::from_raw_value(raw);
+    for (const auto fmt : { std::chars_format::fixed, std::chars_format::scientific, std::chars_format::hex })
+    {
+      const auto end = std::to_chars(buffer.data(), buffer.data() + buffer.size(), original, fmt, 16).ptr;
+      // Strip the "0x" prefix of hexadecimal output, keeping the sign
+      auto start = buffer.data();
+      if (fmt == std::chars_format::hex) {
+        start += 2;
+        if (raw < 0) {
+          *start = '-';
+        }
+      }
+      P result{};
+      const auto res = std::from_chars(start, end, result, fmt);
+      ASSERT_EQ(res.ec, std::errc{});
+      EXPECT_EQ(res.ptr, end);
+      EXPECT_EQ(result, original);
+    }
+  }
+}
+
+TEST(chars, from_chars_constexpr)
+{
+  constexpr auto parse = [](std::string_view text) {
+    fpm::fixed_16_16 value{};
+    std::from_chars(text.data(), text.data() + text.size(), value);
+    return value;
+  };
+  static_assert(parse("1.25") == fpm::fixed_16_16{1.25});
+  static_assert(parse("-0.5e1") == fpm::fixed_16_16{-5});
+}
+
 TEST(chars, fail)
 {
   using namespace std::string_literals;
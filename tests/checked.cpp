@@ -0,0 +1,212 @@
+#include "common.hpp"
+#include <fpm/checked.hpp>
+#include <thread>
+#include <utility>
+
+namespace
+{
+
+// The result of an overflow: the raw value wrapped modulo 2^bits
+template <typename P>
+constexpr P wrapped(std::int64_t raw) noexcept
+{
+    return P::from_raw_value(static_cast<typename P::base_type>(raw));
+}
+
+}
+
+TEST(checked, add_sub)
+{
+    using P = fpm::fixed_16_16;
+    const P max = std::numeric_limits<P>::max(), min = std::numeric_limits<P>::lowest();
+    fpm::overflow_flag flag;
+
+    EXPECT_EQ(P(10.75), fpm::add_checked(P(3.5), P(7.25), flag));
+    EXPECT_EQ(P(-3.75), fpm::sub_checked(P(3.5), P(7.25), flag));
+    EXPECT_EQ(P::from_raw_value(-1), fpm::add_checked(max, min, flag));
+    EXPECT_FALSE(flag.test());
+
+    // Overflows wrap around
+    EXPECT_EQ(wrapped<P>(std::int64_t{40000} << 16), fpm::add_checked(P(20000), P(20000), flag));
+    EXPECT_TRUE(flag.test());
+
+    // The flag is sticky
+    EXPECT_EQ(P(2), fpm::add_checked(P(1), P(1), flag));
+    EXPECT_TRUE(flag);
+    flag.clear();
+    EXPECT_FALSE(flag);
+
+    EXPECT_EQ(wrapped<P>(std::int64_t{min.raw_value()} - 65536), fpm::add_checked(min, P(-1), flag));
+    EXPECT_TRUE(std::exchange(flag, {}).test());
+    EXPECT_EQ(wrapped<P>(std::int64_t{-40000} << 16), fpm::sub_checked(P(-20000), P(20000), flag));
+    EXPECT_TRUE(std::exchange(flag, {}).test());
+    EXPECT_EQ(P(0), fpm::sub_checked(min, min, flag));
+    EXPECT_FALSE(flag.test());
+
+    using U = fpm::fixed<std::uint16_t, std::uint32_t, 8>;
+    (void)fpm::sub_checked(U(3), U(4), flag);
+    EXPECT_TRUE(std::exchange(flag, {}).test());
+    (void)fpm::add_checked(U(200), U(100), flag);
+    EXPECT_TRUE(std::exchange(flag, {}).test());
+    (void)fpm::add_checked(U(200), U(55), flag);
+    EXPECT_FALSE(flag.test());
+}
+
+TEST(checked, mul_div)
+{
+    using P = fpm::fixed_16_16;
+    const P min = std::numeric_limits<P>::lowest();
+    fpm::overflow_flag flag;
+
+    for (int i = -100; i <= 100; ++i)
+    {
+        const P x = P(i) / 7, y = P(i * 3 + 1) / 13;
+        EXPECT_EQ(x * y, fpm::mul_checked(x, y, flag));
+        EXPECT_EQ(x / y, fpm::div_checked(x, y, flag));
+        EXPECT_EQ(x * 1000, fpm::mul_checked(x, 1000, flag));
+        EXPECT_EQ(x / 3, fpm::div_checked(x, 3, flag));
+    }
+    EXPECT_FALSE(flag.test());
+
+    // The narrowing of the intermediate result is detected
+    EXPECT_EQ(P(300) * P(300), fpm::mul_checked(P(300), P(300), flag));
+    EXPECT_TRUE(std::exchange(flag, {}).test());
+    EXPECT_EQ(P(30000) / P(0.5), fpm::div_checked(P(30000), P(0.5), flag));
+    EXPECT_TRUE(std::exchange(flag, {}).test());
+    (void)fpm::mul_checked(min, P(-1), flag);
+    EXPECT_TRUE(std::exchange(flag, {}).test());
+    (void)fpm::div_checked(min, -1, flag);
+    EXPECT_TRUE(std::exchange(flag, {}).test());
+
+    // Integers
+    EXPECT_EQ(wrapped<P>(std::int64_t{60000} << 16), fpm::mul_checked(P(3), 20000, flag));
+    EXPECT_TRUE(std::exchange(flag, {}).test());
+    (void)fpm::mul_checked(P::from_raw_value(-1), std::numeric_limits<std::int64_t>::lowest(), flag);
+    EXPECT_TRUE(std::exchange(flag, {}).test());
+    (void)fpm::mul_checked(P(0), std::numeric_limits<std::int64_t>::max(), flag);
+    EXPECT_FALSE(flag.test());
+    EXPECT_EQ(P(10.5) + 20000, fpm::add_checked(P(10.5), 20000, flag));
+    EXPECT_EQ(20000 - P(10.5), fpm::sub_checked(20000, P(10.5), flag));
+    EXPECT_FALSE(flag.test());
+    EXPECT_EQ(wrapped<P>(std::int64_t{40000} << 16), fpm::add_checked(P(20000), 20000, flag));
+    EXPECT_TRUE(std::exchange(flag, {}).test());
+    EXPECT_EQ(wrapped<P>(std::int64_t{-40000} << 16), fpm::sub_checked(-20000, P(20000), flag));
+    EXPECT_TRUE(std::exchange(flag, {}).test());
+    // The scaling of the integer overflows, even where the sum would fit
+    (void)fpm::add_checked(P(-30000), 40000, flag);
+    EXPECT_TRUE(std::exchange(flag, {}).test());
+    (void)fpm::sub_checked(P(-30000), -40000, flag);
+    EXPECT_TRUE(std::exchange(flag, {}).test());
+
+    // 64-bit types
+    using Q = fpm::fixed_32_32;
+    EXPECT_EQ(Q(1000000), fpm::mul_checked(Q(1000), Q(1000), flag));
+    EXPECT_FALSE(flag.test());
+    (void)fpm::mul_checked(Q(100000), Q(100000), flag);
+    EXPECT_TRUE(flag.test());
+}
+
+TEST(checked, shift)
+{
+    using P = fpm::fixed_16_16;
+    fpm::overflow_flag flag;
+
+    EXPECT_EQ(P(12), fpm::shl_checked(P(3), 2, flag));
+    EXPECT_EQ(P(-16384), fpm::shl_checked(P(-8192), 1, flag));
+    EXPECT_FALSE(flag.test());
+    EXPECT_EQ(P(3) << 14, fpm::shl_checked(P(3), 14, flag));
+    EXPECT_TRUE(std::exchange(flag, {}).test());
+    (void)fpm::shl_checked(P(-16384), 2, flag);
+    EXPECT_TRUE(flag.test());
+}
+
+TEST(checked, conversion)
+{
+    using P = fpm::fixed_16_16;
+    fpm::overflow_flag flag;
+
+    EXPECT_EQ(P(1234), fpm::checked_cast<P>(1234, flag));
+    EXPECT_EQ(P(-32768), fpm::checked_cast<P>(-32768, flag));
+    EXPECT_EQ(P(12.25), fpm::checked_cast<P>(12.25, flag));
+    EXPECT_EQ(P(-12.25), fpm::checked_cast<P>(-12.25f, flag));
+    EXPECT_EQ(P(3.25), fpm::checked_cast<P>(fpm::fixed_8_24(3.25), flag));
+    EXPECT_EQ(fpm::fixed_8_24(3.25), fpm::checked_cast<fpm::fixed_8_24>(P(3.25), flag));
+    EXPECT_FALSE(flag.test());
+
+    EXPECT_EQ(P(32768), fpm::checked_cast<P>(32768, flag));
+    EXPECT_TRUE(std::exchange(flag, {}).test());
+    (void)fpm::checked_cast<P>(std::numeric_limits<std::uint64_t>::max(), flag);
+    EXPECT_TRUE(std::exchange(flag, {}).test());
+    EXPECT_EQ(P(0), fpm::checked_cast<P>(32768.0, flag));
+    EXPECT_TRUE(std::exchange(flag, {}).test());
+    EXPECT_EQ(P(0), fpm::checked_cast<P>(std::numeric_limits<double>::quiet_NaN(), flag));
+    EXPECT_TRUE(std::exchange(flag, {}).test());
+    EXPECT_EQ(wrapped<fpm::fixed_8_24>(std::int64_t{200} << 24), fpm::checked_cast<fpm::fixed_8_24>(P(200), flag));
+    EXPECT_TRUE(std::exchange(flag, {}).test());
+    (void)fpm::checked_cast<fpm::fixed_8_8>(fpm::fixed_32_32(1000), flag);
+    EXPECT_TRUE(std::exchange(flag, {}).test());
+    EXPECT_EQ(fpm::fixed_32_32(-100), fpm::checked_cast<fpm::fixed_32_32>(fpm::fixed_8_8(-100), flag));
+    EXPECT_FALSE(flag.test());
+}
+
+TEST(checked, wrapper)
+{
+    using P = fpm::fixed_16_16;
+    using C = fpm::checked<P>;
+    auto& flag = fpm::thread_overflow_flag();
+    flag.clear();
+
+    // A batch of calculations without overflow
+    C sum(0);
+    P expected(0);
+    for (int i = 1; i <= 100; ++i)
+    {
+        sum += C(i) * C(0.5) / 2 - C(1) + (C(i) << 2) - (C(i) >> 1);
+        expected += P(i) * P(0.5) / 2 - P(1) + (P(i) << 2) - (P(i) >> 1);
+    }
+    EXPECT_EQ(expected, sum.value());
+    EXPECT_FALSE(flag.test());
+
+    // The same results as the checked functions
+    EXPECT_EQ(wrapped<P>(std::int64_t{40000} << 16), (C(20000) + C(20000)).value());
+    EXPECT_TRUE(std::exchange(flag, {}).test());
+    EXPECT_EQ(P(300) * P(300), (C(300) * C(300)).value());
+    EXPECT_TRUE(std::exchange(flag, {}).test());
+    (void)(C(3) * 20000);
+    EXPECT_TRUE(std::exchange(flag, {}).test());
+    EXPECT_EQ(C(20001.5), C(1.5) + 20000);
+    EXPECT_EQ(C(-19998.5), C(1.5) - 20000);
+    EXPECT_EQ(C(19998.5), 20000 - C(1.5));
+    EXPECT_FALSE(flag.test());
+    (void)(C(20000) + 20000);
+    EXPECT_TRUE(std::exchange(flag, {}).test());
+    (void)(-20000 - C(20000));
+    EXPECT_TRUE(std::exchange(flag, {}).test());
+    (void)(C(0) += 40000);
+    EXPECT_TRUE(std::exchange(flag, {}).test());
+    (void)-std::numeric_limits<C>::lowest();
+    EXPECT_TRUE(std::exchange(flag, {}).test());
+    (void)C(1e9);
+    EXPECT_TRUE(std::exchange(flag, {}).test());
+    EXPECT_EQ(-C(3), C(-3));
+    EXPECT_FALSE(flag.test());
+
+    // Each thread has its own flag
+    flag.raise();
+    bool other = true;
+    std::thread([&] { other = fpm::thread_overflow_flag().test(); }).join();
+    EXPECT_FALSE(other);
+    EXPECT_TRUE(std::exchange(flag, {}).test());
+}
+
+TEST(checked, constexpr)
+{
+    using P = fpm::fixed_16_16;
+    static_assert([] {
+        fpm::overflow_flag flag;
+        (void)fpm::add_checked(std::numeric_limits<P>::max(), P(1), flag);
+        return flag.test();
+    }(), "add_checked failed");
+    static_assert(fpm::checked<P>(2) * 3 == fpm::checked<P>(6), "checked failed");
+    static_assert(1 + fpm::checked<P>(2) - 3 == fpm::checked<P>(0), "checked failed");
+}
@@ -120,6 +120,29 @@ TYPED_TEST(customizations, numeric_limits)
     EXPECT_EQ(L::denorm_min(), TL::min());
 }
 
+TEST(customizations, numeric_limits_rounding)
+{
+    using Nearest = fpm::fixed<std::int32_t, std::int64_t, 16, fpm::rounding::half_even>;
+    EXPECT_EQ(std::numeric_limits<Nearest>::round_style, std::round_to_nearest);
+    EXPECT_EQ(std::numeric_limits<Nearest>::round_error(), Nearest(0.5));
+
+    using Truncate = fpm::fixed<std::int32_t, std::int64_t, 16, false>;
+    EXPECT_EQ(std::numeric_limits<Truncate>::round_style, std::round_toward_zero);
+    EXPECT_EQ(std::numeric_limits<Truncate>::round_error(), Truncate(1));
+
+    using Floor = fpm::fixed<std::int32_t, std::int64_t, 16, fpm::rounding::floor>;
+    EXPECT_EQ(std::numeric_limits<Floor>::round_style, std::round_toward_neg_infinity);
+    EXPECT_EQ(std::numeric_limits<Floor>::round_error(), Floor(1));
+
+    using Ceil = fpm::fixed<std::int32_t, std::int64_t, 16, fpm::rounding::ceil>;
+    EXPECT_EQ(std::numeric_limits<Ceil>::round_style, std::round_toward_infinity);
+    EXPECT_EQ(std::numeric_limits<Ceil>::round_error(), Ceil(1));
+
+    using Stochastic = fpm::fixed<std::int32_t, std::int64_t, 16, fpm::rounding::stochastic>;
+    EXPECT_EQ(std::numeric_limits<Stochastic>::round_style, std::round_indeterminate);
+    EXPECT_EQ(std::numeric_limits<Stochastic>::round_error(), Stochastic(1));
+}
+
 // Verify that a a type with a single integral bit works correctly
 TEST(customizations, numeric_limits_edge)
 {
@@ -7,7 +7,7 @@
 #       include <format>
 #       include <numbers>
 
-template <typename B, typename I, unsigned int F, bool R>
+template <typename B, typename I, unsigned int F, auto R>
 inline void ExpectFormat(
     const std::string_view format,
     const fpm::fixed<B, I, F, R> valFixed,
@@ -1,4 +1,5 @@
 #include "common.hpp"
+#include <random>
 
 #if defined(FPM_INT128)
 
@@ -12,4 +13,55 @@ TEST(int128, construct)
     fpm::fixed_8_56 x4{};
 }
 
+// Reference results of the 128-bit intermediate arithmetic
+template <typename P>
+static void ExpectSameAsIntermediate(std::mt19937_64& gen)
+{
+    using B = typename P::base_type;
+    using I = typename P::intermediate_type;
+    constexpr I FRACTION_MULT = P::FRACTION_MULT;
+
+    for (int i = 0; i < 20000; ++i)
+    {
+        // Random magnitudes, so that both small and overflowing results are covered
+        B a = static_cast<B>(gen() >> (gen() % 64)), b = static_cast<B>(gen() >> (gen() % 64));
+        if (std::numeric_limits<B>::is_signed && (gen() & 1)) a = B(0) - a;
+        if (std::numeric_limits<B>::is_signed && (gen() & 1)) b = B(0) - b;
+        if (i < 4)
+        {
+            a = (i & 1) ? std::numeric_limits<B>::lowest() : std::numeric_limits<B>::max();
+            b = (i & 2) ? std::numeric_limits<B>::lowest() : B(3);
+        }
+        if (b == 0) b = 1;
+
+        B product, quotient;
+        if (P::enable_rounding) {
+            const I p = (I(a) * b) / (FRACTION_MULT / 2), q = (I(a) * FRACTION_MULT * 2) / b;
+            product = static_cast<B>(p / 2 + p % 2);
+            quotient = static_cast<B>(q / 2 + q % 2);
+        } else {
+            product = static_cast<B>((I(a) * b) / FRACTION_MULT);
+            quotient = static_cast<B>((I(a) * FRACTION_MULT) / b);
+        }
+        EXPECT_EQ(product, (P::from_raw_value(a) * P::from_raw_value(b)).raw_value()) << a << " * " << b;
+        EXPECT_EQ(quotient, (P::from_raw_value(a) / P::from_raw_value(b)).raw_value()) << a << " / " << b;
+    }
+}
+
+TEST(int128, multiplication_division)
+{
+    std::mt19937_64 gen(12345);
+    ExpectSameAsIntermediate<fpm::fixed_56_8>(gen);
+    ExpectSameAsIntermediate<fpm::fixed_32_32>(gen);
+    ExpectSameAsIntermediate<fpm::fixed_8_56>(gen);
+    ExpectSameAsIntermediate<fpm::fixed<std::int64_t, fpm::int128_t, 1>>(gen);
+    ExpectSameAsIntermediate<fpm::fixed<std::int64_t, fpm::int128_t, 63>>(gen);
+    ExpectSameAsIntermediate<fpm::fixed<std::int64_t, fpm::int128_t, 32, false>>(gen);
+    ExpectSameAsIntermediate<fpm::fixed<std::uint64_t, fpm::uint128_t, 32>>(gen);
+    ExpectSameAsIntermediate<fpm::fixed<std::uint64_t, fpm::uint128_t, 64, false>>(gen);
+
+    static_assert(fpm::fixed_32_32(-7.5) / fpm::fixed_32_32(2.5) == fpm::fixed_32_32(-3), "constexpr division failed");
+    static_assert(fpm::fixed_32_32(-7.5) * fpm::fixed_32_32(2.5) == fpm::fixed_32_32(-18.75), "constexpr multiplication failed");
+}
+
 #endif
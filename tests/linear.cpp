@@ -0,0 +1,238 @@
+#include "common.hpp"
+#include <fpm/linear.hpp>
+#include <cmath>
+#include <random>
+#include <vector>
+
+TEST(linear, vector_operators)
+{
+    using P = fpm::fixed_16_16;
+    using V = fpm::vec3<P>;
+
+    const V a{ P(1.5), P(-2), P(0.25) };
+    const V b{ P(-0.5), P(4), P(3) };
+    EXPECT_EQ((V{ P(1), P(2), P(3.25) }), a + b);
+    EXPECT_EQ((V{ P(2), P(-6), P(-2.75) }), a - b);
+    EXPECT_EQ((V{ P(-1.5), P(2), P(-0.25) }), -a);
+    EXPECT_EQ((V{ P(3), P(-4), P(0.5) }), a * P(2));
+    EXPECT_EQ((V{ P(3), P(-4), P(0.5) }), P(2) * a);
+    EXPECT_EQ((V{ P(0.75), P(-1), P(0.125) }), a / P(2));
+    EXPECT_EQ(P(-2), a.y());
+    EXPECT_EQ(P(0.25), a[2]);
+    EXPECT_EQ((V{ P(0), P(0), P(0) }), V{});
+
+    // The number of elements is deduced
+    const fpm::vec v{ P(1), P(2), P(3), P(4) };
+    static_assert(std::is_same_v<decltype(v), const fpm::vec4<P>>);
+    EXPECT_EQ(P(4), v.w());
+}
+
+TEST(linear, products)
+{
+    using P = fpm::fixed_16_16;
+    using V = fpm::vec3<P>;
+
+    const V a{ P(1.5), P(-2), P(0.25) };
+    const V b{ P(-0.5), P(4), P(3) };
+    EXPECT_EQ(P(-8), fpm::dot(a, b));
+    EXPECT_EQ((V{ P(-7), P(-4.625), P(5) }), fpm::cross(a, b));
+    EXPECT_EQ(P(0), fpm::dot(a, fpm::cross(a, b)));
+    EXPECT_EQ(P(5.0), fpm::cross(fpm::vec2<P>{ P(1), P(-2) }, fpm::vec2<P>{ P(0.5), P(4) }));
+
+    // Products below the resolution of the type are not lost: each element is rounded once
+    const P tiny = P::from_raw_value(181);
+    const V t{ tiny, tiny, tiny };
+    EXPECT_EQ(P(0), tiny * tiny + tiny * tiny + tiny * tiny);
+    EXPECT_EQ(P::from_raw_value(1), fpm::dot(t, t)); // 3 * 181 * 181 / 65536 = 1.5
+
+    std::mt19937 gen(1234);
+    std::uniform_int_distribution<std::int32_t> dist(-1 << 22, 1 << 22);
+    for (int i = 0; i < 1000; ++i)
+    {
+        V x, y;
+        for (std::size_t k = 0; k < 3; ++k)
+        {
+            x[k] = P::from_raw_value(dist(gen));
+            y[k] = P::from_raw_value(dist(gen));
+        }
+        const auto exact = [](P a1, P b1, P a2, P b2) {
+            return P(static_cast<double>(a1) * static_cast<double>(b1) - static_cast<double>(a2) * static_cast<double>(b2));
+        };
+        EXPECT_EQ(exact(x[0], y[0], -x[1], y[1]), fpm::dot(fpm::vec2<P>{ x[0], x[1] }, fpm::vec2<P>{ y[0], y[1] }));
+        EXPECT_EQ((V{ exact(x[1], y[2], x[2], y[1]), exact(x[2], y[0], x[0], y[2]), exact(x[0], y[1], x[1], y[0]) }), fpm::cross(x, y));
+    }
+}
+
+TEST(linear, length)
+{
+    using P = fpm::fixed_16_16;
+
+    EXPECT_EQ(P(13), fpm::length(fpm::vec3<P>{ P(3), P(4), P(12) }));
+    EXPECT_EQ(P(0), fpm::length(fpm::vec4<P>{}));
+    EXPECT_EQ(fpm::hypot(P(-1.25), P(7.5)), fpm::length(fpm::vec2<P>{ P(-1.25), P(7.5) }));
+
+    // The squares don't overflow
+    EXPECT_EQ(P(30000), fpm::length(fpm::vec4<P>{ P(15000), P(-15000), P(15000), P(-15000) }));
+
+    std::mt19937 gen(1234);
+    std::uniform_int_distribution<std::int32_t> dist(-1 << 29, 1 << 29);
+    for (int i = 0; i < 1000; ++i)
+    {
+        const fpm::vec4<P> v{ P::from_raw_value(dist(gen)), P::from_raw_value(dist(gen)), P::from_raw_value(dist(gen)), P::from_raw_value(dist(gen)) };
+        double sum = 0;
+        for (std::size_t k = 0; k < 4; ++k)
+        {
+            sum += static_cast<double>(v[k]) * static_cast<double>(v[k]);
+        }
+        EXPECT_EQ(P(std::sqrt(sum)), fpm::length(v));
+    }
+}
+
+template <typename P>
+static void ExpectNormalized(std::int64_t range, double max_error)
+{
+    std::mt19937 gen(1234);
+    std::uniform_int_distribution<std::int64_t> dist(-range, range);
+    for (int i = 0; i < 1000; ++i)
+    {
+        fpm::vec3<P> v;
+        for (std::size_t k = 0; k < 3; ++k)
+        {
+            v[k] = P::from_raw_value(static_cast<typename P::base_type>(dist(gen) >> (i % 24)));
+        }
+        if (v == fpm::vec3<P>{})
+        {
+            continue;
+        }
+        const double length = std::hypot(static_cast<double>(v[0]), static_cast<double>(v[1]), static_cast<double>(v[2]));
+        const auto n = fpm::normalize(v);
+        for (std::size_t k = 0; k < 3; ++k)
+        {
+            EXPECT_NEAR(static_cast<double>(v[k]) / length, static_cast<double>(n[k]), max_error);
+        }
+    }
+}
+
+TEST(linear, normalize)
+{
+    using P = fpm::fixed_16_16;
+    EXPECT_EQ((fpm::vec3<P>{ P(0.6), P(0), P(-0.8) }), fpm::normalize(fpm::vec3<P>{ P(3), P(0), P(-4) }));
+    EXPECT_EQ((fpm::vec2<P>{ P(0), P(1) }), fpm::normalize(fpm::vec2<P>{ P(0), P::from_raw_value(1) }));
+    EXPECT_EQ((fpm::vec2<P>{ P(-1), P(0) }), fpm::normalize(fpm::vec2<P>{ P(-32768), P(0) }));
+
+    // The sum of the squares doesn't fit the intermediate type, but the result does
+    const P lowest = std::numeric_limits<P>::lowest();
+    EXPECT_EQ((fpm::vec4<P>{ P(-0.5), P(-0.5), P(-0.5), P(-0.5) }), fpm::normalize(fpm::vec4<P>{ lowest, lowest, lowest, lowest }));
+    for (const P element : fpm::normalize(fpm::vec<5, P>{ P(30000), P(30000), P(30000), P(30000), P(30000) }).elements)
+    {
+        EXPECT_NEAR(1 / std::sqrt(5.0), static_cast<double>(element), 1.0 / 65536);
+    }
+    const auto large = fpm::normalize(fpm::vec<9, P>{ P(32767), P(-32767), P(32767), P(-32767), P(32767), P(-32767), P(32767), P(-32767), P(0) });
+    EXPECT_NEAR(std::sqrt(0.125), static_cast<double>(large[0]), 1.0 / 65536);
+    EXPECT_NEAR(-std::sqrt(0.125), static_cast<double>(large[7]), 1.0 / 65536);
+    EXPECT_EQ(P(0), large[8]);
+
+    // Within the resolution of the type, up to rounding
+    ExpectNormalized<P>((std::int64_t{1} << 31) - 1, 1.0 / 65536);
+    ExpectNormalized<fpm::fixed_8_24>((std::int64_t{1} << 31) - 1, 1.5 / (1 << 24));
+#if defined(FPM_INT128)
+    ExpectNormalized<fpm::fixed_32_32>(std::int64_t{1} << 62, 1e-9);
+    using Q = fpm::fixed_32_32;
+    const Q q = std::numeric_limits<Q>::lowest();
+    EXPECT_EQ((fpm::vec4<Q>{ Q(-0.5), Q(-0.5), Q(-0.5), Q(-0.5) }), fpm::normalize(fpm::vec4<Q>{ q, q, q, q }));
+#endif
+}
+
+TEST(linear, matrices)
+{
+    using P = fpm::fixed_16_16;
+    using M = fpm::mat<2, 3, P>;
+
+    const M a{ P(1), P(2), P(3),
+               P(-1), P(0.5), P(0) };
+    const fpm::mat<3, 2, P> t{ P(1), P(-1),
+                               P(2), P(0.5),
+                               P(3), P(0) };
+    EXPECT_EQ(t, fpm::transpose(a));
+    EXPECT_EQ(P(0.5), a[1][1]);
+    EXPECT_EQ((fpm::vec3<P>{ P(-1), P(0.5), P(0) }), a[1]);
+    EXPECT_EQ(a, fpm::transpose(t));
+    EXPECT_EQ(a, a * fpm::mat3<P>::identity());
+    EXPECT_EQ(a, fpm::mat2<P>::identity() * a);
+    EXPECT_EQ(a * P(2), a + a);
+    EXPECT_EQ(P(2) * a, a - (-a));
+    EXPECT_EQ(M{}, a - a);
+
+    EXPECT_EQ((fpm::vec2<P>{ P(14), P(0) }), (a * fpm::vec3<P>{ P(1), P(2), P(3) }));
+    EXPECT_EQ((fpm::mat2<P>{ P(14), P(0), P(0), P(1.25) }), a * t);
+
+    // Each element of a product is rounded once
+    const P tiny = P::from_raw_value(181);
+    const fpm::mat2<P> small{ tiny, tiny, tiny, -tiny };
+    EXPECT_EQ((fpm::mat2<P>{ P::from_raw_value(1), P(0), P(0), P::from_raw_value(1) }), small * small);
+    EXPECT_EQ((fpm::vec2<P>{ P::from_raw_value(1), P(0) }), (small * fpm::vec2<P>{ tiny, tiny }));
+}
+
+TEST(linear, constexpr)
+{
+    using P = fpm::fixed_16_16;
+    using V = fpm::vec3<P>;
+    constexpr V a{ P(3), P(0), P(-4) };
+    static_assert(fpm::dot(a, a) == P(25));
+    static_assert(fpm::length(a) == P(5));
+    static_assert(fpm::normalize(a) == V{ P(0.6), P(0), P(-0.8) });
+    static_assert(fpm::cross(a, V{ P(0), P(1), P(0) }) == V{ P(4), P(0), P(3) });
+    static_assert(fpm::mat3<P>::identity() * a == a);
+    static_assert(fpm::transpose(fpm::mat3<P>::identity()) * fpm::mat3<P>::identity() == fpm::mat3<P>::identity());
+    SUCCEED();
+}
+
+TEST(linear, batch)
+{
+    using P = fpm::fixed_16_16;
+    constexpr std::size_t n = 37;
+
+    std::mt19937 gen(1234);
+    std::uniform_int_distribution<std::int32_t> dist(-1 << 24, 1 << 24);
+    std::array<std::vector<P>, 3> x, y, out;
+    for (std::size_t k = 0; k < 3; ++k)
+    {
+        x[k].resize(n);
+        y[k].resize(n);
+        out[k].resize(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            x[k][i] = P::from_raw_value(dist(gen));
+            y[k][i] = P::from_raw_value(dist(gen));
+        }
+    }
+    const auto vx = [&](std::size_t i) { return fpm::vec3<P>{ x[0][i], x[1][i], x[2][i] }; };
+    const auto vy = [&](std::size_t i) { return fpm::vec3<P>{ y[0][i], y[1][i], y[2][i] }; };
+    const auto vout = [&](std::size_t i) { return fpm::vec3<P>{ out[0][i], out[1][i], out[2][i] }; };
+    std::vector<P> result(n);
+
+    fpm::batch::dot<3, P>({ x[0], x[1], x[2] }, { y[0], y[1], y[2] }, result);
+    for (std::size_t i = 0; i < n; ++i) EXPECT_EQ(fpm::dot(vx(i), vy(i)), result[i]);
+
+    fpm::batch::length<3, P>({ x[0], x[1], x[2] }, result);
+    for (std::size_t i = 0; i < n; ++i) EXPECT_EQ(fpm::length(vx(i)), result[i]);
+
+    fpm::batch::length<2, P>({ x[0], x[1] }, result);
+    for (std::size_t i = 0; i < n; ++i) EXPECT_EQ(fpm::length(fpm::vec2<P>{ x[0][i], x[1][i] }), result[i]);
+
+    fpm::batch::length<4, P>({ x[0], x[1], x[2], y[0] }, result);
+    for (std::size_t i = 0; i < n; ++i) EXPECT_EQ(fpm::length(fpm::vec4<P>{ x[0][i], x[1][i], x[2][i], y[0][i] }), result[i]);
+
+    fpm::batch::cross<3, P>({ x[0], x[1], x[2] }, { y[0], y[1], y[2] }, { out[0], out[1], out[2] });
+    for (std::size_t i = 0; i < n; ++i) EXPECT_EQ(fpm::cross(vx(i), vy(i)), vout(i));
+
+    fpm::batch::normalize<3, P>({ x[0], x[1], x[2] }, { out[0], out[1], out[2] });
+    for (std::size_t i = 0; i < n; ++i) EXPECT_EQ(fpm::normalize(vx(i)), vout(i));
+
+    // The matrix determines the number of elements
+    const fpm::mat3<P> m{ P(0.5), P(-1), P(2),
+                         P(0), P(1), P(0.25),
+                         P(-3), P(0), P(1) };
+    fpm::batch::transform(m, { x[0], x[1], x[2] }, { out[0], out[1], out[2] });
+    for (std::size_t i = 0; i < n; ++i) EXPECT_EQ(m * vx(i), vout(i));
+}
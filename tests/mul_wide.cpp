@@ -0,0 +1,104 @@
+#include "common.hpp"
+#include <fpm/accumulator.hpp>
+#include <random>
+
+#if defined(FPM_INT128)
+TEST(mul_wide, exact)
+{
+    using A = fpm::fixed_8_24;
+    using B = fpm::fixed_16_16;
+    using W = fpm::fixed<std::int64_t, fpm::int128_t, 40>;
+
+    const A a(-1.2345678);
+    const B b(1234.5678);
+    const auto product = fpm::mul_wide(a, b);
+    static_assert(std::is_same_v<decltype(product), const W>);
+    EXPECT_EQ(std::int64_t{a.raw_value()} * b.raw_value(), product.raw_value());
+    EXPECT_EQ(static_cast<double>(a) * static_cast<double>(b), static_cast<double>(product));
+
+    // The extremes fit too
+    const auto lowest = fpm::mul_wide(std::numeric_limits<A>::lowest(), std::numeric_limits<B>::lowest());
+    EXPECT_EQ(std::int64_t{1} << 62, lowest.raw_value());
+
+    // The wider intermediate type is used for different base types
+    const auto mixed = fpm::mul_wide(fpm::fixed_8_8(-0.5), fpm::fixed_24_8(3));
+    static_assert(std::is_same_v<decltype(mixed), const fpm::fixed<std::int64_t, fpm::int128_t, 16>>);
+    EXPECT_EQ(-1.5, static_cast<double>(mixed));
+}
+
+TEST(mul_wide, single_rounding)
+{
+    using A = fpm::fixed_8_24;
+    using B = fpm::fixed_16_16;
+
+    // The exact product is just below half of the last bit of a fixed_16_16: 8388607 / 2**40
+    const A a = A::from_raw_value(47);
+    const B b = B::from_raw_value(178481);
+    EXPECT_EQ(B(0), fpm::mul_wide(a, b).narrow<B>());
+
+    // Multiplying in fixed_8_24 first rounds it to exactly half, which then rounds up
+    EXPECT_EQ(B::from_raw_value(1), (a * A(b)).narrow<B>());
+
+    // Every mode rounds the exact product
+    std::mt19937 gen(1234);
+    std::uniform_int_distribution<std::int32_t> dist(-1 << 26, 1 << 26);
+    for (int i = 0; i < 1000; ++i)
+    {
+        const A x = A::from_raw_value(dist(gen));
+        const B y = B::from_raw_value(dist(gen));
+        const auto product = fpm::mul_wide(x, y);
+        const std::int64_t raw = product.raw_value();
+        EXPECT_EQ(fpm::fixed_16_16::from_fixed_point<40>(raw), product.narrow<fpm::fixed_16_16>());
+        EXPECT_EQ(fpm::fixed_24_8::from_fixed_point<40>(raw), product.narrow<fpm::fixed_24_8>());
+
+        using Floor = fpm::fixed<std::int32_t, std::int64_t, 16, fpm::rounding::floor>;
+        EXPECT_EQ(Floor::from_raw_value(static_cast<std::int32_t>(raw >> 24)), product.narrow<Floor>());
+        using Even = fpm::fixed<std::int32_t, std::int64_t, 16, fpm::rounding::half_even>;
+        EXPECT_EQ(Even(static_cast<double>(product)), product.narrow<Even>());
+    }
+}
+
+TEST(mul_wide, narrow)
+{
+    // To more fraction bits, which are added in the wider base type
+    using W = fpm::fixed<std::int64_t, fpm::int128_t, 32>;
+    EXPECT_EQ(W(-1000.5), fpm::fixed_24_8(-1000.5).narrow<W>());
+    EXPECT_EQ(fpm::fixed_8_24(-3.25), fpm::fixed_8_8(-3.25).narrow<fpm::fixed_8_24>());
+
+    // The same format
+    EXPECT_EQ(fpm::fixed_16_16(7.125), fpm::fixed_16_16(7.125).narrow<fpm::fixed_16_16>());
+}
+
+TEST(mul_wide, accumulator)
+{
+    using P = fpm::fixed_16_16;
+    fpm::accumulator<P> acc(P(1));
+    acc += fpm::mul_wide(P(2.5), P(-4));
+    acc -= fpm::mul_wide(P(0.5), P(0.25));
+    EXPECT_EQ(P(-9.125), acc.value());
+
+    fpm::accumulator<P> fma(P(1));
+    fma.fma(P(2.5), P(-4));
+    fma.fms(P(0.5), P(0.25));
+    EXPECT_EQ(fma, acc);
+}
+#endif
+
+TEST(mul_wide, unsigned_types)
+{
+    using U = fpm::fixed<std::uint16_t, std::uint32_t, 12>;
+    const auto product = fpm::mul_wide(U(3.5), U(2.25));
+    static_assert(std::is_same_v<decltype(product), const fpm::fixed<std::uint32_t, std::uint64_t, 24>>);
+    EXPECT_EQ(7.875, static_cast<double>(product));
+    EXPECT_EQ(U(7.875), product.narrow<U>());
+}
+
+TEST(mul_wide, constexpr)
+{
+    using P = fpm::fixed_8_8;
+    constexpr auto product = fpm::mul_wide(P(1.5), P(-2.75));
+    static_assert(product.raw_value() == -4.125 * 65536);
+    static_assert(product.narrow<P>() == P(-4.125));
+    static_assert(fpm::mul_wide(P::from_raw_value(1), P::from_raw_value(128)).narrow<P>() == P::from_raw_value(1));
+    SUCCEED();
+}
@@ -17,6 +17,52 @@ TEST(power, exp)
     }
 }
 
+TEST(power, exp_negative)
+{
+    // Negative arguments are as accurate as positive ones: within half of the resolution
+    using P = fpm::fixed_16_16;
+    for (double value = -12; value <= 0; value += 0.001)
+    {
+        const double exp_real = std::exp(static_cast<double>(P(value)));
+        EXPECT_NEAR(exp_real, static_cast<double>(exp(P(value))), 0.5 / 65536) << value;
+    }
+
+    // Integers get the rounded power of e
+    EXPECT_EQ(P(std::exp(-3.0)), exp(P(-3)));
+    EXPECT_EQ(P(1), exp(P(0)));
+
+    // Results below half of the resolution are zero, except when rounding up
+    EXPECT_EQ(P(0), exp(P(-11.8)));
+    EXPECT_EQ(P(0), exp(std::numeric_limits<P>::lowest()));
+    EXPECT_EQ(P::from_raw_value(1), exp(P(-11.7)));
+    using Ceil = fpm::fixed<std::int32_t, std::int64_t, 16, fpm::rounding::ceil>;
+    EXPECT_EQ(Ceil::from_raw_value(1), exp(std::numeric_limits<Ceil>::lowest()));
+    using Floor = fpm::fixed<std::int32_t, std::int64_t, 16, fpm::rounding::floor>;
+    EXPECT_EQ(Floor(0), exp(Floor(-11.2)));
+
+    static_assert(exp(fpm::fixed_16_16(-1)) == fpm::fixed_16_16(0.36787944117144233));
+    static_assert(exp(fpm::fixed_16_16(-100)) == fpm::fixed_16_16(0));
+}
+
+TEST(power, exp_large)
+{
+    // The largest results that fit keep their relative accuracy, beyond the resolution of small ones
+    using P = fpm::fixed_24_8;
+    for (double value = 0; value < 15.9; value += 0.01)
+    {
+        const double exp_real = std::exp(static_cast<double>(P(value)));
+        EXPECT_NEAR(exp_real, static_cast<double>(exp(P(value))), 0.5 / 256 + exp_real * 1e-7) << value;
+    }
+#if defined(FPM_INT128)
+    using Q = fpm::fixed_32_32;
+    for (double value = -20; value < 21; value += 0.01)
+    {
+        const double exp_real = std::exp(static_cast<double>(Q(value)));
+        EXPECT_NEAR(exp_real, static_cast<double>(exp(Q(value))), 0.5 / 4294967296.0 + exp_real * 1e-11) << value;
+    }
+#endif
+}
+
 TEST(power, exp2)
 {
     // For several values, verify that fpm::exp2 is close to std::exp2.
@@ -109,6 +155,29 @@ TEST(power, log2)
 #endif
 }
 
+TEST(power, log_rounding)
+{
+    // log, log2 and log10 are rounded once from the same log2, to just over half of the resolution
+    using P = fpm::fixed_16_16;
+    for (double value = 0.0001; value < 32767; value *= 1.0013)
+    {
+        const double x = static_cast<double>(P(value));
+        EXPECT_NEAR(std::log2(x), static_cast<double>(log2(P(value))), 0.51 / 65536) << value;
+        EXPECT_NEAR(std::log(x), static_cast<double>(log(P(value))), 0.51 / 65536) << value;
+        EXPECT_NEAR(std::log10(x), static_cast<double>(log10(P(value))), 0.51 / 65536) << value;
+    }
+
+    // Powers of two are exact
+    EXPECT_EQ(P(-16), log2(P::from_raw_value(1)));
+    EXPECT_EQ(P(14), log2(P(16384)));
+    EXPECT_EQ(P(0), log(P(1)));
+    EXPECT_EQ(P(0), log10(P(1)));
+
+    static_assert(log2(fpm::fixed_16_16(0.125)) == fpm::fixed_16_16(-3));
+    static_assert(log(fpm::fixed_16_16(2)) == fpm::fixed_16_16(0.69314718055994531));
+    static_assert(log10(fpm::fixed_16_16(1000)) == fpm::fixed_16_16(3));
+}
+
 TEST(power, log10)
 {
     // For several values, verify that fpm::log10 is close to std::log10exp.
@@ -311,6 +380,106 @@ TEST(power, sqrt_24)
 
 }
 
+template <typename P>
+static void ExpectSqrtMatchesExact()
+{
+    using B = typename P::base_type;
+    constexpr int bits = sizeof(B) * 8 - 1;
+
+    // Every magnitude, with the lowest, highest and an irregular pattern of bits
+    for (int highest = 0; highest < bits; ++highest)
+    {
+        const B top = B{1} << highest;
+        for (const B raw : { top, static_cast<B>(top + (top - 1)), static_cast<B>(top | (static_cast<B>(0x5A3C96E1F0D2B487 & (top - 1)))) })
+        {
+            const P x = P::from_raw_value(raw);
+            EXPECT_EQ(fpm::sqrt_exact(x), fpm::sqrt(x));
+        }
+    }
+    for (B raw = 1; raw < 100000 && raw > 0; ++raw)
+    {
+        const P x = P::from_raw_value(raw);
+        EXPECT_EQ(fpm::sqrt_exact(x), fpm::sqrt(x));
+    }
+}
+
+TEST(power, sqrt_exact)
+{
+    // fpm::sqrt gives the same results as the digit-by-digit algorithm
+    ExpectSqrtMatchesExact<fpm::fixed_16_16>();
+    ExpectSqrtMatchesExact<fpm::fixed_24_8>();
+    ExpectSqrtMatchesExact<fpm::fixed_8_24>();
+    ExpectSqrtMatchesExact<fpm::fixed_8_8>();
+#if defined(FPM_INT128)
+    ExpectSqrtMatchesExact<fpm::fixed_32_32>();
+    ExpectSqrtMatchesExact<fpm::fixed_16_48>();
+#endif
+
+    static_assert(fpm::sqrt(fpm::fixed_16_16(2.25)) == fpm::fixed_16_16(1.5));
+    static_assert(fpm::sqrt(fpm::fixed_16_16(2)) == fpm::sqrt_exact(fpm::fixed_16_16(2)));
+}
+
+TEST(power, rsqrt)
+{
+    using P = fpm::fixed_16_16;
+
+    // The result is within half of the resolution, after rounding
+    for (double value = 0.01; value <= 10000; value += 0.3141593)
+    {
+        const P x(value);
+        EXPECT_NEAR(1 / std::sqrt(static_cast<double>(x)), static_cast<double>(rsqrt(x)), 0.5 / 65536);
+    }
+    EXPECT_EQ(P(256), rsqrt(P::from_raw_value(1)));
+
+#if defined(FPM_INT128)
+    using Q = fpm::fixed_32_32;
+    for (double value = 0.001; value <= 1000000; value *= 1.37)
+    {
+        const Q x(value);
+        EXPECT_NEAR(1 / std::sqrt(static_cast<double>(x)), static_cast<double>(rsqrt(x)), 0.5 / 4294967296.0 + 1e-15);
+    }
+#endif
+
+    static_assert(rsqrt(P(4)) == P(0.5));
+    static_assert(rsqrt(P(0.0625)) == P(4));
+
+#ifndef NDEBUG
+    EXPECT_DEATH(auto v = rsqrt(P(0)), "");
+#endif
+}
+
+TEST(power, hypot)
+{
+    using P = fpm::fixed_16_16;
+
+    // The squares don't have to fit in the base type, only the result
+    EXPECT_EQ(P(500), hypot(P(300), P(-400)));
+    EXPECT_EQ(P(30000), hypot(P(-18000), P(24000)));
+    EXPECT_EQ(P(0), hypot(P(0), P(0)));
+
+    // The result is rounded to nearest
+    for (double x = -23000; x <= 23000; x += 1234.5678)
+    {
+        for (double y = -0.5; y <= 23000; y += 987.654321)
+        {
+            const P px(x), py(y);
+            const double expected = std::hypot(static_cast<double>(px), static_cast<double>(py));
+            EXPECT_NEAR(expected, static_cast<double>(hypot(px, py)), 0.5 / 65536);
+            EXPECT_NEAR(std::hypot(expected, 0.75), static_cast<double>(hypot(px, py, P(0.75))), 0.5 / 65536);
+        }
+    }
+    EXPECT_EQ(P::from_raw_value(1), hypot(P::from_raw_value(1), P::from_raw_value(-1)));
+
+#if defined(FPM_INT128)
+    using Q = fpm::fixed_32_32;
+    EXPECT_EQ(Q(2000000000), hypot(Q(1200000000), Q(1600000000)));
+    EXPECT_EQ(Q(3000000), hypot(Q(1000000), Q(-2000000), Q(2000000)));
+#endif
+
+    static_assert(hypot(P(3), P(4)) == P(5));
+    static_assert(hypot(P(2), P(-3), P(6)) == P(7));
+}
+
 TEST(power, cbrt)
 {
     // For several values, verify that fpm::cbrt is close to std::cbrt.
@@ -353,3 +522,95 @@ TEST(power, cbrt_24)
         EXPECT_TRUE(HasMaximumError(cbrt_fixed, cbrt_real, MAX_ERROR_PERC));
     }
 }
+
+// Checks that cbrt rounds to nearest, (2*s - 1)**3 < 8 * n < (2*s + 1)**3 for n = x * 2**(2*F) in raw values,
+// where U holds these cubes
+template <typename P, typename U>
+static void ExpectCbrtRounded()
+{
+    using B = typename P::base_type;
+    constexpr int bits = sizeof(B) * 8 - 1;
+    for (int highest = 0; highest < bits; ++highest)
+    {
+        const B top = B{1} << highest;
+        for (const B raw : { top, static_cast<B>(top + (top - 1)), static_cast<B>(top | (static_cast<B>(0x5A3C96E1F0D2B487 & (top - 1)))) })
+        {
+            const B root = fpm::cbrt(P::from_raw_value(raw)).raw_value();
+            const U n8 = U(raw) << (2 * P::fraction_bits + 3);
+            const U low = 2 * U(root) - 1, high = 2 * U(root) + 1;
+            EXPECT_LT(low * low * low, n8) << raw;
+            EXPECT_GT(high * high * high, n8) << raw;
+            EXPECT_EQ(-root, fpm::cbrt(P::from_raw_value(-raw)).raw_value());
+        }
+    }
+}
+
+TEST(power, cbrt_rounding)
+{
+    ExpectCbrtRounded<fpm::fixed_8_8, std::uint64_t>();
+#if defined(FPM_INT128)
+    ExpectCbrtRounded<fpm::fixed_16_16, fpm::uint128_t>();
+    ExpectCbrtRounded<fpm::fixed_24_8, fpm::uint128_t>();
+    ExpectCbrtRounded<fpm::fixed_8_24, fpm::uint128_t>();
+
+    // 64-bit base types, within half of the resolution
+    using Q = fpm::fixed_32_32;
+    for (double value = 1e-9; value < 2e9; value *= 1.37)
+    {
+        const Q x(value);
+        const long double expected = std::cbrt(static_cast<long double>(x.raw_value()) / 4294967296.0L);
+        EXPECT_NEAR(static_cast<double>(expected), static_cast<double>(cbrt(x)), 0.5 / 4294967296.0 + 1e-13) << value;
+        EXPECT_EQ(-cbrt(x), cbrt(-x));
+    }
+#endif
+
+    static_assert(cbrt(fpm::fixed_16_16(-27)) == fpm::fixed_16_16(-3));
+    static_assert(cbrt(fpm::fixed_16_16(0.125)) == fpm::fixed_16_16(0.5));
+    static_assert(cbrt(fpm::fixed_8_8::from_raw_value(1)) == fpm::fixed_8_8::from_raw_value(40));
+}
+
+// Checks exp2 and log2 of fpm::fast and fpm::precise against the error of their polynomials, plus the
+// rounding of the result. exp2 is accurate relative to its result.
+template <typename P>
+static void ExpectTierAccuracy(int fast_bits, int precise_bits)
+{
+    const double resolution = std::ldexp(1.0, -static_cast<int>(P::fraction_bits));
+    const double fast_error = std::ldexp(1.0, -fast_bits), precise_error = std::ldexp(1.0, -precise_bits);
+    for (int i = -768; i < 768; ++i)
+    {
+        const P x(i / 128.0 + 0.0123);
+        const auto real = static_cast<double>(x);
+        const auto exp2_real = std::exp2(real);
+        EXPECT_NEAR(static_cast<double>(fpm::fast::exp2(x)), exp2_real, exp2_real * fast_error + resolution) << "exp2(" << real << ")";
+        EXPECT_NEAR(static_cast<double>(fpm::precise::exp2(x)), exp2_real, exp2_real * precise_error + resolution) << "exp2(" << real << ")";
+        if (x > P(0))
+        {
+            EXPECT_NEAR(static_cast<double>(fpm::fast::log2(x)), std::log2(real), fast_error + resolution / 2) << "log2(" << real << ")";
+            EXPECT_NEAR(static_cast<double>(fpm::precise::log2(x)), std::log2(real), precise_error / 2 + resolution / 2) << "log2(" << real << ")";
+        }
+    }
+}
+
+TEST(power, tiers)
+{
+    ExpectTierAccuracy<fpm::fixed_8_8>(8, 8);
+    ExpectTierAccuracy<fpm::fixed_24_8>(8, 8);
+    ExpectTierAccuracy<fpm::fixed_16_16>(12, 16);
+    ExpectTierAccuracy<fpm::fixed_8_24>(12, 24);
+#if defined(FPM_INT128)
+    ExpectTierAccuracy<fpm::fixed_32_32>(12, 32);
+    ExpectTierAccuracy<fpm::fixed<std::int64_t, fpm::int128_t, 48>>(12, 40);
+#endif
+
+    // Exact results, also in constant expressions
+    using P = fpm::fixed_16_16;
+    static_assert(fpm::precise::exp2(P(3)) == P(8));
+    static_assert(fpm::fast::log2(P(0.125)) == P(-3));
+    EXPECT_EQ(P(0.25), fpm::fast::exp2(P(-2)));
+    EXPECT_EQ(P(10), fpm::precise::log2(P(1024)));
+
+    // Results below the resolution round to zero
+    EXPECT_EQ(P(0), fpm::precise::exp2(P(-18)));
+    EXPECT_EQ(P(0), fpm::fast::exp2(P(-30000)));
+    EXPECT_EQ(P::from_raw_value(1), fpm::precise::exp2(P(-16)));
+}
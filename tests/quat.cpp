@@ -0,0 +1,267 @@
+#include "common.hpp"
+#include <fpm/math.hpp>
+#include <fpm/quat.hpp>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+using P = fpm::fixed_16_16;
+using Q = fpm::quat<P>;
+using V = fpm::vec3<P>;
+
+// A random unit quaternion from a random axis and angle
+template <typename R = Q>
+R random_rotation(std::mt19937& gen)
+{
+    using E = typename R::value_type;
+    std::uniform_real_distribution<double> dist(-1, 1);
+    double a[3], n = 0;
+    do
+    {
+        n = 0;
+        for (auto& v : a)
+        {
+            v = dist(gen);
+            n += v * v;
+        }
+    } while (n < 0.01 || n > 1);
+    n = std::sqrt(n);
+    const double angle = dist(gen) * 3;
+    const double s = std::sin(angle / 2);
+    return R{ E(std::cos(angle / 2)), E(a[0] / n * s), E(a[1] / n * s), E(a[2] / n * s) };
+}
+
+void ExpectNear(const V& expected, const V& actual, double max_error)
+{
+    for (std::size_t k = 0; k < 3; ++k)
+    {
+        EXPECT_NEAR(static_cast<double>(expected[k]), static_cast<double>(actual[k]), max_error);
+    }
+}
+
+void ExpectNear(const Q& expected, const Q& actual, double max_error)
+{
+    EXPECT_NEAR(static_cast<double>(expected.w), static_cast<double>(actual.w), max_error);
+    ExpectNear(expected.vector(), actual.vector(), max_error);
+}
+
+}
+
+TEST(quat, operators)
+{
+    const Q i{ P(0), P(1), P(0), P(0) }, j{ P(0), P(0), P(1), P(0) }, k{ P(0), P(0), P(0), P(1) };
+    EXPECT_EQ(k, i * j);
+    EXPECT_EQ(-k, j * i);
+    EXPECT_EQ(-Q::identity(), i * i);
+    EXPECT_EQ(-Q::identity(), i * j * k);
+
+    const Q q{ P(0.5), P(-1.5), P(2), P(0.25) };
+    EXPECT_EQ(q, Q::identity() * q);
+    EXPECT_EQ(q, q * Q::identity());
+    EXPECT_EQ((Q{ P(0.5), P(1.5), P(-2), P(-0.25) }), fpm::conjugate(q));
+    EXPECT_EQ(q + q, q * P(2));
+    EXPECT_EQ(q + q, P(2) * q);
+    EXPECT_EQ(Q{}, q - q);
+    EXPECT_EQ(P(6.5625), fpm::dot(q, q));
+    EXPECT_EQ(P(6.5625), (q * fpm::conjugate(q)).w);
+    EXPECT_EQ(P(std::sqrt(6.5625)), fpm::length(q));
+    EXPECT_EQ((V{ P(-1.5), P(2), P(0.25) }), q.vector());
+
+    // Each element of a product is rounded once
+    const P tiny = P::from_raw_value(181);
+    const Q t{ tiny, tiny, tiny, tiny };
+    EXPECT_EQ((Q{ P::from_raw_value(-1), P::from_raw_value(1), P::from_raw_value(1), P::from_raw_value(1) }), t * t);
+}
+
+TEST(quat, rotate)
+{
+    // A quarter turn around z
+    const Q q = Q::from_axis_angle(V{ P(0), P(0), P(1) }, P::half_pi());
+    ExpectNear(V{ P(0), P(1), P(0) }, fpm::rotate(q, V{ P(1), P(0), P(0) }), 2.0 / 65536);
+    ExpectNear(V{ P(-2), P(0), P(3) }, fpm::rotate(q, V{ P(0), P(2), P(3) }), 4.0 / 65536);
+    EXPECT_EQ((V{ P(1), P(2), P(3) }), fpm::rotate(Q::identity(), V{ P(1), P(2), P(3) }));
+
+    std::mt19937 gen(1234);
+    std::uniform_int_distribution<std::int32_t> dist(-100 << 16, 100 << 16);
+    for (int i = 0; i < 1000; ++i)
+    {
+        const Q r = random_rotation(gen);
+        const V v{ P::from_raw_value(dist(gen)), P::from_raw_value(dist(gen)), P::from_raw_value(dist(gen)) };
+
+        // The same rotation in double
+        const double w = static_cast<double>(r.w), x = static_cast<double>(r.x), y = static_cast<double>(r.y), z = static_cast<double>(r.z);
+        const double a = static_cast<double>(v[0]), b = static_cast<double>(v[1]), c = static_cast<double>(v[2]);
+        const double tx = 2 * (y * c - z * b), ty = 2 * (z * a - x * c), tz = 2 * (x * b - y * a);
+        const V expected{ P(a + w * tx + y * tz - z * ty), P(b + w * ty + z * tx - x * tz), P(c + w * tz + x * ty - y * tx) };
+        ExpectNear(expected, fpm::rotate(r, v), 3.0 / 65536);
+
+        // The matrix is the same rotation, and the conjugate rotates back. The elements of the quaternion are
+        // rounded, so the formulas differ by a few units in the last place times the length of v.
+        ExpectNear(fpm::rotate(r, v), r.to_matrix() * v, 0.01);
+        ExpectNear(v, fpm::rotate(fpm::conjugate(r), fpm::rotate(r, v)), 0.01);
+    }
+}
+
+TEST(quat, axis_angle)
+{
+    const V axis = fpm::normalize(V{ P(1), P(-2), P(2) });
+    const Q q = Q::from_axis_angle(axis, P(1.25));
+    ExpectNear(Q{ P(std::cos(0.625)), P(std::sin(0.625) / 3), P(-2 * std::sin(0.625) / 3), P(2 * std::sin(0.625) / 3) }, q, 2.0 / 65536);
+
+    const auto [a, angle] = q.to_axis_angle();
+    ExpectNear(axis, a, 4.0 / 65536);
+    EXPECT_NEAR(1.25, static_cast<double>(angle), 4.0 / 65536);
+
+    // Composing rotations around the same axis adds the angles
+    const Q twice = q * q;
+    EXPECT_NEAR(2.5, static_cast<double>(twice.to_axis_angle().second), 8.0 / 65536);
+
+    // Rotations of more than half a turn
+    const Q large = Q::from_axis_angle(axis, P(5));
+    EXPECT_NEAR(5, static_cast<double>(large.to_axis_angle().second), 8.0 / 65536);
+
+    EXPECT_EQ((std::pair<V, P>{ V{ P(1), P(0), P(0) }, P(0) }), Q::identity().to_axis_angle());
+}
+
+TEST(quat, matrix)
+{
+    const Q q = Q::from_axis_angle(V{ P(0), P(0), P(1) }, P::half_pi());
+    const fpm::mat3<P> m = q.to_matrix();
+    const fpm::mat3<P> expected{ P(0), P(-1), P(0),
+                                 P(1), P(0), P(0),
+                                 P(0), P(0), P(1) };
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        ExpectNear(expected[i], m[i], 2.0 / 65536);
+    }
+    EXPECT_EQ(fpm::mat3<P>::identity(), Q::identity().to_matrix());
+    EXPECT_EQ(Q::identity(), Q::from_matrix(fpm::mat3<P>::identity()));
+
+    // Every branch of from_matrix: rotations where each of w, x, y and z is the largest
+    std::mt19937 gen(1234);
+    for (int i = 0; i < 1000; ++i)
+    {
+        Q r = random_rotation(gen);
+        if (r.w < P(0))
+        {
+            r = -r;
+        }
+        Q back = Q::from_matrix(r.to_matrix());
+        if (back.w < P(0) || (back.w == P(0) && fpm::dot(back, r) < P(0)))
+        {
+            back = -back;
+        }
+        ExpectNear(r, back, 8.0 / 65536);
+    }
+    for (const auto& axis : { V{ P(1), P(0), P(0) }, V{ P(0), P(1), P(0) }, V{ P(0), P(0), P(1) } })
+    {
+        const Q half_turn = Q::from_axis_angle(axis, P::pi());
+        ExpectNear(half_turn, Q::from_matrix(half_turn.to_matrix()), 4.0 / 65536);
+    }
+
+    // A type with three integer bits besides the sign, which contains 4 but not 16
+    using P4 = fpm::fixed<std::int32_t, std::int64_t, 28>;
+    using Q4 = fpm::quat<P4>;
+    EXPECT_EQ(Q4::identity(), Q4::from_matrix(Q4::identity().to_matrix()));
+    for (int i = 0; i < 100; ++i)
+    {
+        const Q4 narrow = random_rotation<Q4>(gen);
+        Q4 back = Q4::from_matrix(narrow.to_matrix());
+        if (fpm::dot(back, narrow) < P4(0))
+        {
+            back = -back;
+        }
+        EXPECT_NEAR(static_cast<double>(narrow.w), static_cast<double>(back.w), 16.0 / (1 << 28));
+        EXPECT_NEAR(static_cast<double>(narrow.x), static_cast<double>(back.x), 16.0 / (1 << 28));
+        EXPECT_NEAR(static_cast<double>(narrow.y), static_cast<double>(back.y), 16.0 / (1 << 28));
+        EXPECT_NEAR(static_cast<double>(narrow.z), static_cast<double>(back.z), 16.0 / (1 << 28));
+    }
+}
+
+TEST(quat, interpolation)
+{
+    const V axis{ P(0), P(1), P(0) };
+    const Q a = Q::from_axis_angle(axis, P(0.25));
+    const Q b = Q::from_axis_angle(axis, P(2.25));
+
+    EXPECT_EQ(a, fpm::slerp(a, b, P(0)));
+    ExpectNear(b, fpm::slerp(a, b, P(1)), 2.0 / 65536);
+    for (double t = 0; t <= 1; t += 0.125)
+    {
+        // Constant speed along the arc
+        ExpectNear(Q::from_axis_angle(axis, P(0.25 + 2 * t)), fpm::slerp(a, b, P(t)), 4.0 / 65536);
+
+        // The same path, but not at a constant speed
+        const Q n = fpm::nlerp(a, b, P(t));
+        EXPECT_NEAR(1, static_cast<double>(fpm::length(n)), 2.0 / 65536);
+        EXPECT_EQ(P(0), n.x);
+        EXPECT_EQ(P(0), n.z);
+    }
+    ExpectNear(Q::from_axis_angle(axis, P(1.25)), fpm::nlerp(a, b, P(0.5)), 2.0 / 65536);
+
+    // Along the shorter arc
+    ExpectNear(fpm::slerp(a, b, P(0.25)), fpm::slerp(a, -b, P(0.25)), 1.0 / 65536);
+
+    // Nearly parallel quaternions
+    const Q c = Q::from_axis_angle(axis, P(0.26));
+    ExpectNear(Q::from_axis_angle(axis, P(0.2525)), fpm::slerp(a, c, P(0.25)), 2.0 / 65536);
+    EXPECT_EQ(a, fpm::slerp(a, a, P(0.5)));
+}
+
+TEST(quat, constexpr)
+{
+    constexpr Q i{ P(0), P(1), P(0), P(0) }, j{ P(0), P(0), P(1), P(0) };
+    static_assert(i * j == Q{ P(0), P(0), P(0), P(1) });
+    static_assert(fpm::rotate(Q::identity(), V{ P(1), P(2), P(3) }) == V{ P(1), P(2), P(3) });
+    static_assert(fpm::rotate(i, V{ P(1), P(2), P(3) }) == V{ P(1), P(-2), P(-3) });
+    static_assert(Q::from_matrix(i.to_matrix()) == i);
+    static_assert(fpm::normalize(Q{ P(2), P(0), P(0), P(0) }) == Q::identity());
+    static_assert(fpm::slerp(Q::identity(), i, P(0)).vector() == V{});
+    static_assert(Q::from_axis_angle(V{ P(1), P(0), P(0) }, P(0)).vector() == V{});
+    SUCCEED();
+}
+
+TEST(quat, batch)
+{
+    constexpr std::size_t n = 37;
+
+    std::mt19937 gen(1234);
+    std::uniform_int_distribution<std::int32_t> dist(-100 << 16, 100 << 16);
+    std::array<std::vector<P>, 3> x, out;
+    std::array<std::vector<P>, 4> q;
+    for (auto& v : q)
+    {
+        v.resize(n);
+    }
+    for (std::size_t k = 0; k < 3; ++k)
+    {
+        x[k].resize(n);
+        out[k].resize(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            x[k][i] = P::from_raw_value(dist(gen));
+        }
+    }
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const Q r = random_rotation(gen);
+        q[0][i] = r.w;
+        q[1][i] = r.x;
+        q[2][i] = r.y;
+        q[3][i] = r.z;
+    }
+    const auto vx = [&](std::size_t i) { return V{ x[0][i], x[1][i], x[2][i] }; };
+    const auto vout = [&](std::size_t i) { return V{ out[0][i], out[1][i], out[2][i] }; };
+
+    // One rotation for all vectors
+    const Q r = random_rotation(gen);
+    fpm::batch::rotate(r, { x[0], x[1], x[2] }, { out[0], out[1], out[2] });
+    for (std::size_t i = 0; i < n; ++i) EXPECT_EQ(fpm::rotate(r, vx(i)), vout(i));
+
+    // A rotation per vector
+    fpm::batch::rotate<P>({ q[0], q[1], q[2], q[3] }, { x[0], x[1], x[2] }, { out[0], out[1], out[2] });
+    for (std::size_t i = 0; i < n; ++i) EXPECT_EQ(fpm::rotate(Q{ q[0][i], q[1][i], q[2][i], q[3][i] }, vx(i)), vout(i));
+}
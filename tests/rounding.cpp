@@ -0,0 +1,261 @@
+#include "common.hpp"
+#include <fpm/ios.hpp>
+#include <fpm/saturating.hpp>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using fpm::rounding;
+
+// Rounds the exact quotient n / d, from the floor of the quotient
+static std::int64_t RoundedQuotient(std::int64_t n, std::int64_t d, rounding mode)
+{
+    if (d < 0) {
+        n = -n;
+        d = -d;
+    }
+    std::int64_t q = n / d, r = n % d;
+    if (r < 0) {
+        q -= 1;
+        r += d;
+    }
+    // Now n / d = q + r / d with 0 <= r < d
+    switch (mode) {
+    case rounding::toward_zero: return (q < 0 && r != 0) ? q + 1 : q;
+    case rounding::floor: return q;
+    case rounding::ceil: return (r != 0) ? q + 1 : q;
+    case rounding::half_up: return (2 * r >= d) ? q + 1 : q;
+    case rounding::half_away_from_zero: return (2 * r > d || (2 * r == d && q >= 0)) ? q + 1 : q;
+    case rounding::half_even: return (2 * r > d || (2 * r == d && (q & 1) != 0)) ? q + 1 : q;
+    case rounding::stochastic: break;
+    }
+    return q;
+}
+
+template <rounding Mode>
+static void ExpectRoundedArithmetic()
+{
+    using P = fpm::fixed<std::int32_t, std::int64_t, 4, Mode>;
+    for (std::int32_t x = -300; x <= 300; ++x)
+    {
+        for (std::int32_t y = -40; y <= 40; ++y)
+        {
+            const auto px = P::from_raw_value(x), py = P::from_raw_value(y);
+            EXPECT_EQ(RoundedQuotient(x * y, 16, Mode), (px * py).raw_value()) << x << " * " << y;
+            if (y != 0) {
+                EXPECT_EQ(RoundedQuotient(x * 16, y, Mode), (px / py).raw_value()) << x << " / " << y;
+            }
+            EXPECT_EQ(RoundedQuotient(x * y, 16, Mode), fpm::mul_sat(px, py).raw_value());
+        }
+        EXPECT_EQ(RoundedQuotient(x, 32, Mode), P::template from_fixed_point<9>(x).raw_value()) << x;
+        EXPECT_EQ(RoundedQuotient(x, 32, Mode), P(fpm::fixed<std::int32_t, std::int64_t, 9>::from_raw_value(x)).raw_value()) << x;
+        EXPECT_EQ(RoundedQuotient(x, 8, Mode), P(x / 128.0).raw_value()) << x;
+        EXPECT_EQ(RoundedQuotient(x, 8, Mode), P(x / 128.0f).raw_value()) << x;
+    }
+}
+
+TEST(rounding, arithmetic)
+{
+    ExpectRoundedArithmetic<rounding::toward_zero>();
+    ExpectRoundedArithmetic<rounding::half_away_from_zero>();
+    ExpectRoundedArithmetic<rounding::half_up>();
+    ExpectRoundedArithmetic<rounding::half_even>();
+    ExpectRoundedArithmetic<rounding::floor>();
+    ExpectRoundedArithmetic<rounding::ceil>();
+}
+
+TEST(rounding, ties)
+{
+    // Using 1 bit of fractional precision to test rounding
+    using Even = fpm::fixed<std::int32_t, std::int64_t, 1, rounding::half_even>;
+    using Up = fpm::fixed<std::int32_t, std::int64_t, 1, rounding::half_up>;
+    using Floor = fpm::fixed<std::int32_t, std::int64_t, 1, rounding::floor>;
+
+    EXPECT_EQ(Even(0.0), Even(0.5) * Even(0.5));
+    EXPECT_EQ(Even(1.0), Even(1.5) * Even(0.5));
+    EXPECT_EQ(Even(-1.0), Even(-1.5) * Even(0.5));
+    EXPECT_EQ(Even(2.5), Even(3.5) / Even(1.5));
+    EXPECT_EQ(Even(1.0), Even(1.5) / Even(2.0));
+    EXPECT_EQ(Even(1.0), Even(2.5) / Even(2.0));
+    EXPECT_EQ(Even(1.0), Even(0.75));
+    EXPECT_EQ(Even(-1.0), Even(-0.75));
+    EXPECT_EQ(Even(0.0), Even(0.25));
+
+    EXPECT_EQ(Up(0.5), Up(0.5) * Up(0.5));
+    EXPECT_EQ(Up(0.0), Up(-0.5) * Up(0.5));
+    EXPECT_EQ(Up(-0.5), Up(-0.75));
+
+    EXPECT_EQ(Floor(-0.5), Floor(-0.5) * Floor(0.5));
+    EXPECT_EQ(Floor(0.5), Floor(1.5) * Floor(0.5));
+    EXPECT_EQ(Floor(-1.5), Floor(-1.4));
+
+    using Ceil = fpm::fixed<std::int32_t, std::int64_t, 1, rounding::ceil>;
+    EXPECT_EQ(Ceil(0.5), Ceil(0.5) * Ceil(0.5));
+    EXPECT_EQ(Ceil(0.0), Ceil(-0.5) * Ceil(0.5));
+    EXPECT_EQ(Ceil(1.0), Ceil(1.0) / Ceil(1.5));
+    EXPECT_EQ(Ceil(-1.0), Ceil(-1.4));
+    EXPECT_EQ(Ceil(1.5), Ceil(1.1));
+}
+
+TEST(rounding, stochastic)
+{
+    using P = fpm::fixed<std::int32_t, std::int64_t, 4, rounding::stochastic>;
+    constexpr int N = 16000;
+
+    // Every result is one of the two nearest values, and their average is the exact result
+    const auto expect_unbiased = [](std::int64_t n, std::int64_t d, auto round) {
+        const auto low = RoundedQuotient(n, d, rounding::floor), high = RoundedQuotient(n, d, rounding::ceil);
+        std::int64_t sum = 0;
+        for (int i = 0; i < N; ++i)
+        {
+            // Not const, which would evaluate a constant initializer at compile time
+            std::int64_t value = round();
+            ASSERT_TRUE(value == low || value == high) << n << " / " << d;
+            sum += value;
+        }
+        EXPECT_NEAR(static_cast<double>(n) / d, static_cast<double>(sum) / N, 0.02) << n << " / " << d;
+    };
+    expect_unbiased(3, 16, [] { return (P::from_raw_value(3) * P::from_raw_value(1)).raw_value(); });
+    expect_unbiased(-3 * 7, 16, [] { return (P::from_raw_value(-3) * P::from_raw_value(7)).raw_value(); });
+    expect_unbiased(5 * 16, 3, [] { return (P::from_raw_value(5) / P::from_raw_value(3)).raw_value(); });
+    expect_unbiased(-5 * 16, 3, [] { return (P::from_raw_value(-5) / P::from_raw_value(3)).raw_value(); });
+    expect_unbiased(-13, 32, [] { return P::from_fixed_point<9>(-13).raw_value(); });
+    expect_unbiased(7, 10, [] { return P(0.7 / 16).raw_value(); });
+    expect_unbiased(-7, 10, [] { return P(-0.7f / 16).raw_value(); });
+
+    // Exact results are not changed
+    for (int i = 0; i < 100; ++i)
+    {
+        EXPECT_EQ(P(1.5), P(3) * P(0.5));
+        EXPECT_EQ(P(-1.25), P(5) / P(-4));
+        EXPECT_EQ(P(0.0625), P(0.0625));
+    }
+}
+
+TEST(rounding, same_as_bool)
+{
+    using Round = fpm::fixed<std::int32_t, std::int64_t, 16, true>;
+    using Truncate = fpm::fixed<std::int32_t, std::int64_t, 16, false>;
+    using HalfAway = fpm::fixed<std::int32_t, std::int64_t, 16, rounding::half_away_from_zero>;
+    using TowardZero = fpm::fixed<std::int32_t, std::int64_t, 16, rounding::toward_zero>;
+    static_assert(Round::rounding_mode == rounding::half_away_from_zero);
+    static_assert(Truncate::rounding_mode == rounding::toward_zero);
+
+    std::mt19937 gen(1234);
+    std::uniform_int_distribution<std::int32_t> dist(-1 << 24, 1 << 24);
+    for (int i = 0; i < 10000; ++i)
+    {
+        const std::int32_t x = dist(gen), y = dist(gen) | 1;
+        EXPECT_EQ((Round::from_raw_value(x) * Round::from_raw_value(y)).raw_value(), (HalfAway::from_raw_value(x) * HalfAway::from_raw_value(y)).raw_value());
+        EXPECT_EQ((Round::from_raw_value(x) / Round::from_raw_value(y)).raw_value(), (HalfAway::from_raw_value(x) / HalfAway::from_raw_value(y)).raw_value());
+        EXPECT_EQ((Truncate::from_raw_value(x) * Truncate::from_raw_value(y)).raw_value(), (TowardZero::from_raw_value(x) * TowardZero::from_raw_value(y)).raw_value());
+        EXPECT_EQ((Truncate::from_raw_value(x) / Truncate::from_raw_value(y)).raw_value(), (TowardZero::from_raw_value(x) / TowardZero::from_raw_value(y)).raw_value());
+    }
+}
+
+#if defined(FPM_INT128)
+TEST(rounding, wide)
+{
+    // 64-bit types divide with a different algorithm
+    using Even = fpm::fixed<std::int64_t, fpm::int128_t, 1, rounding::half_even>;
+    using Floor = fpm::fixed<std::int64_t, fpm::int128_t, 1, rounding::floor>;
+    EXPECT_EQ(Even(1.0), Even(2.5) / Even(2.0));
+    EXPECT_EQ(Even(-2.0), Even(3.5) / Even(-2.0));
+    EXPECT_EQ(Even(0.5), Even(1.0) / Even(1.5));
+    EXPECT_EQ(Floor(-1.0), Floor(1.0) / Floor(-1.5));
+    EXPECT_EQ(Floor(0.5), Floor(1.0) / Floor(1.5));
+
+    // The same results as the generic 128-bit division
+    using Q = fpm::fixed<std::int64_t, fpm::int128_t, 32, rounding::half_even>;
+    std::mt19937_64 gen(4321);
+    for (int i = 0; i < 10000; ++i)
+    {
+        const auto x = static_cast<std::int64_t>(gen()) >> (gen() % 64), y = (static_cast<std::int64_t>(gen()) >> (gen() % 64)) | 1;
+        const auto expected = fpm::detail::divide<rounding::half_even>(fpm::int128_t{x} << 32, fpm::int128_t{y});
+        EXPECT_EQ(static_cast<std::int64_t>(expected), (Q::from_raw_value(x) / Q::from_raw_value(y)).raw_value()) << x << " / " << y;
+
+        using S = fpm::fixed<std::int64_t, fpm::int128_t, 32, rounding::stochastic>;
+        const auto low = fpm::detail::divide<rounding::floor>(fpm::int128_t{x} << 32, fpm::int128_t{y});
+        const auto high = fpm::detail::divide<rounding::ceil>(fpm::int128_t{x} << 32, fpm::int128_t{y});
+        const auto value = (S::from_raw_value(x) / S::from_raw_value(y)).raw_value();
+        EXPECT_TRUE(value == static_cast<std::int64_t>(low) || value == static_cast<std::int64_t>(high)) << x << " / " << y;
+    }
+}
+#endif
+
+TEST(rounding, stochastic_seed)
+{
+    using P = fpm::fixed<std::int32_t, std::int64_t, 16, rounding::stochastic>;
+    const auto draw = [] {
+        std::vector<std::int32_t> values;
+        for (int i = 0; i < 100; ++i)
+        {
+            values.push_back((P::from_raw_value(i * 1234567) * P::from_raw_value(-i * 7654321)).raw_value());
+            values.push_back((P::from_raw_value(i * 1234567) / P::from_raw_value(7654321)).raw_value());
+            values.push_back(P(i / 3.0).raw_value());
+        }
+        return values;
+    };
+
+    // The same seed gives the same results, on any thread
+    fpm::seed_stochastic_rounding(1);
+    const auto first = draw();
+    fpm::seed_stochastic_rounding(1);
+    EXPECT_EQ(first, draw());
+    fpm::seed_stochastic_rounding(2);
+    EXPECT_NE(first, draw());
+    fpm::seed_stochastic_rounding(std::uint64_t{1} << 32);
+    EXPECT_NE(first, draw());
+    std::vector<std::int32_t> other;
+    std::thread([&] { fpm::seed_stochastic_rounding(1); other = draw(); }).join();
+    EXPECT_EQ(first, other);
+
+    // Seeding another thread doesn't affect this one
+    fpm::seed_stochastic_rounding(1);
+    std::thread([&] { fpm::seed_stochastic_rounding(5); other = draw(); }).join();
+    EXPECT_EQ(first, draw());
+}
+
+TEST(rounding, from_chars)
+{
+    using Even = fpm::fixed<std::int32_t, std::int64_t, 1, rounding::half_even>;
+    using Floor = fpm::fixed<std::int32_t, std::int64_t, 1, rounding::floor>;
+    const auto parse = [](auto& value, const std::string& text, std::chars_format fmt = std::chars_format::general) {
+        return std::from_chars(text.data(), text.data() + text.size(), value, fmt).ec == std::errc{};
+    };
+
+    Even even;
+    EXPECT_TRUE(parse(even, "0.75"));
+    EXPECT_EQ(Even(1.0), even);
+    EXPECT_TRUE(parse(even, "0.25"));
+    EXPECT_EQ(Even(0.0), even);
+    EXPECT_TRUE(parse(even, "0.2500001"));
+    EXPECT_EQ(Even(0.5), even);
+    EXPECT_TRUE(parse(even, "-1.25"));
+    EXPECT_EQ(Even(-1.0), even);
+    EXPECT_TRUE(parse(even, "0.c", std::chars_format::hex));
+    EXPECT_EQ(Even(1.0), even);
+
+    Floor floor;
+    EXPECT_TRUE(parse(floor, "-0.0001"));
+    EXPECT_EQ(Floor(-0.5), floor);
+    EXPECT_TRUE(parse(floor, "0.9999"));
+    EXPECT_EQ(Floor(0.5), floor);
+}
+
+TEST(rounding, constexpr)
+{
+    using Even = fpm::fixed<std::int32_t, std::int64_t, 1, rounding::half_even>;
+    static_assert(Even(1.5) * Even(0.5) == Even(1.0), "half_even multiplication failed");
+    static_assert(Even(0.25) == Even(0.0), "half_even conversion failed");
+    static_assert(fpm::detail::shift_right<rounding::half_even>(-6, 2) == -2, "half_even shift failed");
+    static_assert(fpm::detail::shift_right<rounding::floor>(-5, 2) == -2, "floor shift failed");
+    static_assert(fpm::detail::shift_right<rounding::toward_zero>(-5, 2) == -1, "toward_zero shift failed");
+    static_assert(fpm::detail::shift_right<rounding::ceil>(-7, 2) == -1, "ceil shift failed");
+
+    // Stochastic rounding is deterministic in constant expressions, to nearest with ties to even
+    using Stochastic = fpm::fixed<std::int32_t, std::int64_t, 1, rounding::stochastic>;
+    static_assert(Stochastic(1.5) * Stochastic(0.5) == Stochastic(1.0), "stochastic multiplication failed");
+    static_assert(Stochastic(0.75) == Stochastic(1.0), "stochastic conversion failed");
+}
@@ -0,0 +1,186 @@
+#include "common.hpp"
+#include <fpm/saturating.hpp>
+
+TEST(saturating, add_sub)
+{
+    using P = fpm::fixed_16_16;
+    const P max = std::numeric_limits<P>::max(), min = std::numeric_limits<P>::lowest();
+
+    EXPECT_EQ(P(10.75), fpm::add_sat(P(3.5), P(7.25)));
+    EXPECT_EQ(P(-3.75), fpm::sub_sat(P(3.5), P(7.25)));
+
+    EXPECT_EQ(max, fpm::add_sat(max, P(1)));
+    EXPECT_EQ(max, fpm::add_sat(P(20000), P(20000)));
+    EXPECT_EQ(min, fpm::add_sat(min, P(-1)));
+    EXPECT_EQ(min, fpm::add_sat(P(-20000), P(-20000)));
+    EXPECT_EQ(P::from_raw_value(-1), fpm::add_sat(max, min));
+
+    EXPECT_EQ(max, fpm::sub_sat(P(20000), P(-20000)));
+    EXPECT_EQ(min, fpm::sub_sat(P(-20000), P(20000)));
+    EXPECT_EQ(max, fpm::sub_sat(P(0), min));
+    EXPECT_EQ(P(0), fpm::sub_sat(min, min));
+
+    // Unsigned types saturate at zero
+    using U = fpm::fixed<std::uint16_t, std::uint32_t, 8>;
+    EXPECT_EQ(U(0), fpm::sub_sat(U(3), U(4)));
+    EXPECT_EQ(std::numeric_limits<U>::max(), fpm::add_sat(U(200), U(100)));
+}
+
+TEST(saturating, mul_div)
+{
+    using P = fpm::fixed_16_16;
+    const P max = std::numeric_limits<P>::max(), min = std::numeric_limits<P>::lowest();
+
+    // Results that fit are the same as the wrapping operators
+    for (int i = -100; i <= 100; ++i)
+    {
+        const P x = P(i) / 7, y = P(i * 3 + 1) / 13;
+        EXPECT_EQ(x * y, fpm::mul_sat(x, y));
+        EXPECT_EQ(x / y, fpm::div_sat(x, y));
+    }
+
+    EXPECT_EQ(max, fpm::mul_sat(P(300), P(300)));
+    EXPECT_EQ(min, fpm::mul_sat(P(-300), P(300)));
+    EXPECT_EQ(max, fpm::mul_sat(min, P(-1)));
+    EXPECT_EQ(max, fpm::div_sat(P(30000), P(0.5)));
+    EXPECT_EQ(min, fpm::div_sat(P(30000), P(-0.001)));
+    EXPECT_EQ(max, fpm::div_sat(min, P(-1)));
+
+    // Integers
+    EXPECT_EQ(P(-21), fpm::mul_sat(P(3), -7));
+    EXPECT_EQ(max, fpm::mul_sat(P(3), 20000));
+    EXPECT_EQ(min, fpm::mul_sat(P(-3), 20000));
+    EXPECT_EQ(min, fpm::mul_sat(P::from_raw_value(-1), std::numeric_limits<std::int64_t>::max()));
+    EXPECT_EQ(max, fpm::mul_sat(P::from_raw_value(-1), std::numeric_limits<std::int64_t>::lowest()));
+    EXPECT_EQ(P(0), fpm::mul_sat(P(0), std::numeric_limits<std::int64_t>::max()));
+    EXPECT_EQ(P(-1.5), fpm::div_sat(P(3), -2));
+    EXPECT_EQ(max, fpm::div_sat(min, -1));
+    EXPECT_EQ(P(10.5) + 20000, fpm::add_sat(P(10.5), 20000));
+    EXPECT_EQ(P(10.5) - 20000, fpm::sub_sat(P(10.5), 20000));
+    EXPECT_EQ(20000 - P(10.5), fpm::sub_sat(20000, P(10.5)));
+    EXPECT_EQ(max, fpm::add_sat(P(20000), 20000));
+    EXPECT_EQ(max, fpm::add_sat(20000, P(20000)));
+    EXPECT_EQ(min, fpm::sub_sat(P(-20000), 20000));
+    EXPECT_EQ(max, fpm::sub_sat(20000, P(-20000)));
+    EXPECT_EQ(min, fpm::sub_sat(-20000, P(20000)));
+    EXPECT_EQ(max, fpm::sub_sat(P(0), std::numeric_limits<std::int64_t>::lowest()));
+    EXPECT_EQ(min, fpm::add_sat(max, std::numeric_limits<std::int64_t>::lowest()));
+    // The sum fits, even though the integer doesn't
+    EXPECT_EQ(P(10000), fpm::add_sat(P(-30000), 40000));
+    EXPECT_EQ(P(-10000), fpm::sub_sat(P(30000), 40000));
+    EXPECT_EQ(P(10000), fpm::sub_sat(40000, P(30000)));
+
+    // Unsigned types saturate at zero
+    using U = fpm::fixed<std::uint16_t, std::uint32_t, 8>;
+    EXPECT_EQ(U(3), fpm::add_sat(U(200), -197));
+    EXPECT_EQ(U(0), fpm::add_sat(U(200), -201));
+    EXPECT_EQ(U(0), fpm::sub_sat(U(3), 4));
+    EXPECT_EQ(U(0), fpm::sub_sat(4, U(5)));
+    EXPECT_EQ(U(1), fpm::sub_sat(4, U(3)));
+    EXPECT_EQ(std::numeric_limits<U>::max(), fpm::add_sat(U(200), 100));
+    EXPECT_EQ(std::numeric_limits<U>::max(), fpm::sub_sat(U(200), -1000000));
+    EXPECT_EQ(U(100), fpm::sub_sat(U(200), 100u));
+
+    // 64-bit types
+    using Q = fpm::fixed_32_32;
+    EXPECT_EQ(std::numeric_limits<Q>::max(), fpm::mul_sat(Q(100000), Q(100000)));
+    EXPECT_EQ(Q(1000000), fpm::mul_sat(Q(1000), Q(1000)));
+    EXPECT_EQ(std::numeric_limits<Q>::max(), fpm::add_sat(Q(1), std::numeric_limits<std::int64_t>::max()));
+    EXPECT_EQ(Q(-1), fpm::sub_sat(Q(1), 2));
+}
+
+TEST(saturating, shift)
+{
+    using P = fpm::fixed_16_16;
+    const P max = std::numeric_limits<P>::max(), min = std::numeric_limits<P>::lowest();
+
+    EXPECT_EQ(P(12), fpm::shl_sat(P(3), 2));
+    EXPECT_EQ(P(-12), fpm::shl_sat(P(-3), 2));
+    EXPECT_EQ(max, fpm::shl_sat(P(3), 14));
+    EXPECT_EQ(min, fpm::shl_sat(P(-3), 14));
+    EXPECT_EQ(min, fpm::shl_sat(P(-16384), 1));
+    EXPECT_EQ(max, fpm::shl_sat(P(16384), 1));
+}
+
+TEST(saturating, conversion)
+{
+    using P = fpm::fixed_16_16;
+    const P max = std::numeric_limits<P>::max(), min = std::numeric_limits<P>::lowest();
+
+    EXPECT_EQ(P(1234), fpm::saturate_cast<P>(1234));
+    EXPECT_EQ(P(-32768), fpm::saturate_cast<P>(-32768));
+    EXPECT_EQ(max, fpm::saturate_cast<P>(32768));
+    EXPECT_EQ(min, fpm::saturate_cast<P>(-32769));
+    EXPECT_EQ(max, fpm::saturate_cast<P>(std::numeric_limits<std::uint64_t>::max()));
+    EXPECT_EQ(min, fpm::saturate_cast<P>(std::numeric_limits<std::int64_t>::lowest()));
+
+    EXPECT_EQ(P(12.25), fpm::saturate_cast<P>(12.25));
+    EXPECT_EQ(P(-12.25), fpm::saturate_cast<P>(-12.25f));
+    EXPECT_EQ(max, fpm::saturate_cast<P>(32768.0));
+    EXPECT_EQ(max, fpm::saturate_cast<P>(1e30f));
+    EXPECT_EQ(min, fpm::saturate_cast<P>(-1e30));
+    EXPECT_EQ(min, fpm::saturate_cast<P>(-32768.0));
+    EXPECT_EQ(max, fpm::saturate_cast<P>(std::numeric_limits<double>::infinity()));
+    EXPECT_EQ(P(0), fpm::saturate_cast<P>(std::numeric_limits<double>::quiet_NaN()));
+
+    // Between fixed-point types
+    using Q = fpm::fixed_8_24;
+    EXPECT_EQ(Q(3.25), fpm::saturate_cast<Q>(P(3.25)));
+    EXPECT_EQ(std::numeric_limits<Q>::max(), fpm::saturate_cast<Q>(P(200)));
+    EXPECT_EQ(std::numeric_limits<Q>::lowest(), fpm::saturate_cast<Q>(P(-200)));
+    EXPECT_EQ(P(Q(-3.1)), fpm::saturate_cast<P>(Q(-3.1)));
+    EXPECT_EQ(std::numeric_limits<fpm::fixed_8_8>::max(), fpm::saturate_cast<fpm::fixed_8_8>(fpm::fixed_32_32(1000)));
+    EXPECT_EQ(fpm::fixed_32_32(-100), fpm::saturate_cast<fpm::fixed_32_32>(fpm::fixed_8_8(-100)));
+}
+
+TEST(saturating, wrapper)
+{
+    using P = fpm::fixed_16_16;
+    using S = fpm::saturating<P>;
+    const S max = std::numeric_limits<S>::max(), min = std::numeric_limits<S>::lowest();
+
+    EXPECT_EQ(S(10.75), S(3.5) + S(7.25));
+    EXPECT_EQ(P(10.75), (S(3.5) + P(7.25)).value());
+    EXPECT_EQ(max, S(20000) + S(20000));
+    EXPECT_EQ(min, S(-20000) - S(20000));
+    EXPECT_EQ(max, S(300) * S(300));
+    EXPECT_EQ(min, S(30000) / S(-0.5));
+    EXPECT_EQ(max, S(3) * 20000);
+    EXPECT_EQ(min, -20000 * S(3));
+    EXPECT_EQ(S(1.5), S(3) / 2);
+    EXPECT_EQ(S(4.5), S(3.5) + 1);
+    EXPECT_EQ(S(4.5), 1 + S(3.5));
+    EXPECT_EQ(S(2.5), S(3.5) - 1);
+    EXPECT_EQ(S(-2.5), 1 - S(3.5));
+    EXPECT_EQ(max, S(20000) + 20000);
+    EXPECT_EQ(min, -20000 - S(20000));
+    EXPECT_EQ(max, S(3) << 14);
+    EXPECT_EQ(S(0.75), S(3) >> 2);
+    EXPECT_EQ(max, -min);
+    EXPECT_EQ(max, S(1e9));
+    EXPECT_EQ(min, S(fpm::fixed_32_32(-1e9)));
+
+    S s(1);
+    for (int i = 0; i < 20; ++i)
+    {
+        s *= S(10);
+    }
+    EXPECT_EQ(max, s);
+    s -= S(30000);
+    EXPECT_LT(S(2767), s);
+    EXPECT_GT(S(2768), s);
+
+    EXPECT_FALSE(std::numeric_limits<S>::is_modulo);
+    EXPECT_EQ(3.5, static_cast<double>(S(3.5)));
+    EXPECT_EQ(3, static_cast<int>(S(3.5)));
+}
+
+TEST(saturating, constexpr)
+{
+    using P = fpm::fixed_16_16;
+    static_assert(fpm::add_sat(std::numeric_limits<P>::max(), P(1)) == std::numeric_limits<P>::max(), "add_sat failed");
+    static_assert(fpm::mul_sat(P(300), P(-300)) == std::numeric_limits<P>::lowest(), "mul_sat failed");
+    static_assert(fpm::saturate_cast<P>(1e10) == std::numeric_limits<P>::max(), "saturate_cast failed");
+    static_assert(fpm::saturating<P>(2) * 3 == fpm::saturating<P>(6), "saturating failed");
+    static_assert(fpm::add_sat(std::numeric_limits<P>::max(), 1) == std::numeric_limits<P>::max(), "add_sat failed");
+}
@@ -0,0 +1,541 @@
+#include "common.hpp"
+#include <fpm/simd.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+// Lengths that exercise both full registers of every width and the scalar remainder
+constexpr std::size_t LENGTH = 16 * 7 + 5;
+
+template <typename T>
+std::vector<T> random_values(std::mt19937& gen)
+{
+    using B = typename T::base_type;
+    std::uniform_int_distribution<B> full(std::numeric_limits<B>::min(), std::numeric_limits<B>::max());
+    const auto limit = static_cast<B>(std::min<typename T::intermediate_type>(T::FRACTION_MULT * 4, std::numeric_limits<B>::max()));
+    std::uniform_int_distribution<B> small(-limit, limit);
+
+    std::vector<T> values(LENGTH);
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+        values[i] = T::from_raw_value((i % 2 == 0) ? full(gen) : small(gen));
+    }
+
+    // Values around the rounding boundaries and the edges of the range
+    values[0] = T::from_raw_value(std::numeric_limits<B>::min());
+    values[1] = T::from_raw_value(std::numeric_limits<B>::max());
+    values[2] = T::from_raw_value(0);
+    values[3] = T::from_raw_value(-1);
+    values[4] = T::from_raw_value(1);
+    values[5] = T{-0.5};
+    values[6] = T{0.5};
+    values[7] = T{-1.5};
+    return values;
+}
+
+// Random values in [-bound, bound], including both ends. The scalar operators have no defined result when a
+// sum or difference overflows, so the operands of additions are limited to these.
+template <typename T>
+std::vector<T> bounded_values(std::mt19937& gen, typename T::base_type bound)
+{
+    using B = typename T::base_type;
+    std::uniform_int_distribution<B> dist(-bound, bound);
+
+    std::vector<T> values(LENGTH);
+    for (auto& value : values)
+    {
+        value = T::from_raw_value(dist(gen));
+    }
+    values[0] = T::from_raw_value(-bound);
+    values[1] = T::from_raw_value(bound);
+    values[2] = T::from_raw_value(0);
+    values[3] = T::from_raw_value(-1);
+    values[4] = T::from_raw_value(1);
+    return values;
+}
+
+// The bound of factors whose product is at most a quarter of the range, so that adding another quarter fits
+template <typename T>
+typename T::base_type product_bound()
+{
+    using B = typename T::base_type;
+    const double bound = std::sqrt(static_cast<double>(std::numeric_limits<B>::max() / 4) * static_cast<double>(T::FRACTION_MULT));
+    return static_cast<B>(std::min(bound, static_cast<double>(std::numeric_limits<B>::max())));
+}
+
+// Compares every bulk kernel against the scalar operators, for every supported instruction set
+template <typename T>
+void ExpectMatchesScalar()
+{
+    using B = typename T::base_type;
+    std::mt19937 gen(12345);
+    const auto x = random_values<T>(gen);
+    auto y_values = random_values<T>(gen);
+    std::shuffle(y_values.begin(), y_values.end(), gen);
+    const auto& y = y_values;
+
+    // Products narrow from the intermediate type, so they're defined over the full range, but sums aren't
+    const auto sum_x = bounded_values<T>(gen, std::numeric_limits<B>::max() / 2);
+    const auto sum_y = bounded_values<T>(gen, std::numeric_limits<B>::max() / 2);
+    const auto fma_x = bounded_values<T>(gen, product_bound<T>());
+    const auto fma_y = bounded_values<T>(gen, product_bound<T>());
+    const auto fma_z = bounded_values<T>(gen, std::numeric_limits<B>::max() / 4);
+
+    std::vector<T> divisors = y;
+    for (auto& d : divisors)
+    {
+        if (d.raw_value() == 0)
+        {
+            d = T::from_raw_value(1);
+        }
+    }
+
+    using fpm::simd::detail::op;
+    using fpm::simd::detail::apply;
+    const fpm::simd::isa isas[] = { fpm::simd::isa::scalar, fpm::simd::isa::sse4_1, fpm::simd::isa::avx2, fpm::simd::isa::avx512 };
+    for (const auto target : isas)
+    {
+        if (target > fpm::simd::active_isa())
+        {
+            continue;
+        }
+        SCOPED_TRACE(static_cast<int>(target));
+
+        std::vector<T> out(LENGTH);
+        apply<op::add>(target, sum_x.data(), sum_y.data(), nullptr, out.data(), LENGTH);
+        for (std::size_t i = 0; i < LENGTH; ++i) EXPECT_EQ(sum_x[i] + sum_y[i], out[i]) << i;
+
+        apply<op::sub>(target, sum_x.data(), sum_y.data(), nullptr, out.data(), LENGTH);
+        for (std::size_t i = 0; i < LENGTH; ++i) EXPECT_EQ(sum_x[i] - sum_y[i], out[i]) << i;
+
+        apply<op::mul>(target, x.data(), y.data(), nullptr, out.data(), LENGTH);
+        for (std::size_t i = 0; i < LENGTH; ++i) EXPECT_EQ(x[i] * y[i], out[i]) << i;
+
+        apply<op::div>(target, x.data(), divisors.data(), nullptr, out.data(), LENGTH);
+        for (std::size_t i = 0; i < LENGTH; ++i) EXPECT_EQ(x[i] / divisors[i], out[i]) << i;
+
+        apply<op::fma>(target, fma_x.data(), fma_y.data(), fma_z.data(), out.data(), LENGTH);
+        for (std::size_t i = 0; i < LENGTH; ++i) EXPECT_EQ(fma_x[i] * fma_y[i] + fma_z[i], out[i]) << i;
+
+        for (std::size_t j = 0; j < 8; ++j)
+        {
+            apply<op::scale>(target, x.data(), &y[j], nullptr, out.data(), LENGTH);
+            for (std::size_t i = 0; i < LENGTH; ++i) EXPECT_EQ(x[i] * y[j], out[i]) << i;
+        }
+    }
+}
+
+// Compares the bulk products with stochastic rounding against the scalar operators, which draw the
+// same random numbers from the same seed
+template <typename T>
+void ExpectStochasticMatchesScalar(std::uint32_t counter)
+{
+    using B = typename T::base_type;
+    std::mt19937 gen(12345);
+    const auto x = random_values<T>(gen);
+    const auto y = random_values<T>(gen);
+    const auto fma_x = bounded_values<T>(gen, product_bound<T>());
+    const auto fma_y = bounded_values<T>(gen, product_bound<T>());
+    const auto fma_z = bounded_values<T>(gen, std::numeric_limits<B>::max() / 4);
+
+    using fpm::simd::detail::op;
+    using fpm::simd::detail::apply;
+    const auto reseed = [counter] {
+        fpm::seed_stochastic_rounding(42);
+        fpm::detail::stochastic_state().counter = counter;
+    };
+    const fpm::simd::isa isas[] = { fpm::simd::isa::scalar, fpm::simd::isa::sse4_1, fpm::simd::isa::avx2, fpm::simd::isa::avx512 };
+    for (const auto target : isas)
+    {
+        if (target > fpm::simd::active_isa())
+        {
+            continue;
+        }
+        SCOPED_TRACE(static_cast<int>(target));
+
+        std::vector<T> out(LENGTH), expected(LENGTH);
+        reseed();
+        apply<op::mul>(target, x.data(), y.data(), nullptr, out.data(), LENGTH);
+        reseed();
+        for (std::size_t i = 0; i < LENGTH; ++i) expected[i] = x[i] * y[i];
+        EXPECT_EQ(expected, out);
+
+        reseed();
+        apply<op::fma>(target, fma_x.data(), fma_y.data(), fma_z.data(), out.data(), LENGTH);
+        reseed();
+        for (std::size_t i = 0; i < LENGTH; ++i) expected[i] = fma_x[i] * fma_y[i] + fma_z[i];
+        EXPECT_EQ(expected, out);
+
+        reseed();
+        apply<op::scale>(target, x.data(), &y[9], nullptr, out.data(), LENGTH);
+        apply<op::scale>(target, x.data(), &y[10], nullptr, out.data(), LENGTH);
+        reseed();
+        for (std::size_t i = 0; i < LENGTH; ++i) expected[i] = x[i] * y[9];
+        for (std::size_t i = 0; i < LENGTH; ++i) expected[i] = x[i] * y[10];
+        EXPECT_EQ(expected, out);
+    }
+}
+
+}
+
+TEST(simd, stochastic)
+{
+    ExpectStochasticMatchesScalar<fpm::fixed<std::int32_t, std::int64_t, 16, fpm::rounding::stochastic>>(0);
+    ExpectStochasticMatchesScalar<fpm::fixed<std::int32_t, std::int64_t, 8, fpm::rounding::stochastic>>(0);
+    ExpectStochasticMatchesScalar<fpm::fixed<std::int32_t, std::int64_t, 31, fpm::rounding::stochastic>>(0);
+
+    // The counter wraps around in the middle of the elements
+    ExpectStochasticMatchesScalar<fpm::fixed<std::int32_t, std::int64_t, 16, fpm::rounding::stochastic>>(0xFFFFFFFFu - 50);
+}
+
+namespace
+{
+
+// Compares the reductions against the scalar loop over fpm::accumulator, for every supported instruction set
+template <typename T>
+void ExpectReductionsMatchScalar()
+{
+    using B = typename T::base_type;
+    std::mt19937 gen(12345);
+    const auto x = random_values<T>(gen);
+    // Small enough for the sum of the products to fit in the intermediate type
+    const auto limit = static_cast<B>(std::min<std::int64_t>(1 << 20, std::numeric_limits<B>::max() >> 7));
+    std::uniform_int_distribution<B> dist(-limit, limit);
+    std::vector<T> y(LENGTH);
+    for (auto& v : y)
+    {
+        v = T::from_raw_value(dist(gen));
+    }
+
+    fpm::accumulator<T> dot, sum, sum_y;
+    for (std::size_t i = 0; i < LENGTH; ++i)
+    {
+        dot.fma(x[i], y[i]);
+        sum += x[i];
+        sum_y += y[i];
+    }
+
+    const fpm::simd::isa isas[] = { fpm::simd::isa::scalar, fpm::simd::isa::sse4_1, fpm::simd::isa::avx2, fpm::simd::isa::avx512 };
+    for (const auto target : isas)
+    {
+        if (target > fpm::simd::active_isa())
+        {
+            continue;
+        }
+        SCOPED_TRACE(static_cast<int>(target));
+
+        fpm::accumulator<T> acc;
+        fpm::simd::detail::apply_dot(target, x.data(), y.data(), LENGTH, acc);
+        EXPECT_EQ(dot.raw_value(), acc.raw_value());
+
+        // Accumulating continues from the given sum
+        fpm::simd::detail::apply_dot(target, x.data(), y.data(), 5, acc);
+        fpm::simd::detail::apply_dot(target, x.data() + 5, y.data() + 5, LENGTH - 5, acc);
+        EXPECT_EQ(dot.raw_value() * 2, acc.raw_value());
+
+        acc = fpm::accumulator<T>();
+        fpm::simd::detail::apply_sum(target, x.data(), LENGTH, acc);
+        EXPECT_EQ(sum.raw_value(), acc.raw_value());
+        fpm::simd::detail::apply_sum(target, y.data(), LENGTH, acc);
+        EXPECT_EQ((sum + sum_y).raw_value(), acc.raw_value());
+    }
+}
+
+}
+
+TEST(simd, reductions)
+{
+    ExpectReductionsMatchScalar<fpm::fixed_16_16>();
+    ExpectReductionsMatchScalar<fpm::fixed_24_8>();
+    ExpectReductionsMatchScalar<fpm::fixed_8_24>();
+    ExpectReductionsMatchScalar<fpm::fixed<std::int32_t, std::int64_t, 16, fpm::rounding::half_even>>();
+    ExpectReductionsMatchScalar<fpm::fixed_8_8>();
+}
+
+TEST(simd, dot_sum)
+{
+    using P = fpm::fixed_16_16;
+    const std::vector<P> x{ P{1.5}, P{-2.25}, P{3}, P{0.125}, P{-7}, P{100}, P{-0.5}, P{2}, P{9.75} };
+    const std::vector<P> y{ P{2}, P{4}, P{-0.5}, P{8}, P{-1}, P{0.01}, P{3}, P{-6}, P{0.5} };
+    double exact = 0;
+    for (std::size_t i = 0; i < x.size(); ++i) exact += static_cast<double>(x[i]) * static_cast<double>(y[i]);
+    EXPECT_EQ(P{exact}, fpm::simd::dot<P>(x, y));
+    EXPECT_EQ(P{1.5 - 2.25 + 3 + 0.125 - 7 + 100 - 0.5 + 2 + 9.75}, fpm::simd::sum<P>(x));
+    EXPECT_EQ(P{0}, fpm::simd::dot<P>({}, {}));
+
+    // Products below the resolution are not lost
+    const std::vector<P> tiny(1000, P::from_raw_value(100));
+    EXPECT_EQ(P::from_raw_value(153), fpm::simd::dot<P>(tiny, tiny));
+}
+
+TEST(simd, fixed_16_16)
+{
+    ExpectMatchesScalar<fpm::fixed_16_16>();
+    ExpectMatchesScalar<fpm::fixed<std::int32_t, std::int64_t, 16, false>>();
+}
+
+TEST(simd, fixed_24_8)
+{
+    ExpectMatchesScalar<fpm::fixed_24_8>();
+    ExpectMatchesScalar<fpm::fixed<std::int32_t, std::int64_t, 8, false>>();
+}
+
+TEST(simd, fixed_8_24)
+{
+    ExpectMatchesScalar<fpm::fixed_8_24>();
+    ExpectMatchesScalar<fpm::fixed<std::int32_t, std::int64_t, 24, false>>();
+}
+
+TEST(simd, fixed_1_31)
+{
+    ExpectMatchesScalar<fpm::fixed<std::int32_t, std::int64_t, 31>>();
+    ExpectMatchesScalar<fpm::fixed<std::int32_t, std::int64_t, 31, false>>();
+}
+
+TEST(simd, fixed_8_8)
+{
+    ExpectMatchesScalar<fpm::fixed_8_8>();
+}
+
+TEST(simd, span_api)
+{
+    using P = fpm::fixed_16_16;
+    const std::vector<P> x{ P{1.5}, P{-2.25}, P{3}, P{0.125}, P{-7}, P{100}, P{-0.5}, P{2}, P{9.75} };
+    const std::vector<P> y{ P{2}, P{4}, P{-0.5}, P{8}, P{-1}, P{0.01}, P{3}, P{-6}, P{0.5} };
+    const std::vector<P> z(x.size(), P{1});
+    std::vector<P> out(x.size());
+
+    fpm::simd::mul<P>(x, y, out);
+    for (std::size_t i = 0; i < x.size(); ++i) EXPECT_EQ(x[i] * y[i], out[i]);
+
+    fpm::simd::fma<P>(x, y, z, out);
+    for (std::size_t i = 0; i < x.size(); ++i) EXPECT_EQ(x[i] * y[i] + z[i], out[i]);
+
+    fpm::simd::scale<P>(x, P{0.75}, out);
+    for (std::size_t i = 0; i < x.size(); ++i) EXPECT_EQ(x[i] * P{0.75}, out[i]);
+
+    fpm::simd::div<P>(x, y, out);
+    for (std::size_t i = 0; i < x.size(); ++i) EXPECT_EQ(x[i] / y[i], out[i]);
+
+    // In-place operation
+    std::vector<P> inout = x;
+    fpm::simd::add<P>(inout, y, inout);
+    for (std::size_t i = 0; i < x.size(); ++i) EXPECT_EQ(x[i] + y[i], inout[i]);
+
+    inout = x;
+    fpm::simd::sub<P>(inout, y, inout);
+    for (std::size_t i = 0; i < x.size(); ++i) EXPECT_EQ(x[i] - y[i], inout[i]);
+}
+
+namespace
+{
+
+// Compares an array math function against its scalar counterpart, for every supported instruction
+// set, on random arguments in [lo, hi] plus the bounds themselves.
+template <template <typename> class Lanes, typename T>
+void ExpectMathMatchesScalar(T lo, T hi)
+{
+    using B = typename T::base_type;
+    std::mt19937 gen(54321);
+    std::uniform_int_distribution<B> dist(lo.raw_value(), hi.raw_value());
+
+    // Several blocks and a remainder
+    std::vector<T> x(64 * 3 + 17);
+    for (auto& v : x)
+    {
+        v = T::from_raw_value(dist(gen));
+    }
+    x[0] = lo;
+    x[1] = hi;
+
+    const fpm::simd::isa isas[] = { fpm::simd::isa::scalar, fpm::simd::isa::sse4_1, fpm::simd::isa::avx2, fpm::simd::isa::avx512 };
+    for (const auto target : isas)
+    {
+        if (target > fpm::simd::active_isa())
+        {
+            continue;
+        }
+        SCOPED_TRACE(static_cast<int>(target));
+
+        std::vector<T> out(x.size()), out2(x.size());
+        fpm::simd::detail::apply_math<Lanes>(target, x.data(), out.data(), x.size(), out2.data());
+        for (std::size_t i = 0; i < x.size(); ++i)
+        {
+            if constexpr (fpm::simd::detail::two_outputs_v<Lanes<T>>)
+            {
+                EXPECT_EQ(Lanes<T>::scalar(x[i]), std::make_pair(out[i], out2[i])) << static_cast<double>(x[i]);
+            }
+            else
+            {
+                EXPECT_EQ(Lanes<T>::scalar(x[i]), out[i]) << static_cast<double>(x[i]);
+            }
+        }
+    }
+}
+
+template <typename T>
+void ExpectAllMathMatchesScalar(T exp_limit)
+{
+    using fpm::simd::detail::sin_lanes;
+    using fpm::simd::detail::cos_lanes;
+    using fpm::simd::detail::sincos_lanes;
+    using fpm::simd::detail::exp_lanes;
+    using fpm::simd::detail::log_lanes;
+    using fpm::simd::detail::log2_lanes;
+    using fpm::simd::detail::sqrt_lanes;
+
+    const auto min = std::numeric_limits<T>::min();
+    const auto max = std::numeric_limits<T>::max();
+    const auto smallest = std::numeric_limits<T>::epsilon();
+
+    ExpectMathMatchesScalar<sin_lanes>(min, max);
+    ExpectMathMatchesScalar<sin_lanes>(-T::two_pi(), T::two_pi());
+    ExpectMathMatchesScalar<cos_lanes>(min, max);
+    ExpectMathMatchesScalar<cos_lanes>(-T::two_pi(), T::two_pi());
+    ExpectMathMatchesScalar<sincos_lanes>(min, max);
+    ExpectMathMatchesScalar<sincos_lanes>(-T::two_pi(), T::two_pi());
+    ExpectMathMatchesScalar<exp_lanes>(-exp_limit, exp_limit);
+    ExpectMathMatchesScalar<exp_lanes>(T{-1}, T{1});
+    ExpectMathMatchesScalar<log2_lanes>(smallest, max);
+    ExpectMathMatchesScalar<log_lanes>(smallest, max);
+    ExpectMathMatchesScalar<log_lanes>(T{0.5}, T{2});
+    ExpectMathMatchesScalar<sqrt_lanes>(T{0}, max);
+    ExpectMathMatchesScalar<sqrt_lanes>(T{0}, T{1});
+}
+
+}
+
+TEST(simd, math_fixed_16_16)
+{
+    // exp(10) is the largest power that fits in the integral bits
+    ExpectAllMathMatchesScalar<fpm::fixed_16_16>(fpm::fixed_16_16{10});
+    ExpectAllMathMatchesScalar<fpm::fixed<std::int32_t, std::int64_t, 16, false>>(fpm::fixed<std::int32_t, std::int64_t, 16, false>{10});
+}
+
+TEST(simd, math_fixed_24_8)
+{
+    ExpectAllMathMatchesScalar<fpm::fixed_24_8>(fpm::fixed_24_8{15});
+    ExpectAllMathMatchesScalar<fpm::fixed<std::int32_t, std::int64_t, 8, false>>(fpm::fixed<std::int32_t, std::int64_t, 8, false>{15});
+}
+
+TEST(simd, math_fixed_8_24)
+{
+    ExpectAllMathMatchesScalar<fpm::fixed_8_24>(fpm::fixed_8_24{4.8});
+    ExpectAllMathMatchesScalar<fpm::fixed<std::int32_t, std::int64_t, 24, false>>(fpm::fixed<std::int32_t, std::int64_t, 24, false>{4.8});
+}
+
+TEST(simd, math_sin_fraction_bits)
+{
+    // The largest fraction bit counts whose range reduction is vectorized
+    using Q5_27 = fpm::fixed<std::int32_t, std::int64_t, 27>;
+    using Q4_28 = fpm::fixed<std::int32_t, std::int64_t, 28, false>;
+    static_assert(fpm::simd::detail::sin_lanes<Q5_27>::enabled && fpm::simd::detail::sin_lanes<Q4_28>::enabled);
+
+    using fpm::simd::detail::sin_lanes;
+    using fpm::simd::detail::cos_lanes;
+    using fpm::simd::detail::sincos_lanes;
+    ExpectMathMatchesScalar<sin_lanes>(std::numeric_limits<Q5_27>::min(), std::numeric_limits<Q5_27>::max());
+    ExpectMathMatchesScalar<cos_lanes>(std::numeric_limits<Q5_27>::min(), std::numeric_limits<Q5_27>::max());
+    ExpectMathMatchesScalar<sincos_lanes>(-Q5_27::two_pi(), Q5_27::two_pi());
+    ExpectMathMatchesScalar<sin_lanes>(std::numeric_limits<Q4_28>::min(), std::numeric_limits<Q4_28>::max());
+    ExpectMathMatchesScalar<cos_lanes>(std::numeric_limits<Q4_28>::min(), std::numeric_limits<Q4_28>::max());
+    ExpectMathMatchesScalar<sincos_lanes>(-Q4_28::two_pi(), Q4_28::two_pi());
+}
+
+TEST(simd, math_fixed_8_8)
+{
+    // Not vectorized, but must give the same results
+    ExpectAllMathMatchesScalar<fpm::fixed_8_8>(fpm::fixed_8_8{4.8});
+}
+
+TEST(simd, math_span_api)
+{
+    using P = fpm::fixed_16_16;
+    std::vector<P> x(100);
+    for (std::size_t i = 0; i < x.size(); ++i)
+    {
+        x[i] = P{0.0625} * static_cast<int>(i + 1);
+    }
+    std::vector<P> out(x.size());
+
+    fpm::simd::sin<P>(x, out);
+    for (std::size_t i = 0; i < x.size(); ++i) EXPECT_EQ(fpm::sin(x[i]), out[i]);
+
+    fpm::simd::cos<P>(x, out);
+    for (std::size_t i = 0; i < x.size(); ++i) EXPECT_EQ(fpm::cos(x[i]), out[i]);
+
+    std::vector<P> out2(x.size());
+    fpm::simd::sincos<P>(x, out, out2);
+    for (std::size_t i = 0; i < x.size(); ++i) EXPECT_EQ(fpm::sincos(x[i]), std::make_pair(out[i], out2[i]));
+
+    fpm::simd::exp<P>(x, out);
+    for (std::size_t i = 0; i < x.size(); ++i) EXPECT_EQ(fpm::exp(x[i]), out[i]);
+
+    fpm::simd::log<P>(x, out);
+    for (std::size_t i = 0; i < x.size(); ++i) EXPECT_EQ(fpm::log(x[i]), out[i]);
+
+    fpm::simd::log2<P>(x, out);
+    for (std::size_t i = 0; i < x.size(); ++i) EXPECT_EQ(fpm::log2(x[i]), out[i]);
+
+    // In-place operation
+    std::vector<P> inout = x;
+    fpm::simd::sqrt<P>(inout, inout);
+    for (std::size_t i = 0; i < x.size(); ++i) EXPECT_EQ(fpm::sqrt(x[i]), inout[i]);
+}
+
+namespace
+{
+
+// Compares the bulk hypot with two and three components against the scalar functions, for every
+// supported instruction set. Results that don't fit the type wrap around in both.
+template <typename T>
+void ExpectHypotMatchesScalar()
+{
+    std::mt19937 gen(2468);
+    const auto x = random_values<T>(gen);
+    const auto y = random_values<T>(gen);
+    const auto z = random_values<T>(gen);
+
+    const fpm::simd::isa isas[] = { fpm::simd::isa::scalar, fpm::simd::isa::sse4_1, fpm::simd::isa::avx2, fpm::simd::isa::avx512 };
+    for (const auto target : isas)
+    {
+        if (target > fpm::simd::active_isa())
+        {
+            continue;
+        }
+        SCOPED_TRACE(static_cast<int>(target));
+
+        std::vector<T> out(x.size());
+        fpm::simd::detail::apply_hypot(target, x.data(), y.data(), static_cast<const T*>(nullptr), out.data(), out.size());
+        for (std::size_t i = 0; i < x.size(); ++i) EXPECT_EQ(fpm::hypot(x[i], y[i]), out[i]) << i;
+
+        fpm::simd::detail::apply_hypot(target, x.data(), y.data(), z.data(), out.data(), out.size());
+        for (std::size_t i = 0; i < x.size(); ++i) EXPECT_EQ(fpm::hypot(x[i], y[i], z[i]), out[i]) << i;
+    }
+}
+
+}
+
+TEST(simd, hypot)
+{
+    ExpectHypotMatchesScalar<fpm::fixed_16_16>();
+    ExpectHypotMatchesScalar<fpm::fixed_24_8>();
+    ExpectHypotMatchesScalar<fpm::fixed_8_24>();
+    ExpectHypotMatchesScalar<fpm::fixed<std::int32_t, std::int64_t, 16, fpm::rounding::floor>>();
+    ExpectHypotMatchesScalar<fpm::fixed_8_8>();
+
+    using P = fpm::fixed_16_16;
+    const std::vector<P> x{ P{3}, P{-300}, P{0}, P{1000} };
+    const std::vector<P> y{ P{4}, P{400}, P{0}, P{-2000} };
+    const std::vector<P> z{ P{12}, P{0}, P{0}, P{2000} };
+    std::vector<P> out(x.size());
+    fpm::simd::hypot<P>(x, y, out);
+    EXPECT_EQ((std::vector<P>{ P{5}, P{500}, P{0}, fpm::hypot(P{1000}, P{-2000}) }), out);
+    fpm::simd::hypot<P>(x, y, z, out);
+    EXPECT_EQ((std::vector<P>{ P{13}, P{500}, P{0}, P{3000} }), out);
+}
@@ -187,3 +187,130 @@ TEST(trigonometry, atan2_near_zero)
         EXPECT_TRUE(HasMaximumError(atan2_fixed, atan2_real, MAX_ERROR_PERC));
     }
 }
+
+template <std::size_t Size, unsigned int Order, typename P>
+static void ExpectLutAccuracy(double max_error)
+{
+    const double PI = std::acos(-1);
+    for (int angle = -3599; angle <= 3600; ++angle)
+    {
+        const P x(angle * PI / 360);
+        const auto real = static_cast<double>(x);
+        EXPECT_NEAR(static_cast<double>(fpm::lut::sin<Size, Order>(x)), std::sin(real), max_error) << "sin(" << real << ")";
+        EXPECT_NEAR(static_cast<double>(fpm::lut::cos<Size, Order>(x)), std::cos(real), max_error) << "cos(" << real << ")";
+    }
+}
+
+TEST(trigonometry, lut_sin_cos)
+{
+    // Interpolation error plus rounding of the result
+    ExpectLutAccuracy<256, 1, fpm::fixed_16_16>(4.8e-6 + 7.7e-6);
+    ExpectLutAccuracy<64, 3, fpm::fixed_16_16>(1e-8 + 7.7e-6);
+    ExpectLutAccuracy<1024, 0, fpm::fixed_16_16>(7.7e-4 + 7.7e-6);
+    ExpectLutAccuracy<256, 1, fpm::fixed_8_24>(4.8e-6 + 3e-8);
+    ExpectLutAccuracy<256, 3, fpm::fixed_8_24>(1e-8 + 3e-8);
+    ExpectLutAccuracy<256, 3, fpm::fixed_32_32>(5e-9);
+    ExpectLutAccuracy<256, 1, fpm::fixed_8_8>(4.8e-6 + 2e-3);
+}
+
+TEST(trigonometry, lut_sin_cos_exact)
+{
+    using P = fpm::fixed_16_16;
+    static_assert(fpm::lut::cos(P(0)) == P(1), "the tables are usable in constant expressions");
+
+    EXPECT_EQ(P(0), fpm::lut::sin(P(0)));
+    EXPECT_EQ(P(1), fpm::lut::cos(P(0)));
+    EXPECT_EQ(P(1), fpm::lut::sin(P::half_pi()));
+    EXPECT_EQ(P(-1), fpm::lut::sin(-P::half_pi()));
+    EXPECT_EQ(P(0), fpm::lut::cos(P::half_pi()));
+
+    // Large arguments are reduced without overflowing
+    for (auto raw_value : { INT32_MIN, INT32_MAX, 2147380704 })
+    {
+        const P x = P::from_raw_value(raw_value);
+        EXPECT_NEAR(static_cast<double>(fpm::lut::sin(x)), std::sin(static_cast<double>(x)), 1e-4);
+        EXPECT_NEAR(static_cast<double>(fpm::lut::cos(x)), std::cos(static_cast<double>(x)), 1e-4);
+    }
+}
+
+// Checks sin, cos and atan of fpm::fast and fpm::precise against the error of their polynomials, plus the
+// rounding of the result
+template <typename P>
+static void ExpectTierAccuracy(int fast_bits, int precise_bits)
+{
+    const double PI = std::acos(-1);
+    const double resolution = std::ldexp(1.0, -static_cast<int>(P::fraction_bits));
+    const double fast_error = std::ldexp(1.0, -fast_bits) + resolution / 2;
+    const double precise_error = std::ldexp(1.0, -precise_bits - 1) + resolution / 2;
+    for (int angle = -3599; angle <= 3600; ++angle)
+    {
+        const P x(angle * PI / 360);
+        const auto real = static_cast<double>(x);
+        EXPECT_NEAR(static_cast<double>(fpm::fast::sin(x)), std::sin(real), fast_error) << "sin(" << real << ")";
+        EXPECT_NEAR(static_cast<double>(fpm::fast::cos(x)), std::cos(real), fast_error) << "cos(" << real << ")";
+        EXPECT_NEAR(static_cast<double>(fpm::precise::sin(x)), std::sin(real), precise_error) << "sin(" << real << ")";
+        EXPECT_NEAR(static_cast<double>(fpm::precise::cos(x)), std::cos(real), precise_error) << "cos(" << real << ")";
+
+        const P y(angle / 64.0);
+        const auto y_real = static_cast<double>(y);
+        EXPECT_NEAR(static_cast<double>(fpm::fast::atan(y)), std::atan(y_real), fast_error) << "atan(" << y_real << ")";
+        EXPECT_NEAR(static_cast<double>(fpm::precise::atan(y)), std::atan(y_real), precise_error) << "atan(" << y_real << ")";
+    }
+}
+
+TEST(trigonometry, tiers)
+{
+    ExpectTierAccuracy<fpm::fixed_16_16>(12, 16);
+    ExpectTierAccuracy<fpm::fixed_8_24>(12, 24);
+#if defined(FPM_INT128)
+    ExpectTierAccuracy<fpm::fixed_32_32>(12, 32);
+    ExpectTierAccuracy<fpm::fixed<std::int64_t, fpm::int128_t, 48>>(12, 40);
+#endif
+
+    using P = fpm::fixed_16_16;
+    static_assert(fpm::precise::cos(P(0)) == P(1));
+    EXPECT_EQ(P(0), fpm::fast::sin(P(0)));
+    EXPECT_EQ(P(1), fpm::precise::sin(P::half_pi()));
+    EXPECT_EQ(P(-1), fpm::fast::sin(-P::half_pi()));
+    EXPECT_EQ(P(0), fpm::precise::atan(P(0)));
+    EXPECT_EQ(P::half_pi() / 2, fpm::precise::atan(P(1)));
+
+    // Large arguments are reduced without overflowing
+    for (auto raw_value : { INT32_MIN, INT32_MAX, 2147380704 })
+    {
+        const P x = P::from_raw_value(raw_value);
+        EXPECT_NEAR(static_cast<double>(fpm::precise::sin(x)), std::sin(static_cast<double>(x)), 2e-5);
+        EXPECT_NEAR(static_cast<double>(fpm::precise::cos(x)), std::cos(static_cast<double>(x)), 2e-5);
+        EXPECT_NEAR(static_cast<double>(fpm::precise::atan(x)), std::atan(static_cast<double>(x)), 1e-5);
+    }
+}
+
+TEST(trigonometry, sincos)
+{
+    using P = fpm::fixed<std::int32_t, std::int64_t, 16>;
+    const double PI = std::acos(-1);
+
+    constexpr auto MAX_ERROR_PERC = 0.002;
+
+    for (int angle = -1799; angle <= 1800; ++angle)
+    {
+        const P x(angle * PI / 180);
+        const auto [s, c] = fpm::sincos(x);
+        EXPECT_EQ(sin(x), s);
+        EXPECT_TRUE(HasMaximumError(static_cast<double>(c), std::cos(angle * PI / 180), MAX_ERROR_PERC));
+
+        EXPECT_EQ(std::make_pair(fpm::lut::sin(x), fpm::lut::cos(x)), fpm::lut::sincos(x));
+        EXPECT_EQ(std::make_pair(fpm::fast::sin(x), fpm::fast::cos(x)), fpm::fast::sincos(x));
+        EXPECT_EQ(std::make_pair(fpm::precise::sin(x), fpm::precise::cos(x)), fpm::precise::sincos(x));
+    }
+
+    // Boundary-value analysis: the cosine can't overflow
+    for (auto raw_value : { INT32_MIN, INT32_MAX, 2147380704 })
+    {
+        constexpr auto MAX_ERROR_PERC = 0.0492;  // 4.92% = Maximum relative deviation over the value range of f_16_16
+        const P x = P::from_raw_value(raw_value);
+        const auto [s, c] = fpm::sincos(x);
+        EXPECT_EQ(sin(x), s);
+        EXPECT_TRUE(HasMaximumError(static_cast<double>(c), std::cos(static_cast<double>(x)), MAX_ERROR_PERC)) << "raw_value=" << raw_value;
+    }
+}